@@ -337,9 +337,13 @@ std::string MD5::hexdigest() const
   if (!finalized)
     return "";
  
+  static const char hex[] = "0123456789abcdef";
+
   char buf[33];
-  for (int i=0; i<16; i++)
-    sprintf(buf+i*2, "%02x", digest[i]);
+  for (int i=0; i<16; i++) {
+    buf[i*2] = hex[digest[i] >> 4];
+    buf[i*2+1] = hex[digest[i] & 0x0f];
+  }
   buf[32]=0;
  
   return std::string(buf);
@@ -0,0 +1,180 @@
+/**
+ * -----------------------------------------------------
+ * File        ISystem2.h
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#ifndef _SYSTEM2_ISYSTEM2_H_
+#define _SYSTEM2_ISYSTEM2_H_
+
+#include <IShareSys.h>
+#include <stddef.h>
+
+#define SMINTERFACE_SYSTEM2_NAME "ISystem2"
+#define SMINTERFACE_SYSTEM2_VERSION 2
+
+/**
+ * Interface for other extensions to run transfers, commands and copies with the threads of System2.
+ *
+ * Get it in SDK_OnAllLoaded with:
+ *   sharesys->AddDependency(myself, "system2.ext", true, true);
+ *   SM_GET_LATE_IFACE(SYSTEM2, system2);
+ *
+ * All jobs have to be started on the game thread. Strings of a job are copied, so they only have to be valid during the call.
+ * Listeners and their data have to stay valid until they were called or cancelled.
+ *
+ * Jobs started with the Ex functions (version 2) belong to an owner, usually myself->GetIdentity(). When the owner
+ * extension unloads, its listeners are cancelled automatically. As worker thread listeners may still be called between
+ * SDK_OnUnload and the removal of the identity, call CancelListeners in SDK_OnUnload before the listeners are destroyed.
+ */
+
+// Thread on which a listener is called
+enum System2Thread {
+    // Listener is called on the game thread in the next game frame
+    SYSTEM2_GAME_THREAD,
+
+    // Listener is called directly on the worker thread of the job, it must not use any SourceMod API
+    SYSTEM2_WORKER_THREAD
+};
+
+enum System2HTTPMethod {
+    SYSTEM2_METHOD_GET,
+    SYSTEM2_METHOD_POST,
+    SYSTEM2_METHOD_PUT,
+    SYSTEM2_METHOD_PATCH,
+    SYSTEM2_METHOD_DELETE,
+    SYSTEM2_METHOD_HEAD
+};
+
+typedef struct {
+    // URL of the request, has to be URL-encoded
+    const char* url;
+    System2HTTPMethod method;
+
+    // Body data to send or nullptr
+    const char* body;
+
+    // Length of the body in bytes, 0 if the body is NUL terminated
+    size_t bodyLength;
+
+    // Headers in the format "Name: Value" or nullptr
+    const char* const* headers;
+    size_t headerCount;
+
+    const char* userAgent;
+    const char* username;
+    const char* password;
+
+    // Path relative to the game directory to write the content to or nullptr
+    const char* outputFile;
+
+    // Timeout in seconds, 0 for none
+    int timeout;
+    bool followRedirects;
+    bool verifySSL;
+} System2HTTPJob_t;
+
+typedef struct {
+    // URL of the request, has to be URL-encoded
+    const char* url;
+
+    const char* username;
+    const char* password;
+
+    // Path relative to the game directory of a file to upload or nullptr to download
+    const char* inputFile;
+
+    // Path relative to the game directory to write the content to or nullptr
+    const char* outputFile;
+
+    // Timeout in seconds, 0 for none
+    int timeout;
+    bool appendToFile;
+    bool createMissingDirs;
+    bool listFilenamesOnly;
+} System2FTPJob_t;
+
+// Response of a HTTP or FTP request, only valid while the listener is called
+class ISystem2Response {
+public:
+    virtual bool IsSuccess() = 0;
+    virtual const char* GetError() = 0;
+    virtual const char* GetLastURL() = 0;
+    virtual int GetStatusCode() = 0;
+    virtual float GetTotalTime() = 0;
+
+    virtual size_t GetContentLength() = 0;
+
+    // Copies at most maxlength bytes of the content beginning at offset into the buffer, without a terminator
+    virtual size_t GetContent(size_t offset, char* buffer, size_t maxlength) = 0;
+
+    // Returns the value of a response header or nullptr if it wasn't received (always for FTP)
+    virtual const char* GetHeader(const char* name) = 0;
+};
+
+class ISystem2RequestListener {
+public:
+    virtual void OnSystem2Response(ISystem2Response* response, void* data) = 0;
+};
+
+class ISystem2ExecuteListener {
+public:
+    virtual void OnSystem2Executed(bool success, int exitStatus, const char* output, size_t outputLength, void* data) = 0;
+};
+
+class ISystem2CopyListener {
+public:
+    virtual void OnSystem2Copied(bool success, const char* from, const char* to, void* data) = 0;
+};
+
+class ISystem2 : public SourceMod::SMInterface {
+public:
+    virtual const char* GetInterfaceName() {
+        return SMINTERFACE_SYSTEM2_NAME;
+    }
+
+    virtual unsigned int GetInterfaceVersion() {
+        return SMINTERFACE_SYSTEM2_VERSION;
+    }
+
+    // Returns false if the job is invalid, otherwise the listener will be called exactly once (unless System2 is unloaded)
+    virtual bool HTTPRequest(const System2HTTPJob_t& job, ISystem2RequestListener* listener, void* data, System2Thread thread) = 0;
+    virtual bool FTPRequest(const System2FTPJob_t& job, ISystem2RequestListener* listener, void* data, System2Thread thread) = 0;
+    virtual bool Execute(const char* command, ISystem2ExecuteListener* listener, void* data, System2Thread thread) = 0;
+    virtual bool Copy(const char* from, const char* to, ISystem2CopyListener* listener, void* data, System2Thread thread) = 0;
+
+    // Same as above, but the listener is cancelled when the extension of the owner identity unloads (version 2)
+    virtual bool HTTPRequestEx(SourceMod::IdentityToken_t* owner, const System2HTTPJob_t& job, ISystem2RequestListener* listener, void* data, System2Thread thread) = 0;
+    virtual bool FTPRequestEx(SourceMod::IdentityToken_t* owner, const System2FTPJob_t& job, ISystem2RequestListener* listener, void* data, System2Thread thread) = 0;
+    virtual bool ExecuteEx(SourceMod::IdentityToken_t* owner, const char* command, ISystem2ExecuteListener* listener, void* data, System2Thread thread) = 0;
+    virtual bool CopyEx(SourceMod::IdentityToken_t* owner, const char* from, const char* to, ISystem2CopyListener* listener, void* data, System2Thread thread) = 0;
+
+    // Cancels all pending jobs of a listener, the jobs still finish but the listener isn't called anymore (version 2).
+    // Has to be called on the game thread, waits until a call of the listener on a worker thread returned.
+    virtual void CancelRequestListener(ISystem2RequestListener* listener) = 0;
+    virtual void CancelExecuteListener(ISystem2ExecuteListener* listener) = 0;
+    virtual void CancelCopyListener(ISystem2CopyListener* listener) = 0;
+
+    // Cancels all pending jobs of an owner (version 2)
+    virtual void CancelListeners(SourceMod::IdentityToken_t* owner) = 0;
+};
+
+#endif
@@ -0,0 +1,370 @@
+/**
+ * -----------------------------------------------------
+ * File        System2Interface.cpp
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "System2Interface.h"
+#include "HTTPRequestThread.h"
+#include "FTPRequestThread.h"
+#include "ExecuteThread.h"
+#include "CopyThread.h"
+#include "HTTPResponseCallback.h"
+#include "FTPResponseCallback.h"
+#include "ExecuteCallback.h"
+#include "CopyCallback.h"
+#include "ListenerOwnerHandler.h"
+
+System2Interface system2Interface;
+
+// Response of a HTTP or FTP request for other extensions
+class System2Response : public ISystem2Response {
+private:
+    ResponseCallback* response;
+    HTTPResponseCallback* httpResponse;
+
+public:
+    System2Response(ResponseCallback* response, HTTPResponseCallback* httpResponse) : response(response), httpResponse(httpResponse) {}
+
+    virtual bool IsSuccess() {
+        return this->response->error.empty();
+    }
+
+    virtual const char* GetError() {
+        return this->response->error.c_str();
+    }
+
+    virtual const char* GetLastURL() {
+        return this->response->lastURL.c_str();
+    }
+
+    virtual int GetStatusCode() {
+        return this->response->statusCode;
+    }
+
+    virtual float GetTotalTime() {
+        return this->response->totalTime;
+    }
+
+    virtual size_t GetContentLength() {
+        return static_cast<size_t>(this->response->contentLength);
+    }
+
+    virtual size_t GetContent(size_t offset, char* buffer, size_t maxlength) {
+        if (!this->response->content) {
+            return 0;
+        }
+
+        return this->response->content->Read(offset, buffer, maxlength);
+    }
+
+    virtual const char* GetHeader(const char* name) {
+        if (!this->httpResponse) {
+            return nullptr;
+        }
+
+        for (auto it = this->httpResponse->headers.begin(); it != this->httpResponse->headers.end(); ++it) {
+            if (HTTPRequestThread::EqualsIgnoreCase(it->first.c_str(), name)) {
+                return it->second.c_str();
+            }
+        }
+
+        return nullptr;
+    }
+};
+
+// Listener of another extension, which can be cancelled while its job is running
+class ExtensionListener : public CallbackListener {
+private:
+    // Recursive, as a listener on the game thread may cancel itself
+    std::recursive_mutex mutex;
+    bool isCancelled;
+
+protected:
+    virtual void Notify(std::shared_ptr<Callback> callback) = 0;
+
+public:
+    const void* listener;
+    IdentityToken_t* owner;
+
+    ExtensionListener(const void* listener, IdentityToken_t* owner) : isCancelled(false), listener(listener), owner(owner) {}
+
+    virtual void OnCallback(std::shared_ptr<Callback> callback) {
+        // Keep the lock while notifying, so the listener isn't called anymore as soon as Cancel returned
+        std::lock_guard<std::recursive_mutex> lock(this->mutex);
+        if (!this->isCancelled) {
+            this->Notify(callback);
+        }
+    }
+
+    void Cancel() {
+        std::lock_guard<std::recursive_mutex> lock(this->mutex);
+        this->isCancelled = true;
+    }
+};
+
+class RequestListener : public ExtensionListener {
+private:
+    ISystem2RequestListener* listener;
+    void* data;
+    bool isHTTP;
+
+protected:
+    virtual void Notify(std::shared_ptr<Callback> callback) {
+        // Only response callbacks use the callback function of a request
+        ResponseCallback* response = static_cast<ResponseCallback*>(callback.get());
+
+        System2Response system2Response(response, this->isHTTP ? static_cast<HTTPResponseCallback*>(response) : nullptr);
+        this->listener->OnSystem2Response(&system2Response, this->data);
+    }
+
+public:
+    RequestListener(ISystem2RequestListener* listener, IdentityToken_t* owner, void* data, bool isHTTP)
+        : ExtensionListener(listener, owner), listener(listener), data(data), isHTTP(isHTTP) {}
+
+    virtual void OnCallback(std::shared_ptr<Callback> callback) {
+        ExtensionListener::OnCallback(callback);
+
+        // No handle owns the request, so it has to be deleted like an aborted one, also if the listener was cancelled
+        static_cast<ResponseCallback*>(callback.get())->Abort();
+    }
+};
+
+class ExecuteListener : public ExtensionListener {
+private:
+    ISystem2ExecuteListener* listener;
+    void* data;
+
+protected:
+    virtual void Notify(std::shared_ptr<Callback> callback) {
+        ExecuteCallback* executeCallback = static_cast<ExecuteCallback*>(callback.get());
+
+        const std::string& output = executeCallback->GetOutput();
+        this->listener->OnSystem2Executed(executeCallback->IsSuccess(), executeCallback->GetExitStatus(), output.c_str(), output.length(), this->data);
+    }
+
+public:
+    ExecuteListener(ISystem2ExecuteListener* listener, IdentityToken_t* owner, void* data) : ExtensionListener(listener, owner), listener(listener), data(data) {}
+};
+
+class CopyListener : public ExtensionListener {
+private:
+    ISystem2CopyListener* listener;
+    void* data;
+
+protected:
+    virtual void Notify(std::shared_ptr<Callback> callback) {
+        CopyCallback* copyCallback = static_cast<CopyCallback*>(callback.get());
+        this->listener->OnSystem2Copied(copyCallback->IsSuccess(), copyCallback->GetFrom().c_str(), copyCallback->GetTo().c_str(), this->data);
+    }
+
+public:
+    CopyListener(ISystem2CopyListener* listener, IdentityToken_t* owner, void* data) : ExtensionListener(listener, owner), listener(listener), data(data) {}
+};
+
+std::shared_ptr<CallbackFunction_t> System2Interface::CreateCallbackFunction(std::shared_ptr<ExtensionListener> listener, IdentityToken_t* owner, System2Thread thread) {
+    // Forget the listeners of finished jobs
+    for (auto it = this->listeners.begin(); it != this->listeners.end();) {
+        if (it->expired()) {
+            it = this->listeners.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    this->listeners.push_back(listener);
+
+    // The handle is freed by SourceMod when the owner unloads, which cancels its listeners
+    if (owner && this->owners.find(owner) == this->owners.end()) {
+        this->owners[owner] = listenerOwnerHandler.CreateHandle(owner);
+    }
+
+    auto callbackFunction = std::make_shared<CallbackFunction_t>();
+    callbackFunction->plugin = nullptr;
+    callbackFunction->function = nullptr;
+    callbackFunction->isValid = true;
+    callbackFunction->listener = listener;
+    callbackFunction->listenOnWorkerThread = thread == SYSTEM2_WORKER_THREAD;
+
+    return callbackFunction;
+}
+
+bool System2Interface::HTTPRequest(const System2HTTPJob_t& job, ISystem2RequestListener* listener, void* data, System2Thread thread) {
+    return this->HTTPRequestEx(nullptr, job, listener, data, thread);
+}
+
+bool System2Interface::HTTPRequestEx(IdentityToken_t* owner, const System2HTTPJob_t& job, ISystem2RequestListener* listener, void* data, System2Thread thread) {
+    if (!job.url || !listener || job.method < SYSTEM2_METHOD_GET || job.method > SYSTEM2_METHOD_HEAD) {
+        return false;
+    }
+
+    auto callbackFunction = this->CreateCallbackFunction(std::make_shared<RequestListener>(listener, owner, data, true), owner, thread);
+    ::HTTPRequest* request = new ::HTTPRequest(job.url, callbackFunction);
+
+    if (job.body) {
+        request->bodyData = job.bodyLength > 0 ? std::string(job.body, job.bodyLength) : std::string(job.body);
+    }
+
+    // Split the headers into name and value
+    for (size_t i = 0; i < job.headerCount; i++) {
+        std::string header = job.headers[i];
+        size_t semi = header.find(':');
+        if (semi == std::string::npos) {
+            continue;
+        }
+
+        size_t valueStart = header.find_first_not_of(" \t", semi + 1);
+        request->headers[header.substr(0, semi)] = valueStart != std::string::npos ? header.substr(valueStart) : "";
+    }
+
+    if (job.userAgent) {
+        request->userAgent = job.userAgent;
+    }
+
+    if (job.username) {
+        request->username = job.username;
+    }
+
+    if (job.password) {
+        request->password = job.password;
+    }
+
+    if (job.outputFile) {
+        request->outputFile = job.outputFile;
+    }
+
+    request->timeout = job.timeout > 0 ? job.timeout : 0;
+    request->followRedirects = job.followRedirects;
+    request->verifySSL = job.verifySSL;
+
+    HTTPRequestThread* requestThread = new HTTPRequestThread(request, static_cast<HTTPRequestMethod>(job.method));
+    requestThread->RunThread();
+
+    return true;
+}
+
+bool System2Interface::FTPRequest(const System2FTPJob_t& job, ISystem2RequestListener* listener, void* data, System2Thread thread) {
+    return this->FTPRequestEx(nullptr, job, listener, data, thread);
+}
+
+bool System2Interface::FTPRequestEx(IdentityToken_t* owner, const System2FTPJob_t& job, ISystem2RequestListener* listener, void* data, System2Thread thread) {
+    if (!job.url || !listener) {
+        return false;
+    }
+
+    auto callbackFunction = this->CreateCallbackFunction(std::make_shared<RequestListener>(listener, owner, data, false), owner, thread);
+    ::FTPRequest* request = new ::FTPRequest(job.url, callbackFunction);
+
+    if (job.username) {
+        request->username = job.username;
+    }
+
+    if (job.password) {
+        request->password = job.password;
+    }
+
+    if (job.inputFile) {
+        request->inputFile = job.inputFile;
+    }
+
+    if (job.outputFile) {
+        request->outputFile = job.outputFile;
+    }
+
+    request->timeout = job.timeout > 0 ? job.timeout : 0;
+    request->appendToFile = job.appendToFile;
+    request->createMissingDirs = job.createMissingDirs;
+    request->listFilenamesOnly = job.listFilenamesOnly;
+
+    FTPRequestThread* requestThread = new FTPRequestThread(request);
+    requestThread->RunThread();
+
+    return true;
+}
+
+bool System2Interface::Execute(const char* command, ISystem2ExecuteListener* listener, void* data, System2Thread thread) {
+    return this->ExecuteEx(nullptr, command, listener, data, thread);
+}
+
+bool System2Interface::ExecuteEx(IdentityToken_t* owner, const char* command, ISystem2ExecuteListener* listener, void* data, System2Thread thread) {
+    if (!command || !listener) {
+        return false;
+    }
+
+    auto callbackFunction = this->CreateCallbackFunction(std::make_shared<ExecuteListener>(listener, owner, data), owner, thread);
+
+    ExecuteThread* executeThread = new ExecuteThread(command, 0, callbackFunction);
+    executeThread->RunThread();
+
+    return true;
+}
+
+bool System2Interface::Copy(const char* from, const char* to, ISystem2CopyListener* listener, void* data, System2Thread thread) {
+    return this->CopyEx(nullptr, from, to, listener, data, thread);
+}
+
+bool System2Interface::CopyEx(IdentityToken_t* owner, const char* from, const char* to, ISystem2CopyListener* listener, void* data, System2Thread thread) {
+    if (!from || !to || !listener) {
+        return false;
+    }
+
+    auto callbackFunction = this->CreateCallbackFunction(std::make_shared<CopyListener>(listener, owner, data), owner, thread);
+
+    CopyThread* copyThread = new CopyThread(from, to, 0, callbackFunction);
+    copyThread->RunThread();
+
+    return true;
+}
+
+void System2Interface::CancelListener(const void* listener) {
+    for (auto it = this->listeners.begin(); it != this->listeners.end(); ++it) {
+        std::shared_ptr<ExtensionListener> extensionListener = it->lock();
+        if (extensionListener && extensionListener->listener == listener) {
+            extensionListener->Cancel();
+        }
+    }
+}
+
+void System2Interface::CancelRequestListener(ISystem2RequestListener* listener) {
+    this->CancelListener(listener);
+}
+
+void System2Interface::CancelExecuteListener(ISystem2ExecuteListener* listener) {
+    this->CancelListener(listener);
+}
+
+void System2Interface::CancelCopyListener(ISystem2CopyListener* listener) {
+    this->CancelListener(listener);
+}
+
+void System2Interface::CancelListeners(IdentityToken_t* owner) {
+    for (auto it = this->listeners.begin(); it != this->listeners.end(); ++it) {
+        std::shared_ptr<ExtensionListener> extensionListener = it->lock();
+        if (extensionListener && extensionListener->owner == owner) {
+            extensionListener->Cancel();
+        }
+    }
+}
+
+void System2Interface::OnOwnerUnloaded(IdentityToken_t* owner) {
+    this->owners.erase(owner);
+    this->CancelListeners(owner);
+}
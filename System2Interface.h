@@ -0,0 +1,65 @@
+/**
+ * -----------------------------------------------------
+ * File        System2Interface.h
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#ifndef _SYSTEM2_INTERFACE_H_
+#define _SYSTEM2_INTERFACE_H_
+
+#include "ISystem2.h"
+#include "extension.h"
+
+#include <map>
+
+class ExtensionListener;
+
+class System2Interface : public ISystem2 {
+private:
+    std::vector<std::weak_ptr<ExtensionListener>> listeners;
+    std::map<IdentityToken_t*, Handle_t> owners;
+
+    std::shared_ptr<CallbackFunction_t> CreateCallbackFunction(std::shared_ptr<ExtensionListener> listener, IdentityToken_t* owner, System2Thread thread);
+    void CancelListener(const void* listener);
+
+public:
+    virtual bool HTTPRequest(const System2HTTPJob_t& job, ISystem2RequestListener* listener, void* data, System2Thread thread);
+    virtual bool FTPRequest(const System2FTPJob_t& job, ISystem2RequestListener* listener, void* data, System2Thread thread);
+    virtual bool Execute(const char* command, ISystem2ExecuteListener* listener, void* data, System2Thread thread);
+    virtual bool Copy(const char* from, const char* to, ISystem2CopyListener* listener, void* data, System2Thread thread);
+
+    virtual bool HTTPRequestEx(IdentityToken_t* owner, const System2HTTPJob_t& job, ISystem2RequestListener* listener, void* data, System2Thread thread);
+    virtual bool FTPRequestEx(IdentityToken_t* owner, const System2FTPJob_t& job, ISystem2RequestListener* listener, void* data, System2Thread thread);
+    virtual bool ExecuteEx(IdentityToken_t* owner, const char* command, ISystem2ExecuteListener* listener, void* data, System2Thread thread);
+    virtual bool CopyEx(IdentityToken_t* owner, const char* from, const char* to, ISystem2CopyListener* listener, void* data, System2Thread thread);
+
+    virtual void CancelRequestListener(ISystem2RequestListener* listener);
+    virtual void CancelExecuteListener(ISystem2ExecuteListener* listener);
+    virtual void CancelCopyListener(ISystem2CopyListener* listener);
+    virtual void CancelListeners(IdentityToken_t* owner);
+
+    // Called when the owner handle is freed, because the owner extension unloaded
+    void OnOwnerUnloaded(IdentityToken_t* owner);
+};
+
+extern System2Interface system2Interface;
+
+#endif
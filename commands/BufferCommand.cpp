@@ -0,0 +1,60 @@
+/**
+ * -----------------------------------------------------
+ * File        BufferCommand.cpp
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "BufferCommand.h"
+#include "ContentBuffer.h"
+#include "Arena.h"
+
+#include <string.h>
+
+const char* BufferCommand::GetName() const {
+    return "buffers";
+}
+
+void BufferCommand::DrawOptions() const {
+    rootconsole->DrawGenericOption("buffers [reset]", "Show or reset the allocations of responses");
+}
+
+void BufferCommand::Execute(const ICommandArgs* args) {
+    const char* action = args->ArgC() > 3 ? args->Arg(3) : "";
+
+    if (strcmp(action, "reset") == 0) {
+        ContentBuffer::ResetStats();
+        Arena::ResetStats();
+        rootconsole->ConsolePrint("[System2] Buffer statistics reset");
+        return;
+    }
+
+    ContentBufferStats_t stats = ContentBuffer::GetStats();
+    rootconsole->ConsolePrint("[System2] Content buffers: %llu, allocations: %llu (%.3f MB), moved to file: %llu",
+                              (unsigned long long) stats.buffers, (unsigned long long) stats.allocations,
+                              stats.allocatedBytes / 1048576.0, (unsigned long long) stats.spilled);
+
+    ArenaStats_t arenaStats = Arena::GetStats();
+    rootconsole->ConsolePrint("[System2] Response arenas: %llu, blocks: %llu (%.3f MB)", (unsigned long long) arenaStats.arenas,
+                              (unsigned long long) arenaStats.blocks, arenaStats.allocatedBytes / 1048576.0);
+}
+
+// Create the buffer command
+BufferCommand bufferCommand;
\ No newline at end of file
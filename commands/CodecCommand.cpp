@@ -0,0 +1,55 @@
+/**
+ * -----------------------------------------------------
+ * File        CodecCommand.cpp
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "CodecCommand.h"
+#include "Codec.h"
+
+#include <string.h>
+
+const char* CodecCommand::GetName() const {
+    return "codec";
+}
+
+void CodecCommand::DrawOptions() const {
+    rootconsole->DrawGenericOption("codec [scalar|ssse3|avx2]", "Show or select the Base64 and hex implementation");
+}
+
+void CodecCommand::Execute(const ICommandArgs* args) {
+    const char* action = args->ArgC() > 3 ? args->Arg(3) : "";
+
+    // Allow to compare the implementations, but never select one the CPU doesn't support
+    if (strcmp(action, "scalar") == 0) {
+        Codec::SetLevel(SIMD_SCALAR);
+    } else if (strcmp(action, "ssse3") == 0) {
+        Codec::SetLevel(SIMD_SSSE3);
+    } else if (strcmp(action, "avx2") == 0) {
+        Codec::SetLevel(SIMD_AVX2);
+    }
+
+    rootconsole->ConsolePrint("[System2] Codec uses %s (supported: %s)", Codec::GetLevelName(Codec::GetLevel()),
+                              Codec::GetLevelName(Codec::GetSupportedLevel()));
+}
+
+// Create the codec command
+CodecCommand codecCommand;
\ No newline at end of file
@@ -0,0 +1,43 @@
+/**
+ * -----------------------------------------------------
+ * File        ConsoleCommand.h
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#ifndef _SYSTEM2_CONSOLE_COMMAND_H_
+#define _SYSTEM2_CONSOLE_COMMAND_H_
+
+#include "extension.h"
+
+/**
+ * A command of the "sm system2" console menu, the arguments start with the name of the command at index 2.
+ */
+class ConsoleCommand {
+public:
+    virtual const char* GetName() const = 0;
+
+    // Draws the usage of the command into the menu
+    virtual void DrawOptions() const = 0;
+
+    virtual void Execute(const ICommandArgs* args) = 0;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,60 @@
+/**
+ * -----------------------------------------------------
+ * File        ConsoleMenu.cpp
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "ConsoleMenu.h"
+
+#include <string.h>
+
+void ConsoleMenu::Initialize() {
+    rootconsole->AddRootConsoleCommand3("system2", "System2 diagnostics", this);
+}
+
+void ConsoleMenu::Shutdown() {
+    rootconsole->RemoveRootConsoleCommand("system2", this);
+    this->commands.clear();
+}
+
+void ConsoleMenu::AddCommand(ConsoleCommand* command) {
+    this->commands.push_back(command);
+}
+
+void ConsoleMenu::OnRootConsoleCommand(const char* cmdname, const ICommandArgs* args) {
+    const char* name = args->ArgC() > 2 ? args->Arg(2) : "";
+
+    for (auto it = this->commands.begin(); it != this->commands.end(); ++it) {
+        if (strcmp(name, (*it)->GetName()) == 0) {
+            (*it)->Execute(args);
+            return;
+        }
+    }
+
+    // Unknown command, so show the menu
+    rootconsole->ConsolePrint("SourceMod System2 Menu:");
+    for (auto it = this->commands.begin(); it != this->commands.end(); ++it) {
+        (*it)->DrawOptions();
+    }
+}
+
+// Create the console menu
+ConsoleMenu consoleMenu;
\ No newline at end of file
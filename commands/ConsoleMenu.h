@@ -0,0 +1,48 @@
+/**
+ * -----------------------------------------------------
+ * File        ConsoleMenu.h
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#ifndef _SYSTEM2_CONSOLE_MENU_H_
+#define _SYSTEM2_CONSOLE_MENU_H_
+
+#include "ConsoleCommand.h"
+
+#include <vector>
+
+class ConsoleMenu : public IRootConsoleCommand {
+private:
+    std::vector<ConsoleCommand*> commands;
+
+public:
+    void Initialize();
+    void Shutdown();
+
+    // Adds a command to the menu, the command has to stay alive until the menu is shut down
+    void AddCommand(ConsoleCommand* command);
+
+    virtual void OnRootConsoleCommand(const char* cmdname, const ICommandArgs* args);
+};
+
+extern ConsoleMenu consoleMenu;
+
+#endif
\ No newline at end of file
@@ -0,0 +1,59 @@
+/**
+ * -----------------------------------------------------
+ * File        HostCommand.cpp
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "HostCommand.h"
+#include "HostLimiter.h"
+
+#include <string.h>
+
+const char* HostCommand::GetName() const {
+    return "hosts";
+}
+
+void HostCommand::DrawOptions() const {
+    rootconsole->DrawGenericOption("hosts [on|off]", "Show the concurrency limits per host or enable and disable them");
+}
+
+void HostCommand::Execute(const ICommandArgs* args) {
+    const char* action = args->ArgC() > 3 ? args->Arg(3) : "";
+
+    if (strcmp(action, "on") == 0) {
+        hostLimiter.SetEnabled(true);
+    } else if (strcmp(action, "off") == 0) {
+        hostLimiter.SetEnabled(false);
+    }
+
+    rootconsole->ConsolePrint("[System2] Host limiter is %s", hostLimiter.IsEnabled() ? "enabled" : "disabled");
+
+    std::vector<HostStats_t> stats = hostLimiter.GetStats();
+    for (auto it = stats.begin(); it != stats.end(); ++it) {
+        rootconsole->ConsolePrint("[System2] %s: limit %.1f, in flight %d, waiting %d, circuit %s, latency %.1f ms", it->host.c_str(),
+                                  it->limit, it->inFlight, it->waiting, HostLimiter::GetCircuitName(it->circuit), it->averageLatency);
+        rootconsole->ConsolePrint("[System2]     succeeded: %llu, failed: %llu (%d in a row), rejected: %llu", (unsigned long long) it->succeeded,
+                                  (unsigned long long) it->failed, it->consecutiveFailures, (unsigned long long) it->rejected);
+    }
+}
+
+// Create the host command
+HostCommand hostCommand;
\ No newline at end of file
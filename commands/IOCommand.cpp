@@ -0,0 +1,59 @@
+/**
+ * -----------------------------------------------------
+ * File        IOCommand.cpp
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "IOCommand.h"
+#include "FileIO.h"
+
+#include <string.h>
+
+const char* IOCommand::GetName() const {
+    return "io";
+}
+
+void IOCommand::DrawOptions() const {
+    rootconsole->DrawGenericOption("io [stdio|pread|uring]", "Show or select the backend for copying, hashing and output files");
+}
+
+void IOCommand::Execute(const ICommandArgs* args) {
+    const char* action = args->ArgC() > 3 ? args->Arg(3) : "";
+
+    // Allow to compare the backends, but never select one the system doesn't support
+    bool selected = true;
+    if (strcmp(action, "stdio") == 0) {
+        selected = FileIO::SetBackend(FILEIO_STDIO);
+    } else if (strcmp(action, "pread") == 0) {
+        selected = FileIO::SetBackend(FILEIO_PREAD);
+    } else if (strcmp(action, "uring") == 0) {
+        selected = FileIO::SetBackend(FILEIO_URING);
+    }
+
+    if (!selected) {
+        rootconsole->ConsolePrint("[System2] I/O backend %s is not supported", action);
+    }
+
+    rootconsole->ConsolePrint("[System2] File I/O uses %s", FileIO::GetBackendName(FileIO::GetBackend()));
+}
+
+// Create the I/O command
+IOCommand ioCommand;
\ No newline at end of file
@@ -0,0 +1,46 @@
+/**
+ * -----------------------------------------------------
+ * File        OutboxCommand.cpp
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "OutboxCommand.h"
+#include "Outbox.h"
+
+const char* OutboxCommand::GetName() const {
+    return "outbox";
+}
+
+void OutboxCommand::DrawOptions() const {
+    rootconsole->DrawGenericOption("outbox", "Show the requests of the outbox");
+}
+
+void OutboxCommand::Execute(const ICommandArgs* args) {
+    OutboxStats_t stats = outbox.GetStats();
+    rootconsole->ConsolePrint("[System2] Outbox is %s, pending: %u (%.3f MB), journal: %.3f MB", stats.running ? "running" : "stopped",
+                              (unsigned int) stats.entries, stats.bytes / 1048576.0, stats.journalSize / 1048576.0);
+    rootconsole->ConsolePrint("[System2] Sent: %llu, dropped: %llu, retries: %llu, last error: %s", (unsigned long long) stats.sent,
+                              (unsigned long long) stats.dropped, (unsigned long long) stats.retries,
+                              stats.lastError.empty() ? "none" : stats.lastError.c_str());
+}
+
+// Create the outbox command
+OutboxCommand outboxCommand;
\ No newline at end of file
@@ -0,0 +1,90 @@
+/**
+ * -----------------------------------------------------
+ * File        ProfileCommand.cpp
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "ProfileCommand.h"
+
+#include <algorithm>
+#include <utility>
+#include <stdlib.h>
+#include <string.h>
+
+const char* ProfileCommand::GetName() const {
+    return "profile";
+}
+
+void ProfileCommand::DrawOptions() const {
+    rootconsole->DrawGenericOption("profile on|off", "Enable or disable timing of natives and callbacks");
+    rootconsole->DrawGenericOption("profile threshold <ms>", "Log calls taking longer than <ms> (0 = disabled)");
+    rootconsole->DrawGenericOption("profile reset", "Reset the collected timings");
+    rootconsole->DrawGenericOption("profile", "Show the collected timings per native and plugin");
+}
+
+void ProfileCommand::Execute(const ICommandArgs* args) {
+    const char* action = args->ArgC() > 3 ? args->Arg(3) : "";
+
+    if (strcmp(action, "on") == 0) {
+        nativeProfiler.SetEnabled(true);
+        rootconsole->ConsolePrint("[System2] Profiling enabled (threshold %.3f ms)", nativeProfiler.GetThreshold());
+    } else if (strcmp(action, "off") == 0) {
+        nativeProfiler.SetEnabled(false);
+        rootconsole->ConsolePrint("[System2] Profiling disabled");
+    } else if (strcmp(action, "threshold") == 0) {
+        if (args->ArgC() > 4) {
+            nativeProfiler.SetThreshold(std::max(0.0, atof(args->Arg(4))));
+        }
+        rootconsole->ConsolePrint("[System2] Profiling threshold is %.3f ms", nativeProfiler.GetThreshold());
+    } else if (strcmp(action, "reset") == 0) {
+        nativeProfiler.Reset();
+        rootconsole->ConsolePrint("[System2] Profiling data reset");
+    } else {
+        rootconsole->ConsolePrint("[System2] Profiling is %s (threshold %.3f ms)", nativeProfiler.IsEnabled() ? "enabled" : "disabled",
+                                  nativeProfiler.GetThreshold());
+        ProfileCommand::PrintStats(nativeProfiler.GetNativeStats(), "Native / Callback");
+        ProfileCommand::PrintStats(nativeProfiler.GetPluginStats(), "Plugin");
+    }
+}
+
+void ProfileCommand::PrintStats(const std::map<std::string, ProfilerStats_t>& stats, const char* title) {
+    // Sort by total time, most expensive first
+    std::vector<std::pair<std::string, ProfilerStats_t>> sorted(stats.begin(), stats.end());
+    std::sort(sorted.begin(), sorted.end(), [](const std::pair<std::string, ProfilerStats_t>& a, const std::pair<std::string, ProfilerStats_t>& b) {
+        return a.second.totalUs > b.second.totalUs;
+    });
+
+    rootconsole->ConsolePrint("%-48s %8s %10s %10s %10s | %7s %7s %7s %7s %7s %7s", title, "calls", "total ms", "avg us",
+                              "max us", "<10us", "<100us", "<1ms", "<10ms", "<100ms", ">100ms");
+
+    for (auto it = sorted.begin(); it != sorted.end(); ++it) {
+        const ProfilerStats_t& stat = it->second;
+        rootconsole->ConsolePrint("%-48s %8llu %10.3f %10.1f %10llu | %7llu %7llu %7llu %7llu %7llu %7llu", it->first.c_str(),
+                                  (unsigned long long) stat.calls, stat.totalUs / 1000.0, (double) stat.totalUs / stat.calls,
+                                  (unsigned long long) stat.maxUs, (unsigned long long) stat.buckets[0],
+                                  (unsigned long long) stat.buckets[1], (unsigned long long) stat.buckets[2],
+                                  (unsigned long long) stat.buckets[3], (unsigned long long) stat.buckets[4],
+                                  (unsigned long long) stat.buckets[5]);
+    }
+}
+
+// Create the profile command
+ProfileCommand profileCommand;
\ No newline at end of file
@@ -27,11 +27,32 @@
 #include "ExecuteCallbackHandler.h"
 #include "RequestHandler.h"
 #include "ResponseCallbackHandler.h"
+#include "EventBatchHandler.h"
+#include "TuningProfileHandler.h"
+#include "PreparedRequestHandler.h"
+#include "BatchChannelHandler.h"
+#include "SequenceChannelHandler.h"
+#include "PackWriterHandler.h"
+#include "PackReaderHandler.h"
+#include "ExecuteOptionsHandler.h"
+#include "ListenerOwnerHandler.h"
+#include "NativeProfiler.h"
+#include "ConsoleMenu.h"
+#include "ProfileCommand.h"
+#include "BufferCommand.h"
+#include "OutboxCommand.h"
+#include "HostCommand.h"
+#include "CodecCommand.h"
+#include "IOCommand.h"
+#include "System2Interface.h"
 #include "LegacyNatives.h"
 #include "LegacyFTPThread.h"
 #include "FTPRequestThread.h"
+#include "Outbox.h"
+#include "ContentBuffer.h"
 
 #include <algorithm>
+#include <chrono>
 #include <fstream>
 
 #if defined _WIN32 || defined _WIN64
@@ -46,15 +67,36 @@ bool System2Extension::SDK_OnLoad(char* error, size_t err_max, bool late) {
     this->frames = 0;
     this->isRunning = true;
 
-    // Add natives and register extension
-    sharesys->AddNatives(myself, system2_natives);
-    sharesys->AddNatives(myself, system2_legacy_natives);
+    // Add natives wrapped by the profiler and register extension
+    sharesys->AddNatives(myself, nativeProfiler.Wrap(system2_natives));
+    sharesys->AddNatives(myself, nativeProfiler.Wrap(system2_legacy_natives));
     sharesys->RegisterLibrary(myself, "system2");
 
+    // Share the interface with other extensions
+    sharesys->AddInterface(myself, &system2Interface);
+
     // Create handles
     executeCallbackHandler.Initialize();
     requestHandler.Initialize();
     responseCallbackHandler.Initialize();
+    eventBatchHandler.Initialize();
+    tuningProfileHandler.Initialize();
+    preparedRequestHandler.Initialize();
+    batchChannelHandler.Initialize();
+    sequenceChannelHandler.Initialize();
+    packWriterHandler.Initialize();
+    packReaderHandler.Initialize();
+    executeOptionsHandler.Initialize();
+    listenerOwnerHandler.Initialize();
+
+    // Add the root console menu and the commands of every subsystem
+    consoleMenu.Initialize();
+    consoleMenu.AddCommand(&profileCommand);
+    consoleMenu.AddCommand(&bufferCommand);
+    consoleMenu.AddCommand(&outboxCommand);
+    consoleMenu.AddCommand(&hostCommand);
+    consoleMenu.AddCommand(&codecCommand);
+    consoleMenu.AddCommand(&ioCommand);
 
     // Add game frame hook
     smutils->AddGameFrameHook(&OnGameFrameHit);
@@ -65,6 +107,16 @@ bool System2Extension::SDK_OnLoad(char* error, size_t err_max, bool late) {
     // Init CURL
     curl_global_init(CURL_GLOBAL_ALL);
 
+    // Large response content is moved to files on disk, the temporary directory of the system is often in memory
+    char spillPath[PLATFORM_MAX_PATH + 1];
+    smutils->BuildPath(Path_SM, spillPath, sizeof(spillPath), "data/system2/temp");
+    ContentBuffer::SetSpillDirectory(spillPath);
+
+    // Start the outbox, which also sends the requests left over from the last run
+    char outboxPath[PLATFORM_MAX_PATH + 1];
+    smutils->BuildPath(Path_SM, outboxPath, sizeof(outboxPath), "data/system2/outbox");
+    outbox.Start(outboxPath);
+
     return true;
 }
 
@@ -103,6 +155,19 @@ void System2Extension::SDK_OnUnload() {
     executeCallbackHandler.Shutdown();
     requestHandler.Shutdown();
     responseCallbackHandler.Shutdown();
+    eventBatchHandler.Shutdown();
+    tuningProfileHandler.Shutdown();
+    preparedRequestHandler.Shutdown();
+    batchChannelHandler.Shutdown();
+    sequenceChannelHandler.Shutdown();
+    packWriterHandler.Shutdown();
+    packReaderHandler.Shutdown();
+    executeOptionsHandler.Shutdown();
+    listenerOwnerHandler.Shutdown();
+
+    // Remove the root console menu and stop profiling
+    consoleMenu.Shutdown();
+    nativeProfiler.Shutdown();
 
     // Remove plugin listener
     plsys->RemovePluginsListener(this);
@@ -131,6 +196,12 @@ void System2Extension::OnPluginUnloaded(IPlugin* plugin) {
 }
 
 void System2Extension::AppendCallback(std::shared_ptr<Callback> callback) {
+    // Listeners of other extensions may want to be called directly on the worker thread
+    if (callback->callbackFunction->listener && callback->callbackFunction->listenOnWorkerThread) {
+        callback->callbackFunction->listener->OnCallback(callback);
+        return;
+    }
+
     // Lock mutex to gain thread safety
     while (!this->threadMutex.try_lock()) {
         sleep_ms(1);
@@ -162,8 +233,9 @@ void System2Extension::UnregisterThread(Thread* thread) {
     std::lock_guard<std::mutex> lock(this->threadMutex, std::adopt_lock);
 
     // Add to the deletable threads and then just remove from the list of running threads
-    this->deletableThreads.push_back(thread);
+    // While unloading, the running threads are deleted by the unload itself
     if (this->isRunning) {
+        this->deletableThreads.push_back(thread);
         this->runningThreads.erase(std::remove(this->runningThreads.begin(), this->runningThreads.end(), thread), this->runningThreads.end());
     }
 }
@@ -225,6 +297,9 @@ void System2Extension::GameFrameHit() {
     // Increase number of frames
     this->frames++;
 
+    // Worker threads may avoid the core the game runs on
+    threadPolicies.UpdateGameCpu();
+
     // Lock the mutex to gain thread safety
     if (!this->threadMutex.try_lock()) {
         // Couldn't lock -> do not wait
@@ -256,15 +331,37 @@ void System2Extension::GameFrameHit() {
 
     // Proccess callback outside mutex lock to avoid infinite loop
     if (callback) {
-        if (callback->callbackFunction->isValid && callback->callbackFunction->function->IsRunnable()) {
+        if (callback->callbackFunction->listener || (callback->callbackFunction->isValid && callback->callbackFunction->function->IsRunnable())) {
+            // A response which comes too late, e.g. after a map change, is only reported as failure
+            if (callback->HasExpired()) {
+                callback->Expire();
+            }
+
             // Fire the callback if the callback function is valid
-            callback->Fire();
+            if (nativeProfiler.IsEnabled()) {
+                std::string plugin = nativeProfiler.GetPluginName(callback->callbackFunction->plugin);
+
+                std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+                this->FireCallback(callback);
+                nativeProfiler.Record(callback->GetName(), plugin, start);
+            } else {
+                this->FireCallback(callback);
+            }
         } else {
             callback->Abort();
         }
     }
 }
 
+void System2Extension::FireCallback(std::shared_ptr<Callback> callback) {
+    if (callback->callbackFunction->listener) {
+        // Callbacks of other extensions are passed to their listener
+        callback->callbackFunction->listener->OnCallback(callback);
+    } else {
+        callback->Fire();
+    }
+}
+
 uint32_t System2Extension::GetFrames() {
     return this->frames;
 }
@@ -69,6 +69,7 @@ public:
     std::string GetCertificateFile();
 
     void GameFrameHit();
+    void FireCallback(std::shared_ptr<Callback> callback);
     uint32_t GetFrames();
 };
 
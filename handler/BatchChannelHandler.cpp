@@ -0,0 +1,63 @@
+/**
+ * -----------------------------------------------------
+ * File        BatchChannelHandler.cpp
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "BatchChannelHandler.h"
+#include "BatchChannel.h"
+
+BatchChannelHandler::BatchChannelHandler() : handleType(0) {};
+
+void BatchChannelHandler::Initialize() {
+    this->handleType = handlesys->CreateType("System2BatchChannel",
+                                             this,
+                                             0,
+                                             nullptr,
+                                             nullptr,
+                                             myself->GetIdentity(),
+                                             nullptr);
+}
+
+void BatchChannelHandler::Shutdown() {
+    handlesys->RemoveType(this->handleType, myself->GetIdentity());
+}
+
+Handle_t BatchChannelHandler::CreateHandle(BatchChannel* channel, IdentityToken_t* owner) {
+    return handlesys->CreateHandle(this->handleType,
+                                   channel,
+                                   owner,
+                                   myself->GetIdentity(),
+                                   nullptr);
+}
+
+HandleError BatchChannelHandler::ReadHandle(Handle_t hndl, IdentityToken_t* owner, BatchChannel** channel) {
+    HandleSecurity sec = { owner, myself->GetIdentity() };
+
+    return handlesys->ReadHandle(hndl, this->handleType, &sec, (void**)channel);
+}
+
+void BatchChannelHandler::OnHandleDestroy(HandleType_t type, void* object) {
+    delete (BatchChannel*)object;
+}
+
+// Create an instance of the handler
+BatchChannelHandler batchChannelHandler;
\ No newline at end of file
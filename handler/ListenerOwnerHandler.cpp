@@ -0,0 +1,57 @@
+/**
+ * -----------------------------------------------------
+ * File        ListenerOwnerHandler.cpp
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "ListenerOwnerHandler.h"
+#include "System2Interface.h"
+
+ListenerOwnerHandler::ListenerOwnerHandler() : handleType(0) {};
+
+void ListenerOwnerHandler::Initialize() {
+    this->handleType = handlesys->CreateType("System2ListenerOwner",
+                                             this,
+                                             0,
+                                             nullptr,
+                                             nullptr,
+                                             myself->GetIdentity(),
+                                             nullptr);
+}
+
+void ListenerOwnerHandler::Shutdown() {
+    handlesys->RemoveType(this->handleType, myself->GetIdentity());
+}
+
+Handle_t ListenerOwnerHandler::CreateHandle(IdentityToken_t* owner) {
+    return handlesys->CreateHandle(this->handleType,
+                                   owner,
+                                   owner,
+                                   myself->GetIdentity(),
+                                   nullptr);
+}
+
+void ListenerOwnerHandler::OnHandleDestroy(HandleType_t type, void* object) {
+    system2Interface.OnOwnerUnloaded((IdentityToken_t*)object);
+}
+
+// Create an instance of the handler
+ListenerOwnerHandler listenerOwnerHandler;
\ No newline at end of file
@@ -0,0 +1,63 @@
+/**
+ * -----------------------------------------------------
+ * File        PackWriterHandler.cpp
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "PackWriterHandler.h"
+#include "PackWriter.h"
+
+PackWriterHandler::PackWriterHandler() : handleType(0) {};
+
+void PackWriterHandler::Initialize() {
+    this->handleType = handlesys->CreateType("System2PackWriter",
+                                             this,
+                                             0,
+                                             nullptr,
+                                             nullptr,
+                                             myself->GetIdentity(),
+                                             nullptr);
+}
+
+void PackWriterHandler::Shutdown() {
+    handlesys->RemoveType(this->handleType, myself->GetIdentity());
+}
+
+Handle_t PackWriterHandler::CreateHandle(PackWriter* writer, IdentityToken_t* owner) {
+    return handlesys->CreateHandle(this->handleType,
+                                   writer,
+                                   owner,
+                                   myself->GetIdentity(),
+                                   nullptr);
+}
+
+HandleError PackWriterHandler::ReadHandle(Handle_t hndl, IdentityToken_t* owner, PackWriter** writer) {
+    HandleSecurity sec = { owner, myself->GetIdentity() };
+
+    return handlesys->ReadHandle(hndl, this->handleType, &sec, (void**)writer);
+}
+
+void PackWriterHandler::OnHandleDestroy(HandleType_t type, void* object) {
+    delete (PackWriter*)object;
+}
+
+// Create an instance of the handler
+PackWriterHandler packWriterHandler;
\ No newline at end of file
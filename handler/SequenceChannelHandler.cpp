@@ -0,0 +1,63 @@
+/**
+ * -----------------------------------------------------
+ * File        SequenceChannelHandler.cpp
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "SequenceChannelHandler.h"
+#include "SequenceChannel.h"
+
+SequenceChannelHandler::SequenceChannelHandler() : handleType(0) {};
+
+void SequenceChannelHandler::Initialize() {
+    this->handleType = handlesys->CreateType("System2SequenceChannel",
+                                             this,
+                                             0,
+                                             nullptr,
+                                             nullptr,
+                                             myself->GetIdentity(),
+                                             nullptr);
+}
+
+void SequenceChannelHandler::Shutdown() {
+    handlesys->RemoveType(this->handleType, myself->GetIdentity());
+}
+
+Handle_t SequenceChannelHandler::CreateHandle(SequenceChannel* channel, IdentityToken_t* owner) {
+    return handlesys->CreateHandle(this->handleType,
+                                   channel,
+                                   owner,
+                                   myself->GetIdentity(),
+                                   nullptr);
+}
+
+HandleError SequenceChannelHandler::ReadHandle(Handle_t hndl, IdentityToken_t* owner, SequenceChannel** channel) {
+    HandleSecurity sec = { owner, myself->GetIdentity() };
+
+    return handlesys->ReadHandle(hndl, this->handleType, &sec, (void**)channel);
+}
+
+void SequenceChannelHandler::OnHandleDestroy(HandleType_t type, void* object) {
+    delete (SequenceChannel*)object;
+}
+
+// Create an instance of the handler
+SequenceChannelHandler sequenceChannelHandler;
\ No newline at end of file
@@ -0,0 +1,63 @@
+/**
+ * -----------------------------------------------------
+ * File        TuningProfileHandler.cpp
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "TuningProfileHandler.h"
+#include "TuningProfile.h"
+
+TuningProfileHandler::TuningProfileHandler() : handleType(0) {};
+
+void TuningProfileHandler::Initialize() {
+    this->handleType = handlesys->CreateType("System2TuningProfile",
+                                             this,
+                                             0,
+                                             nullptr,
+                                             nullptr,
+                                             myself->GetIdentity(),
+                                             nullptr);
+}
+
+void TuningProfileHandler::Shutdown() {
+    handlesys->RemoveType(this->handleType, myself->GetIdentity());
+}
+
+Handle_t TuningProfileHandler::CreateHandle(TuningProfile* profile, IdentityToken_t* owner) {
+    return handlesys->CreateHandle(this->handleType,
+                                   profile,
+                                   owner,
+                                   myself->GetIdentity(),
+                                   nullptr);
+}
+
+HandleError TuningProfileHandler::ReadHandle(Handle_t hndl, IdentityToken_t* owner, TuningProfile** profile) {
+    HandleSecurity sec = { owner, myself->GetIdentity() };
+
+    return handlesys->ReadHandle(hndl, this->handleType, &sec, (void**)profile);
+}
+
+void TuningProfileHandler::OnHandleDestroy(HandleType_t type, void* object) {
+    delete (TuningProfile*)object;
+}
+
+// Create an instance of the handler
+TuningProfileHandler tuningProfileHandler;
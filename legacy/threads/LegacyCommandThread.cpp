@@ -29,6 +29,10 @@
 LegacyCommandThread::LegacyCommandThread(std::string command, int data, std::shared_ptr<CallbackFunction_t> callbackFunction)
     : Thread(), command(command), data(data), callbackFunction(callbackFunction) {}
 
+ThreadCategory LegacyCommandThread::GetCategory() const {
+    return THREAD_EXECUTE;
+}
+
 void LegacyCommandThread::Run() {
     // Redirect everything to output
     std::string redirect = " 2>&1";
@@ -50,6 +50,7 @@ public:
 
 protected:
     void Run();
+    ThreadCategory GetCategory() const;
 };
 
 #endif
\ No newline at end of file
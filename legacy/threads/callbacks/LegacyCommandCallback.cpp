@@ -35,4 +35,8 @@ void LegacyCommandCallback::Fire() {
     this->callbackFunction->function->PushCell(this->data);
     this->callbackFunction->function->PushString(this->command.c_str());
     this->callbackFunction->function->Execute(nullptr);
+}
+
+const char* LegacyCommandCallback::GetName() const {
+    return "LegacyCommandCallback";
 }
\ No newline at end of file
@@ -41,6 +41,8 @@ public:
     LegacyCommandCallback(std::shared_ptr<CallbackFunction_t> callbackFunction, std::string output, std::string command, int data, LegacyCommandState state);
 
     virtual void Fire();
+
+    virtual const char* GetName() const;
 };
 
 #endif
\ No newline at end of file
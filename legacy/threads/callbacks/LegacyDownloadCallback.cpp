@@ -41,4 +41,8 @@ void LegacyDownloadCallback::Fire() {
     this->callbackFunction->function->PushFloat(this->ulNow);
     this->callbackFunction->function->PushCell(this->data);
     this->callbackFunction->function->Execute(nullptr);
+}
+
+const char* LegacyDownloadCallback::GetName() const {
+    return "LegacyDownloadCallback";
 }
\ No newline at end of file
@@ -43,6 +43,8 @@ public:
     LegacyDownloadCallback(std::shared_ptr<CallbackFunction_t> callbackFunction, bool finished, std::string curlError, float dlTotal, float dlNow, float ulTotal, float ulNow, int data);
 
     virtual void Fire();
+
+    virtual const char* GetName() const;
 };
 
 #endif
\ No newline at end of file
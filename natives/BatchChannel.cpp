@@ -0,0 +1,66 @@
+/**
+ * -----------------------------------------------------
+ * File        BatchChannel.cpp
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "BatchChannel.h"
+#include "BatchThread.h"
+
+std::map<std::string, std::shared_ptr<BatchQueue>> BatchChannel::queues;
+
+BatchChannel::BatchChannel(HTTPRequest* httpRequest, BatchFraming framing, bool compress) {
+    this->key = httpRequest->url + "|" + std::to_string(framing) + "|" + (compress ? "1" : "0");
+
+    auto it = BatchChannel::queues.find(this->key);
+    if (it != BatchChannel::queues.end()) {
+        this->queue = it->second;
+    } else {
+        this->queue = std::make_shared<BatchQueue>(framing);
+        BatchChannel::queues[this->key] = this->queue;
+
+        // The thread gets its own copy of the request and deletes itself when the queue is closed
+        BatchThread* batchThread = new BatchThread(httpRequest->Clone(), this->queue, compress);
+        batchThread->RunThread();
+    }
+
+    this->queue->users++;
+}
+
+BatchChannel::~BatchChannel() {
+    // The last channel closes the queue, the pending records are still sent
+    if (--this->queue->users <= 0) {
+        this->queue->Close();
+        BatchChannel::queues.erase(this->key);
+    }
+}
+
+BatchChannel* BatchChannel::ConvertBatchChannel(Handle_t hndl, IPluginContext* pContext) {
+    HandleError err;
+
+    BatchChannel* channel = nullptr;
+    if ((err = batchChannelHandler.ReadHandle(hndl, pContext->GetIdentity(), &channel)) != HandleError_None) {
+        pContext->ThrowNativeError("Invalid batch channel handle %x (error %d)", hndl, err);
+        return nullptr;
+    }
+
+    return channel;
+}
\ No newline at end of file
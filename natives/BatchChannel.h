@@ -0,0 +1,52 @@
+/**
+ * -----------------------------------------------------
+ * File        BatchChannel.h
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#ifndef _SYSTEM2_BATCH_CHANNEL_H_
+#define _SYSTEM2_BATCH_CHANNEL_H_
+
+#include "extension.h"
+#include "HTTPRequest.h"
+#include "BatchQueue.h"
+#include "BatchChannelHandler.h"
+
+#include <map>
+
+class BatchChannel {
+private:
+    // Queues which are currently in use, only accessed on the game thread
+    static std::map<std::string, std::shared_ptr<BatchQueue>> queues;
+
+    std::string key;
+
+public:
+    std::shared_ptr<BatchQueue> queue;
+
+    // Uses the queue of an existing channel with the same URL, framing and compression or starts a new one
+    BatchChannel(HTTPRequest* httpRequest, BatchFraming framing, bool compress);
+    ~BatchChannel();
+
+    static BatchChannel* ConvertBatchChannel(Handle_t hndl, IPluginContext* pContext);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,173 @@
+/**
+ * -----------------------------------------------------
+ * File        BatchChannelNatives.cpp
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "Natives.h"
+#include "BatchChannel.h"
+#include "BatchChannelHandler.h"
+
+cell_t NativeBatchChannel_BatchChannel(IPluginContext* pContext, const cell_t* params) {
+    HTTPRequest* request = Request::ConvertRequest<HTTPRequest>(params[1], pContext);
+    if (!request) {
+        return BAD_HANDLE;
+    }
+
+    if (params[2] < BATCH_NDJSON || params[2] > BATCH_JSON_ARRAY) {
+        pContext->ThrowNativeError("Invalid batch framing %d", params[2]);
+        return BAD_HANDLE;
+    }
+
+    if (request->url.empty()) {
+        pContext->ThrowNativeError("URL of the request is empty");
+        return BAD_HANDLE;
+    }
+
+    if (request->eventCallbackFunction) {
+        pContext->ThrowNativeError("Event stream requests can't be batched");
+        return BAD_HANDLE;
+    }
+
+    BatchChannel* channel = new BatchChannel(request, static_cast<BatchFraming>(params[2]), params[3] != 0);
+
+    Handle_t hndl = batchChannelHandler.CreateHandle(channel, pContext->GetIdentity());
+    if (hndl == BAD_HANDLE) {
+        delete channel;
+        pContext->ThrowNativeError("Couldn't create batch channel handle");
+    }
+
+    return hndl;
+}
+
+cell_t NativeBatchChannel_Add(IPluginContext* pContext, const cell_t* params) {
+    BatchChannel* channel = BatchChannel::ConvertBatchChannel(params[1], pContext);
+    if (!channel) {
+        return 0;
+    }
+
+    char* record;
+    pContext->LocalToString(params[2], &record);
+
+    // The callback is optional
+    std::shared_ptr<CallbackFunction_t> callback;
+    IPluginFunction* function = pContext->GetFunctionById(params[3]);
+    if (function) {
+        callback = system2Extension.CreateCallbackFunction(function);
+        if (!callback) {
+            pContext->ThrowNativeError("Callback ID %x is invalid", params[3]);
+            return 0;
+        }
+    }
+
+    return channel->queue->Add(record, callback, params[4]);
+}
+
+cell_t NativeBatchChannel_Flush(IPluginContext* pContext, const cell_t* params) {
+    BatchChannel* channel = BatchChannel::ConvertBatchChannel(params[1], pContext);
+    if (!channel) {
+        return 0;
+    }
+
+    channel->queue->Flush();
+    return 1;
+}
+
+cell_t NativeBatchChannel_GetMaxRecords(IPluginContext* pContext, const cell_t* params) {
+    BatchChannel* channel = BatchChannel::ConvertBatchChannel(params[1], pContext);
+    if (!channel) {
+        return 0;
+    }
+
+    return channel->queue->GetMaxRecords();
+}
+
+cell_t NativeBatchChannel_SetMaxRecords(IPluginContext* pContext, const cell_t* params) {
+    BatchChannel* channel = BatchChannel::ConvertBatchChannel(params[1], pContext);
+    if (!channel) {
+        return 0;
+    }
+
+    if (params[2] < 1) {
+        pContext->ThrowNativeError("Invalid max records %d", params[2]);
+        return 0;
+    }
+
+    channel->queue->SetMaxRecords(params[2]);
+    return 1;
+}
+
+cell_t NativeBatchChannel_GetMaxBytes(IPluginContext* pContext, const cell_t* params) {
+    BatchChannel* channel = BatchChannel::ConvertBatchChannel(params[1], pContext);
+    if (!channel) {
+        return 0;
+    }
+
+    return channel->queue->GetMaxBytes();
+}
+
+cell_t NativeBatchChannel_SetMaxBytes(IPluginContext* pContext, const cell_t* params) {
+    BatchChannel* channel = BatchChannel::ConvertBatchChannel(params[1], pContext);
+    if (!channel) {
+        return 0;
+    }
+
+    if (params[2] < 1) {
+        pContext->ThrowNativeError("Invalid max bytes %d", params[2]);
+        return 0;
+    }
+
+    channel->queue->SetMaxBytes(params[2]);
+    return 1;
+}
+
+cell_t NativeBatchChannel_GetMaxDelay(IPluginContext* pContext, const cell_t* params) {
+    BatchChannel* channel = BatchChannel::ConvertBatchChannel(params[1], pContext);
+    if (!channel) {
+        return 0;
+    }
+
+    return channel->queue->GetMaxDelay();
+}
+
+cell_t NativeBatchChannel_SetMaxDelay(IPluginContext* pContext, const cell_t* params) {
+    BatchChannel* channel = BatchChannel::ConvertBatchChannel(params[1], pContext);
+    if (!channel) {
+        return 0;
+    }
+
+    if (params[2] < 0) {
+        pContext->ThrowNativeError("Invalid max delay %d", params[2]);
+        return 0;
+    }
+
+    channel->queue->SetMaxDelay(params[2]);
+    return 1;
+}
+
+cell_t NativeBatchChannel_GetPending(IPluginContext* pContext, const cell_t* params) {
+    BatchChannel* channel = BatchChannel::ConvertBatchChannel(params[1], pContext);
+    if (!channel) {
+        return 0;
+    }
+
+    return static_cast<cell_t>(channel->queue->GetPending());
+}
\ No newline at end of file
@@ -0,0 +1,567 @@
+/**
+ * -----------------------------------------------------
+ * File        Codec.cpp
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "Codec.h"
+
+#include <atomic>
+#include <cctype>
+#include <cstdint>
+
+#if defined __i386__ || defined __x86_64__ || defined _M_IX86 || defined _M_X64
+#define CODEC_X86
+
+#include <immintrin.h>
+
+#if defined _MSC_VER
+#include <intrin.h>
+#define CODEC_TARGET(name)
+#else
+#define CODEC_TARGET(name) __attribute__((target(name)))
+#endif
+#endif
+
+static const char base64Chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+static const char hexChars[] = "0123456789abcdef";
+
+// Lookup tables for decoding, -1 marks invalid characters
+static const struct DecodeTables {
+    int8_t base64[256];
+    int8_t hex[256];
+
+    DecodeTables() {
+        for (int i = 0; i < 256; i++) {
+            this->base64[i] = -1;
+            this->hex[i] = -1;
+        }
+
+        for (int i = 0; i < 64; i++) {
+            this->base64[static_cast<uint8_t>(base64Chars[i])] = static_cast<int8_t>(i);
+        }
+
+        for (int i = 0; i < 16; i++) {
+            this->hex[static_cast<uint8_t>(hexChars[i])] = static_cast<int8_t>(i);
+            this->hex[static_cast<uint8_t>(toupper(hexChars[i]))] = static_cast<int8_t>(i);
+        }
+    }
+} decodeTables;
+
+static const SimdLevel supportedLevel = Codec::GetSupportedLevel();
+static std::atomic<int> currentLevel(supportedLevel);
+
+
+static size_t Base64EncodeScalar(const uint8_t* input, size_t length, char* output) {
+    char* start = output;
+
+    size_t i = 0;
+    for (; i + 3 <= length; i += 3) {
+        uint32_t value = (input[i] << 16) | (input[i + 1] << 8) | input[i + 2];
+        *output++ = base64Chars[value >> 18];
+        *output++ = base64Chars[(value >> 12) & 0x3f];
+        *output++ = base64Chars[(value >> 6) & 0x3f];
+        *output++ = base64Chars[value & 0x3f];
+    }
+
+    if (length - i == 1) {
+        uint32_t value = input[i] << 16;
+        *output++ = base64Chars[value >> 18];
+        *output++ = base64Chars[(value >> 12) & 0x3f];
+        *output++ = '=';
+        *output++ = '=';
+    } else if (length - i == 2) {
+        uint32_t value = (input[i] << 16) | (input[i + 1] << 8);
+        *output++ = base64Chars[value >> 18];
+        *output++ = base64Chars[(value >> 12) & 0x3f];
+        *output++ = base64Chars[(value >> 6) & 0x3f];
+        *output++ = '=';
+    }
+
+    return output - start;
+}
+
+static bool Base64DecodeScalar(const uint8_t* input, size_t length, uint8_t* output, size_t& written) {
+    uint8_t* start = output;
+    const int8_t* values = decodeTables.base64;
+
+    size_t i = 0;
+    for (; i + 4 <= length; i += 4) {
+        int32_t a = values[input[i]];
+        int32_t b = values[input[i + 1]];
+        int32_t c = values[input[i + 2]];
+        int32_t d = values[input[i + 3]];
+
+        // Any invalid character makes the or negative
+        if ((a | b | c | d) < 0) {
+            return false;
+        }
+
+        uint32_t value = (a << 18) | (b << 12) | (c << 6) | d;
+        *output++ = static_cast<uint8_t>(value >> 16);
+        *output++ = static_cast<uint8_t>(value >> 8);
+        *output++ = static_cast<uint8_t>(value);
+    }
+
+    // Unpadded rest of two or three characters
+    if (length - i >= 2) {
+        int32_t a = values[input[i]];
+        int32_t b = values[input[i + 1]];
+        int32_t c = length - i == 3 ? values[input[i + 2]] : 0;
+        if ((a | b | c) < 0) {
+            return false;
+        }
+
+        uint32_t value = (a << 18) | (b << 12) | (c << 6);
+        *output++ = static_cast<uint8_t>(value >> 16);
+        if (length - i == 3) {
+            *output++ = static_cast<uint8_t>(value >> 8);
+        }
+    }
+
+    written = output - start;
+    return true;
+}
+
+static size_t HexEncodeScalar(const uint8_t* input, size_t length, char* output) {
+    for (size_t i = 0; i < length; i++) {
+        *output++ = hexChars[input[i] >> 4];
+        *output++ = hexChars[input[i] & 0x0f];
+    }
+
+    return length * 2;
+}
+
+
+#if defined CODEC_X86
+// Base64 with SIMD, see Wojciech Mula and Daniel Lemire, "Faster Base64 Encoding and Decoding using AVX2 Instructions"
+
+CODEC_TARGET("ssse3")
+static __m128i Base64EncodeBlock128(__m128i input) {
+    // Move the 3 byte groups into 4 byte lanes and split them into 6 bit indices
+    input = _mm_shuffle_epi8(input, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+
+    const __m128i t0 = _mm_and_si128(input, _mm_set1_epi32(0x0fc0fc00));
+    const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+    const __m128i t2 = _mm_and_si128(input, _mm_set1_epi32(0x003f03f0));
+    const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+    const __m128i indices = _mm_or_si128(t1, t3);
+
+    // Map the indices to the offset of their character range
+    __m128i offsets = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+    const __m128i less = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+    offsets = _mm_or_si128(offsets, _mm_and_si128(less, _mm_set1_epi8(13)));
+
+    const __m128i shiftLUT = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                           '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+
+    return _mm_add_epi8(_mm_shuffle_epi8(shiftLUT, offsets), indices);
+}
+
+CODEC_TARGET("ssse3")
+static size_t Base64EncodeSSSE3(const uint8_t* input, size_t length, char* output) {
+    size_t done = 0;
+
+    // Reads 16 bytes, but only 12 are encoded
+    while (length - done >= 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + done));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output), Base64EncodeBlock128(block));
+
+        output += 16;
+        done += 12;
+    }
+
+    return done;
+}
+
+CODEC_TARGET("ssse3")
+static bool Base64DecodeBlock128(__m128i input, __m128i& output) {
+    const __m128i higherNibble = _mm_and_si128(_mm_srli_epi32(input, 4), _mm_set1_epi8(0x0f));
+    const __m128i lowerNibble = _mm_and_si128(input, _mm_set1_epi8(0x0f));
+
+    // Every lower nibble has a bit mask of its valid higher nibbles
+    const __m128i maskLUT = _mm_setr_epi8(static_cast<char>(0xa8), static_cast<char>(0xf8), static_cast<char>(0xf8), static_cast<char>(0xf8),
+                                          static_cast<char>(0xf8), static_cast<char>(0xf8), static_cast<char>(0xf8), static_cast<char>(0xf8),
+                                          static_cast<char>(0xf8), static_cast<char>(0xf8), static_cast<char>(0xf0), 0x54, 0x50, 0x50, 0x50, 0x54);
+    const __m128i bitposLUT = _mm_setr_epi8(0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, static_cast<char>(0x80), 0, 0, 0, 0, 0, 0, 0, 0);
+
+    const __m128i mask = _mm_shuffle_epi8(maskLUT, lowerNibble);
+    const __m128i bit = _mm_shuffle_epi8(bitposLUT, higherNibble);
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(mask, bit), _mm_setzero_si128()))) {
+        return false;
+    }
+
+    // The higher nibble decides the offset of a character, only '/' differs from '+'
+    const __m128i shiftLUT = _mm_setr_epi8(0, 0, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i isSlash = _mm_cmpeq_epi8(input, _mm_set1_epi8('/'));
+    const __m128i shift = _mm_or_si128(_mm_andnot_si128(isSlash, _mm_shuffle_epi8(shiftLUT, higherNibble)),
+                                       _mm_and_si128(isSlash, _mm_set1_epi8(16)));
+    const __m128i values = _mm_add_epi8(input, shift);
+
+    // Merge the 6 bit values to 3 bytes per 4 characters
+    const __m128i merged = _mm_madd_epi16(_mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140)), _mm_set1_epi32(0x00011000));
+    output = _mm_shuffle_epi8(merged, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+
+    return true;
+}
+
+CODEC_TARGET("ssse3")
+static bool Base64DecodeSSSE3(const uint8_t* input, size_t length, uint8_t* output, size_t& done) {
+    done = 0;
+
+    // Writes 16 bytes, but only 12 are decoded, so leave enough input for the rest
+    while (length - done >= 24) {
+        __m128i block;
+        if (!Base64DecodeBlock128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input + done)), block)) {
+            return false;
+        }
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output), block);
+        output += 12;
+        done += 16;
+    }
+
+    return true;
+}
+
+CODEC_TARGET("avx2")
+static __m256i Duplicate128(__m128i value) {
+    return _mm256_inserti128_si256(_mm256_castsi128_si256(value), value, 1);
+}
+
+CODEC_TARGET("avx2")
+static size_t Base64EncodeAVX2(const uint8_t* input, size_t length, char* output) {
+    const __m256i shuffle = Duplicate128(_mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+    const __m256i shiftLUT = Duplicate128(_mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                                        '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0));
+    size_t done = 0;
+
+    // Reads 28 bytes, but only 24 are encoded
+    while (length - done >= 28) {
+        __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + done));
+        __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + done + 12));
+        __m256i block = _mm256_shuffle_epi8(_mm256_inserti128_si256(_mm256_castsi128_si256(low), high, 1), shuffle);
+
+        const __m256i t0 = _mm256_and_si256(block, _mm256_set1_epi32(0x0fc0fc00));
+        const __m256i t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+        const __m256i t2 = _mm256_and_si256(block, _mm256_set1_epi32(0x003f03f0));
+        const __m256i t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+        const __m256i indices = _mm256_or_si256(t1, t3);
+
+        __m256i offsets = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+        const __m256i less = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+        offsets = _mm256_or_si256(offsets, _mm256_and_si256(less, _mm256_set1_epi8(13)));
+
+        __m256i result = _mm256_add_epi8(_mm256_shuffle_epi8(shiftLUT, offsets), indices);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output), result);
+
+        output += 32;
+        done += 24;
+    }
+
+    return done;
+}
+
+CODEC_TARGET("avx2")
+static bool Base64DecodeAVX2(const uint8_t* input, size_t length, uint8_t* output, size_t& done) {
+    const __m256i maskLUT = Duplicate128(_mm_setr_epi8(static_cast<char>(0xa8), static_cast<char>(0xf8), static_cast<char>(0xf8), static_cast<char>(0xf8),
+                                                       static_cast<char>(0xf8), static_cast<char>(0xf8), static_cast<char>(0xf8), static_cast<char>(0xf8),
+                                                       static_cast<char>(0xf8), static_cast<char>(0xf8), static_cast<char>(0xf0), 0x54, 0x50, 0x50, 0x50, 0x54));
+    const __m256i bitposLUT = Duplicate128(_mm_setr_epi8(0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, static_cast<char>(0x80), 0, 0, 0, 0, 0, 0, 0, 0));
+    const __m256i shiftLUT = Duplicate128(_mm_setr_epi8(0, 0, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0));
+    const __m256i packShuffle = Duplicate128(_mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+    done = 0;
+
+    // Writes 32 bytes, but only 24 are decoded, so leave enough input for the rest
+    while (length - done >= 48) {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + done));
+        const __m256i higherNibble = _mm256_and_si256(_mm256_srli_epi32(block, 4), _mm256_set1_epi8(0x0f));
+        const __m256i lowerNibble = _mm256_and_si256(block, _mm256_set1_epi8(0x0f));
+
+        const __m256i mask = _mm256_shuffle_epi8(maskLUT, lowerNibble);
+        const __m256i bit = _mm256_shuffle_epi8(bitposLUT, higherNibble);
+        if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_and_si256(mask, bit), _mm256_setzero_si256()))) {
+            return false;
+        }
+
+        const __m256i isSlash = _mm256_cmpeq_epi8(block, _mm256_set1_epi8('/'));
+        const __m256i shift = _mm256_blendv_epi8(_mm256_shuffle_epi8(shiftLUT, higherNibble), _mm256_set1_epi8(16), isSlash);
+        const __m256i values = _mm256_add_epi8(block, shift);
+
+        const __m256i merged = _mm256_madd_epi16(_mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140)), _mm256_set1_epi32(0x00011000));
+        const __m256i packed = _mm256_shuffle_epi8(merged, packShuffle);
+
+        // Move the 12 bytes of both lanes together
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output), _mm256_permutevar8x32_epi32(packed, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7)));
+
+        output += 24;
+        done += 32;
+    }
+
+    return true;
+}
+
+CODEC_TARGET("ssse3")
+static size_t HexEncodeSSSE3(const uint8_t* input, size_t length, char* output) {
+    const __m128i lut = _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+    const __m128i nibble = _mm_set1_epi8(0x0f);
+    size_t done = 0;
+
+    while (length - done >= 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + done));
+        __m128i high = _mm_shuffle_epi8(lut, _mm_and_si128(_mm_srli_epi16(block, 4), nibble));
+        __m128i low = _mm_shuffle_epi8(lut, _mm_and_si128(block, nibble));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output), _mm_unpacklo_epi8(high, low));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + 16), _mm_unpackhi_epi8(high, low));
+
+        output += 32;
+        done += 16;
+    }
+
+    return done;
+}
+
+CODEC_TARGET("avx2")
+static size_t HexEncodeAVX2(const uint8_t* input, size_t length, char* output) {
+    const __m256i lut = Duplicate128(_mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'));
+    const __m256i nibble = _mm256_set1_epi8(0x0f);
+    size_t done = 0;
+
+    while (length - done >= 32) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + done));
+        __m256i high = _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi16(block, 4), nibble));
+        __m256i low = _mm256_shuffle_epi8(lut, _mm256_and_si256(block, nibble));
+
+        // Unpacking works per lane, so the lanes have to be reordered
+        __m256i first = _mm256_unpacklo_epi8(high, low);
+        __m256i second = _mm256_unpackhi_epi8(high, low);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output), _mm256_permute2x128_si256(first, second, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + 32), _mm256_permute2x128_si256(first, second, 0x31));
+
+        output += 64;
+        done += 32;
+    }
+
+    return done;
+}
+#endif
+
+
+size_t Codec::Base64EncodedLength(size_t length) {
+    return (length + 2) / 3 * 4;
+}
+
+size_t Codec::Base64DecodedLength(const char* input, size_t length) {
+    if (length % 4 == 0 && length > 0 && input[length - 1] == '=') {
+        length--;
+        if (input[length - 1] == '=') {
+            length--;
+        }
+    }
+
+    size_t rest = length % 4;
+    return length / 4 * 3 + (rest > 1 ? rest - 1 : 0);
+}
+
+size_t Codec::HexEncodedLength(size_t length) {
+    return length * 2;
+}
+
+size_t Codec::HexDecodedLength(size_t length) {
+    return length / 2;
+}
+
+size_t Codec::Base64Encode(const char* input, size_t length, char* output) {
+    const uint8_t* in = reinterpret_cast<const uint8_t*>(input);
+    size_t done = 0;
+
+#if defined CODEC_X86
+    SimdLevel level = Codec::GetLevel();
+    if (level >= SIMD_AVX2) {
+        done = Base64EncodeAVX2(in, length, output);
+    }
+
+    if (level >= SIMD_SSSE3) {
+        done += Base64EncodeSSSE3(in + done, length - done, output + done / 3 * 4);
+    }
+#endif
+
+    return done / 3 * 4 + Base64EncodeScalar(in + done, length - done, output + done / 3 * 4);
+}
+
+bool Codec::Base64Decode(const char* input, size_t length, char* output, size_t& written) {
+    // Remove the padding
+    if (length % 4 == 0 && length > 0 && input[length - 1] == '=') {
+        length--;
+        if (input[length - 1] == '=') {
+            length--;
+        }
+    }
+
+    if (length % 4 == 1) {
+        return false;
+    }
+
+    const uint8_t* in = reinterpret_cast<const uint8_t*>(input);
+    uint8_t* out = reinterpret_cast<uint8_t*>(output);
+    size_t done = 0;
+
+#if defined CODEC_X86
+    SimdLevel level = Codec::GetLevel();
+    if (level >= SIMD_AVX2 && !Base64DecodeAVX2(in, length, out, done)) {
+        return false;
+    }
+
+    if (level >= SIMD_SSSE3) {
+        size_t blockDone;
+        if (!Base64DecodeSSSE3(in + done, length - done, out + done / 4 * 3, blockDone)) {
+            return false;
+        }
+
+        done += blockDone;
+    }
+#endif
+
+    if (!Base64DecodeScalar(in + done, length - done, out + done / 4 * 3, written)) {
+        return false;
+    }
+
+    written += done / 4 * 3;
+    return true;
+}
+
+size_t Codec::HexEncode(const char* input, size_t length, char* output) {
+    const uint8_t* in = reinterpret_cast<const uint8_t*>(input);
+    size_t done = 0;
+
+#if defined CODEC_X86
+    SimdLevel level = Codec::GetLevel();
+    if (level >= SIMD_AVX2) {
+        done = HexEncodeAVX2(in, length, output);
+    }
+
+    if (level >= SIMD_SSSE3) {
+        done += HexEncodeSSSE3(in + done, length - done, output + done * 2);
+    }
+#endif
+
+    return done * 2 + HexEncodeScalar(in + done, length - done, output + done * 2);
+}
+
+bool Codec::HexDecode(const char* input, size_t length, char* output, size_t& written) {
+    if (length % 2 != 0) {
+        return false;
+    }
+
+    // Decoding is bound by the table lookups, which are already cheap for two characters at once
+    const uint8_t* in = reinterpret_cast<const uint8_t*>(input);
+    for (size_t i = 0; i < length; i += 2) {
+        int32_t high = decodeTables.hex[in[i]];
+        int32_t low = decodeTables.hex[in[i + 1]];
+        if ((high | low) < 0) {
+            return false;
+        }
+
+        output[i / 2] = static_cast<char>((high << 4) | low);
+    }
+
+    written = length / 2;
+    return true;
+}
+
+std::string Codec::Base64Encode(const std::string& input) {
+    std::string output(Codec::Base64EncodedLength(input.size()), '\0');
+    Codec::Base64Encode(input.data(), input.size(), &output[0]);
+
+    return output;
+}
+
+std::string Codec::HexEncode(const std::string& input) {
+    std::string output(Codec::HexEncodedLength(input.size()), '\0');
+    Codec::HexEncode(input.data(), input.size(), &output[0]);
+
+    return output;
+}
+
+SimdLevel Codec::GetSupportedLevel() {
+    static const SimdLevel level = Codec::DetectLevel();
+    return level;
+}
+
+SimdLevel Codec::GetLevel() {
+    return static_cast<SimdLevel>(currentLevel.load(std::memory_order_relaxed));
+}
+
+void Codec::SetLevel(SimdLevel level) {
+    // Never use instructions the CPU doesn't support
+    if (level > supportedLevel) {
+        level = supportedLevel;
+    }
+
+    currentLevel.store(level, std::memory_order_relaxed);
+}
+
+const char* Codec::GetLevelName(SimdLevel level) {
+    switch (level) {
+        case SIMD_AVX2:
+            return "avx2";
+        case SIMD_SSSE3:
+            return "ssse3";
+        default:
+            return "scalar";
+    }
+}
+
+SimdLevel Codec::DetectLevel() {
+#if defined CODEC_X86
+#if defined _MSC_VER
+    int info[4];
+    __cpuid(info, 1);
+    bool ssse3 = (info[2] & (1 << 9)) != 0;
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+
+    __cpuidex(info, 7, 0);
+    bool avx2 = (info[1] & (1 << 5)) != 0;
+
+    // The OS also has to save the AVX registers
+    if (avx2 && avx && osxsave && (_xgetbv(0) & 6) == 6) {
+        return SIMD_AVX2;
+    }
+
+    if (ssse3) {
+        return SIMD_SSSE3;
+    }
+#else
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return SIMD_AVX2;
+    }
+
+    if (__builtin_cpu_supports("ssse3")) {
+        return SIMD_SSSE3;
+    }
+#endif
+#endif
+
+    return SIMD_SCALAR;
+}
\ No newline at end of file
@@ -0,0 +1,66 @@
+/**
+ * -----------------------------------------------------
+ * File        Codec.h
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#ifndef _SYSTEM2_CODEC_H_
+#define _SYSTEM2_CODEC_H_
+
+#include <cstddef>
+#include <string>
+
+enum SimdLevel {
+    SIMD_SCALAR,
+    SIMD_SSSE3,
+    SIMD_AVX2
+};
+
+// Base64 and hex codecs with SSSE3 and AVX2 implementations which are selected at runtime
+class Codec {
+public:
+    static size_t Base64EncodedLength(size_t length);
+    static size_t Base64DecodedLength(const char* input, size_t length);
+    static size_t HexEncodedLength(size_t length);
+    static size_t HexDecodedLength(size_t length);
+
+    // The output has to hold the encoded length, returns the number of written characters
+    static size_t Base64Encode(const char* input, size_t length, char* output);
+    static size_t HexEncode(const char* input, size_t length, char* output);
+
+    // The output has to hold the decoded length, returns false on invalid input
+    static bool Base64Decode(const char* input, size_t length, char* output, size_t& written);
+    static bool HexDecode(const char* input, size_t length, char* output, size_t& written);
+
+    static std::string Base64Encode(const std::string& input);
+    static std::string HexEncode(const std::string& input);
+
+    // Best level supported by the CPU and the currently used one
+    static SimdLevel GetSupportedLevel();
+    static SimdLevel GetLevel();
+    static void SetLevel(SimdLevel level);
+    static const char* GetLevelName(SimdLevel level);
+
+private:
+    static SimdLevel DetectLevel();
+};
+
+#endif
\ No newline at end of file
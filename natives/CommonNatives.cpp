@@ -24,13 +24,15 @@
 
 #include "Natives.h"
 #include "CopyThread.h"
+#include "ThreadPolicy.h"
+#include "ContentBuffer.h"
 #include "OS.h"
+#include "Codec.h"
+#include "FileIO.h"
 
 #include "md5/md5.h"
 #include "crc/crc.h"
 
-#include <fstream>
-
 cell_t NativeCopyFile(IPluginContext* pContext, const cell_t* params) {
     char* from;
     char* to;
@@ -51,6 +53,62 @@ cell_t NativeCopyFile(IPluginContext* pContext, const cell_t* params) {
     return 1;
 }
 
+cell_t NativeSetThreadPolicy(IPluginContext* pContext, const cell_t* params) {
+    if (params[1] < THREAD_NETWORK || params[1] >= THREAD_CATEGORIES) {
+        pContext->ThrowNativeError("Invalid thread category %d", params[1]);
+        return 0;
+    }
+
+    if (params[2] < SCHEDULE_NORMAL || params[2] > SCHEDULE_IDLE) {
+        pContext->ThrowNativeError("Invalid thread schedule %d", params[2]);
+        return 0;
+    }
+
+    if (params[3] < 0 || params[3] > 19) {
+        pContext->ThrowNativeError("Invalid nice level %d", params[3]);
+        return 0;
+    }
+
+    if (params[4] < EXECUTE_IO_DEFAULT || params[4] > EXECUTE_IO_IDLE) {
+        pContext->ThrowNativeError("Invalid IO class %d", params[4]);
+        return 0;
+    }
+
+    if (params[5] < 0 || params[5] > 7) {
+        pContext->ThrowNativeError("Invalid IO level %d", params[5]);
+        return 0;
+    }
+
+    ThreadPolicy_t policy;
+    policy.schedule = static_cast<ThreadSchedule>(params[2]);
+    policy.nice = params[3];
+    policy.ioClass = static_cast<ExecuteIOClass>(params[4]);
+    policy.ioLevel = params[5];
+    policy.affinity = static_cast<unsigned int>(params[6]);
+    policy.avoidGameCore = params[7];
+
+    // Only applies to threads started afterwards
+    threadPolicies.SetPolicy(static_cast<ThreadCategory>(params[1]), policy);
+    return 1;
+}
+
+cell_t NativeSetSpillDirectory(IPluginContext* pContext, const cell_t* params) {
+    char* directory;
+    pContext->LocalToString(params[1], &directory);
+
+    // An empty directory uses the temporary directory of the system
+    if (!strlen(directory)) {
+        ContentBuffer::SetSpillDirectory(std::string());
+        return 1;
+    }
+
+    char path[PLATFORM_MAX_PATH + 1];
+    smutils->BuildPath(Path_SM, path, sizeof(path), "%s", directory);
+    ContentBuffer::SetSpillDirectory(path);
+
+    return 1;
+}
+
 cell_t NativeGetGameDir(IPluginContext* pContext, const cell_t* params) {
     pContext->StringToLocalUTF8(params[1], params[2], smutils->GetGamePath(), nullptr);
     return 1;
@@ -88,7 +146,6 @@ cell_t NativeGetStringMD5(IPluginContext* pContext, const cell_t* params) {
 }
 
 cell_t NativeGetFileMD5(IPluginContext* pContext, const cell_t* params) {
-    char* memblock;
     char* filePath;
     char fullFilePath[PLATFORM_MAX_PATH + 1];
 
@@ -96,33 +153,21 @@ cell_t NativeGetFileMD5(IPluginContext* pContext, const cell_t* params) {
     pContext->LocalToString(params[1], &filePath);
     g_pSM->BuildPath(Path_Game, fullFilePath, sizeof(fullFilePath), filePath);
 
-    // Open the file
-    std::ifstream file(fullFilePath, std::ifstream::in | std::ifstream::binary | std::ifstream::ate);
-    if (file.bad() || !file.is_open()) {
-        pContext->StringToLocalUTF8(params[2], params[3], "", nullptr);
-        return false;
-    }
+    // Calculate the MD5 hash chunk by chunk, so large files are never loaded completely
+    MD5 md5 = MD5();
+    size_t size = 0;
+    bool success = FileIO::ReadChunks(fullFilePath, [&md5, &size](const char* data, size_t length) {
+        md5.update(data, length);
+        size += length;
+    });
 
-    // Get the size of the file and save the content to a var
-    int size = (int)file.tellg();
-    if (size < 1) {
+    if (!success || size < 1) {
         pContext->StringToLocalUTF8(params[2], params[3], "", nullptr);
         return false;
     }
 
-    memblock = new char[size];
-    file.seekg(0, std::ios::beg);
-    file.read(memblock, size);
-    file.close();
-
-    // Calculate the MD5 hash
-    MD5 md5 = MD5();
-    md5.update(memblock, size);
     md5.finalize();
 
-    // Free the memory from reading again
-    delete[] memblock;
-
     // Save the MD5 hash to the plugins buffer
     pContext->StringToLocalUTF8(params[2], params[3], md5.hexdigest().c_str(), nullptr);
 
@@ -148,7 +193,6 @@ cell_t NativeGetStringCRC32(IPluginContext* pContext, const cell_t* params) {
 }
 
 cell_t NativeGetFileCRC32(IPluginContext* pContext, const cell_t* params) {
-    char* memblock;
     char* filePath;
     char fullFilePath[PLATFORM_MAX_PATH + 1];
 
@@ -156,31 +200,24 @@ cell_t NativeGetFileCRC32(IPluginContext* pContext, const cell_t* params) {
     pContext->LocalToString(params[1], &filePath);
     g_pSM->BuildPath(Path_Game, fullFilePath, sizeof(fullFilePath), filePath);
 
-    // Open the file
-    std::ifstream file(fullFilePath, std::ifstream::in | std::ifstream::binary | std::ifstream::ate);
-    if (file.bad() || !file.is_open()) {
-        pContext->StringToLocalUTF8(params[2], params[3], "", nullptr);
-        return false;
-    }
+    // Calculate the CRC32 hash chunk by chunk, so large files are never loaded completely
+    uint32_t crc = 0xFFFFFFFF;
+    size_t size = 0;
+    bool success = FileIO::ReadChunks(fullFilePath, [&crc, &size](const char* data, size_t length) {
+        for (size_t i = 0; i < length; i++) {
+            crc = updateCRC32(static_cast<unsigned char>(data[i]), crc);
+        }
+
+        size += length;
+    });
 
-    // Get the size of the file and save the content to a var
-    int size = (int)file.tellg();
-    if (size < 1) {
+    if (!success || size < 1) {
         pContext->StringToLocalUTF8(params[2], params[3], "", nullptr);
         return false;
     }
 
-    memblock = new char[size];
-    file.seekg(0, std::ios::beg);
-    file.read(memblock, size);
-    file.close();
-
-    // Calculate the CRC32 hash
     char crc32[9];
-    crc32ToHex(crc32buf(memblock, size), crc32, sizeof(crc32));
-
-    // Free the memory from reading again
-    delete[] memblock;
+    crc32ToHex(~crc, crc32, sizeof(crc32));
 
     // Save the CRC32 hash to the plugins buffer
     pContext->StringToLocalUTF8(params[2], params[3], crc32, nullptr);
@@ -234,4 +271,92 @@ cell_t NativeURLDecode(IPluginContext* pContext, const cell_t* params) {
     }
 
     return false;
+}
+
+cell_t NativeBase64Encode(IPluginContext* pContext, const cell_t* params) {
+    char* output;
+    char* input;
+    pContext->LocalToString(params[1], &output);
+    pContext->LocalToString(params[3], &input);
+
+    size_t length = params[4] < 0 ? strlen(input) : static_cast<size_t>(params[4]);
+
+    // The output also needs space for the NULL terminator
+    size_t encodedLength = Codec::Base64EncodedLength(length);
+    if (params[2] < 1 || encodedLength >= static_cast<size_t>(params[2])) {
+        return -1;
+    }
+
+    Codec::Base64Encode(input, length, output);
+    output[encodedLength] = '\0';
+
+    return encodedLength;
+}
+
+cell_t NativeBase64Decode(IPluginContext* pContext, const cell_t* params) {
+    char* output;
+    char* input;
+    pContext->LocalToString(params[1], &output);
+    pContext->LocalToString(params[3], &input);
+
+    size_t length = params[4] < 0 ? strlen(input) : static_cast<size_t>(params[4]);
+    if (params[2] < 0 || Codec::Base64DecodedLength(input, length) > static_cast<size_t>(params[2])) {
+        return -1;
+    }
+
+    size_t written;
+    if (!Codec::Base64Decode(input, length, output, written)) {
+        return -1;
+    }
+
+    // Terminate the data if there is space left, so it can also be used as string
+    if (written < static_cast<size_t>(params[2])) {
+        output[written] = '\0';
+    }
+
+    return written;
+}
+
+cell_t NativeHexEncode(IPluginContext* pContext, const cell_t* params) {
+    char* output;
+    char* input;
+    pContext->LocalToString(params[1], &output);
+    pContext->LocalToString(params[3], &input);
+
+    size_t length = params[4] < 0 ? strlen(input) : static_cast<size_t>(params[4]);
+
+    // The output also needs space for the NULL terminator
+    size_t encodedLength = Codec::HexEncodedLength(length);
+    if (params[2] < 1 || encodedLength >= static_cast<size_t>(params[2])) {
+        return -1;
+    }
+
+    Codec::HexEncode(input, length, output);
+    output[encodedLength] = '\0';
+
+    return encodedLength;
+}
+
+cell_t NativeHexDecode(IPluginContext* pContext, const cell_t* params) {
+    char* output;
+    char* input;
+    pContext->LocalToString(params[1], &output);
+    pContext->LocalToString(params[3], &input);
+
+    size_t length = params[4] < 0 ? strlen(input) : static_cast<size_t>(params[4]);
+    if (params[2] < 0 || Codec::HexDecodedLength(length) > static_cast<size_t>(params[2])) {
+        return -1;
+    }
+
+    size_t written;
+    if (!Codec::HexDecode(input, length, output, written)) {
+        return -1;
+    }
+
+    // Terminate the data if there is space left, so it can also be used as string
+    if (written < static_cast<size_t>(params[2])) {
+        output[written] = '\0';
+    }
+
+    return written;
 }
\ No newline at end of file
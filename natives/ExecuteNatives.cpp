@@ -26,6 +26,10 @@
 #include "ExecuteCallbackHandler.h"
 #include "ExecuteThread.h"
 #include "ExecuteCallback.h"
+#include "ExecuteOptions.h"
+#include "ExecuteOptionsHandler.h"
+#include "GzipThread.h"
+#include "FastDLThread.h"
 #include "CompressLevel.h"
 #include "CompressArchive.h"
 
@@ -34,6 +38,7 @@
 #define access _access
 #define X_OK 0x4
 #else
+#include <sys/resource.h>
 #include <sys/utsname.h>
 #include <unistd.h>
 #endif
@@ -243,6 +248,107 @@ cell_t NativeExtract(IPluginContext* pContext, const cell_t* params) {
     return 1;
 }
 
+cell_t NativeGzipFile(IPluginContext* pContext, const cell_t* params) {
+    char* file;
+    char* archive;
+
+    pContext->LocalToString(params[2], &file);
+    pContext->LocalToString(params[3], &archive);
+
+    auto callback = system2Extension.CreateCallbackFunction(pContext->GetFunctionById(params[1]));
+    if (!callback) {
+        pContext->ThrowNativeError("Callback ID %x is invalid", params[1]);
+        return 0;
+    }
+
+    // Get the zlib level of the compress level
+    int level;
+    switch (params[4]) {
+        case LEVEL_1:
+        {
+            level = 1;
+            break;
+        }
+        case LEVEL_3:
+        {
+            level = 3;
+            break;
+        }
+        case LEVEL_5:
+        {
+            level = 5;
+            break;
+        }
+        case LEVEL_7:
+        {
+            level = 7;
+            break;
+        }
+        default:
+        {
+            level = 9;
+            break;
+        }
+    }
+
+    // Start the thread that compresses the file
+    GzipThread* gzipThread = new GzipThread(file, archive, level, params[5], params[6], callback);
+    gzipThread->RunThread();
+
+    return 1;
+}
+
+cell_t NativeBuildFastDL(IPluginContext* pContext, const cell_t* params) {
+    char* mirror;
+    char* directories;
+
+    std::string binDir;
+    if (!Get7ZIPExecutable(params[7], binDir)) {
+        return 0;
+    }
+
+    pContext->LocalToString(params[2], &mirror);
+    pContext->LocalToString(params[3], &directories);
+
+    auto callback = system2Extension.CreateCallbackFunction(pContext->GetFunctionById(params[1]));
+    if (!callback) {
+        pContext->ThrowNativeError("Callback ID %x is invalid", params[1]);
+        return 0;
+    }
+
+    // Uploading is optional, the thread gets its own copy of the request
+    FTPRequest* upload = nullptr;
+    if (params[4] != BAD_HANDLE) {
+        FTPRequest* request = Request::ConvertRequest<FTPRequest>(params[4], pContext);
+        if (!request) {
+            return 0;
+        }
+
+        upload = request->Clone();
+    }
+
+    // Start the thread that builds the mirror
+    FastDLThread* fastDLThread = new FastDLThread(mirror, directories, binDir, upload, params[5], params[6], callback);
+    fastDLThread->RunThread();
+
+    return 1;
+}
+
+bool ApplyExecuteOptions(ExecuteThread* thread, IPluginContext* pContext, const cell_t* params, int param) {
+    // Older plugins don't pass the options parameter
+    if (params[0] < param || params[param] == BAD_HANDLE) {
+        return true;
+    }
+
+    ExecuteOptions* options = ExecuteOptions::ConvertExecuteOptions(params[param], pContext);
+    if (!options) {
+        return false;
+    }
+
+    thread->SetOptions(*options);
+    return true;
+}
+
 cell_t NativeExecuteThreaded(IPluginContext* pContext, const cell_t* params) {
     char* command;
     pContext->LocalToString(params[2], &command);
@@ -255,6 +361,11 @@ cell_t NativeExecuteThreaded(IPluginContext* pContext, const cell_t* params) {
 
     // Start the thread that executes the command
     ExecuteThread* commandThread = new ExecuteThread(command, params[3], callback);
+    if (!ApplyExecuteOptions(commandThread, pContext, params, 4)) {
+        delete commandThread;
+        return 0;
+    }
+
     commandThread->RunThread();
 
     return 1;
@@ -277,6 +388,62 @@ cell_t NativeExecuteFormattedThreaded(IPluginContext* pContext, const cell_t* pa
     return 1;
 }
 
+cell_t NativeExecuteThreadedWithInput(IPluginContext* pContext, const cell_t* params) {
+    char* command;
+    char* input;
+    pContext->LocalToString(params[2], &command);
+    pContext->LocalToString(params[3], &input);
+
+    auto callback = system2Extension.CreateCallbackFunction(pContext->GetFunctionById(params[1]));
+    if (!callback) {
+        pContext->ThrowNativeError("Callback ID %x is invalid", params[1]);
+        return 0;
+    }
+
+    // A negative length means the input is a string
+    size_t length = params[4] < 0 ? strlen(input) : static_cast<size_t>(params[4]);
+
+    // Start the thread that executes the command and pipes the input to it
+    ExecuteThread* commandThread = new ExecuteThread(command, params[5], callback);
+    commandThread->SetInput(std::string(input, length));
+    if (!ApplyExecuteOptions(commandThread, pContext, params, 6)) {
+        delete commandThread;
+        return 0;
+    }
+
+    commandThread->RunThread();
+
+    return 1;
+}
+
+cell_t NativeExecuteThreadedWithInputFile(IPluginContext* pContext, const cell_t* params) {
+    char* command;
+    char* inputFile;
+    char fullInputPath[PLATFORM_MAX_PATH + 1];
+    pContext->LocalToString(params[2], &command);
+    pContext->LocalToString(params[3], &inputFile);
+
+    auto callback = system2Extension.CreateCallbackFunction(pContext->GetFunctionById(params[1]));
+    if (!callback) {
+        pContext->ThrowNativeError("Callback ID %x is invalid", params[1]);
+        return 0;
+    }
+
+    g_pSM->BuildPath(Path_Game, fullInputPath, sizeof(fullInputPath), inputFile);
+
+    // Start the thread that executes the command and streams the file to it
+    ExecuteThread* commandThread = new ExecuteThread(command, params[4], callback);
+    commandThread->SetInputFile(fullInputPath);
+    if (!ApplyExecuteOptions(commandThread, pContext, params, 5)) {
+        delete commandThread;
+        return 0;
+    }
+
+    commandThread->RunThread();
+
+    return 1;
+}
+
 cell_t NativeExecuteOutput_GetOutput(IPluginContext* pContext, const cell_t* params) {
     // Get the handle to the execute callback
     Handle_t hndl = static_cast<Handle_t>(params[1]);
@@ -352,6 +519,206 @@ cell_t NativeExecuteOutput_GetExitStatus(IPluginContext* pContext, const cell_t*
     return callback->GetExitStatus();
 }
 
+cell_t NativeExecuteOutput_GetStatus(IPluginContext* pContext, const cell_t* params) {
+    // Get the handle to the execute callback
+    Handle_t hndl = static_cast<Handle_t>(params[1]);
+
+    ExecuteCallback* callback = ExecuteCallback::ConvertExecuteCallback(hndl, pContext);
+    if (!callback) {
+        return 0;
+    }
+
+    return callback->GetStatus();
+}
+
+cell_t NativeExecuteOptions_ExecuteOptions(IPluginContext* pContext, const cell_t* params) {
+    ExecuteOptions* options = new ExecuteOptions();
+
+    Handle_t hndl = executeOptionsHandler.CreateHandle(options, pContext->GetIdentity());
+    if (hndl == BAD_HANDLE) {
+        delete options;
+        pContext->ThrowNativeError("Couldn't create execute options handle");
+    }
+
+    return hndl;
+}
+
+cell_t NativeExecuteOptions_GetTimeout(IPluginContext* pContext, const cell_t* params) {
+    ExecuteOptions* options = ExecuteOptions::ConvertExecuteOptions(params[1], pContext);
+    if (!options) {
+        return 0;
+    }
+
+    return options->timeout;
+}
+
+cell_t NativeExecuteOptions_SetTimeout(IPluginContext* pContext, const cell_t* params) {
+    ExecuteOptions* options = ExecuteOptions::ConvertExecuteOptions(params[1], pContext);
+    if (!options) {
+        return 0;
+    }
+
+    if (params[2] < 0) {
+        pContext->ThrowNativeError("Invalid timeout %d", params[2]);
+        return 0;
+    }
+
+    options->timeout = params[2];
+    return 1;
+}
+
+cell_t NativeExecuteOptions_GetKillDelay(IPluginContext* pContext, const cell_t* params) {
+    ExecuteOptions* options = ExecuteOptions::ConvertExecuteOptions(params[1], pContext);
+    if (!options) {
+        return 0;
+    }
+
+    return options->killDelay;
+}
+
+cell_t NativeExecuteOptions_SetKillDelay(IPluginContext* pContext, const cell_t* params) {
+    ExecuteOptions* options = ExecuteOptions::ConvertExecuteOptions(params[1], pContext);
+    if (!options) {
+        return 0;
+    }
+
+    if (params[2] < 0) {
+        pContext->ThrowNativeError("Invalid kill delay %d", params[2]);
+        return 0;
+    }
+
+    options->killDelay = params[2];
+    return 1;
+}
+
+cell_t NativeExecuteOptions_GetCPULimit(IPluginContext* pContext, const cell_t* params) {
+    ExecuteOptions* options = ExecuteOptions::ConvertExecuteOptions(params[1], pContext);
+    if (!options) {
+        return 0;
+    }
+
+    return options->cpuLimit;
+}
+
+cell_t NativeExecuteOptions_SetCPULimit(IPluginContext* pContext, const cell_t* params) {
+    ExecuteOptions* options = ExecuteOptions::ConvertExecuteOptions(params[1], pContext);
+    if (!options) {
+        return 0;
+    }
+
+    if (params[2] < 0) {
+        pContext->ThrowNativeError("Invalid CPU limit %d", params[2]);
+        return 0;
+    }
+
+    options->cpuLimit = params[2];
+    return 1;
+}
+
+cell_t NativeExecuteOptions_GetMemoryLimit(IPluginContext* pContext, const cell_t* params) {
+    ExecuteOptions* options = ExecuteOptions::ConvertExecuteOptions(params[1], pContext);
+    if (!options) {
+        return 0;
+    }
+
+    return options->memoryLimit;
+}
+
+cell_t NativeExecuteOptions_SetMemoryLimit(IPluginContext* pContext, const cell_t* params) {
+    ExecuteOptions* options = ExecuteOptions::ConvertExecuteOptions(params[1], pContext);
+    if (!options) {
+        return 0;
+    }
+
+    if (params[2] < 0) {
+        pContext->ThrowNativeError("Invalid memory limit %d", params[2]);
+        return 0;
+    }
+
+#if !defined _WIN32 && !defined _WIN64
+    // The limit is set in bytes, which the 32 bit build can only represent below 4096 megabytes
+    if (static_cast<uint64_t>(params[2]) * 1024 * 1024 >= static_cast<uint64_t>(RLIM_INFINITY)) {
+        pContext->ThrowNativeError("Memory limit %d is too large for this platform", params[2]);
+        return 0;
+    }
+#endif
+
+    options->memoryLimit = params[2];
+    return 1;
+}
+
+cell_t NativeExecuteOptions_GetNice(IPluginContext* pContext, const cell_t* params) {
+    ExecuteOptions* options = ExecuteOptions::ConvertExecuteOptions(params[1], pContext);
+    if (!options) {
+        return 0;
+    }
+
+    return options->nice;
+}
+
+cell_t NativeExecuteOptions_SetNice(IPluginContext* pContext, const cell_t* params) {
+    ExecuteOptions* options = ExecuteOptions::ConvertExecuteOptions(params[1], pContext);
+    if (!options) {
+        return 0;
+    }
+
+    if (params[2] < 0 || params[2] > 19) {
+        pContext->ThrowNativeError("Invalid nice level %d", params[2]);
+        return 0;
+    }
+
+    options->nice = params[2];
+    return 1;
+}
+
+cell_t NativeExecuteOptions_GetIOClass(IPluginContext* pContext, const cell_t* params) {
+    ExecuteOptions* options = ExecuteOptions::ConvertExecuteOptions(params[1], pContext);
+    if (!options) {
+        return 0;
+    }
+
+    return options->ioClass;
+}
+
+cell_t NativeExecuteOptions_SetIOClass(IPluginContext* pContext, const cell_t* params) {
+    ExecuteOptions* options = ExecuteOptions::ConvertExecuteOptions(params[1], pContext);
+    if (!options) {
+        return 0;
+    }
+
+    if (params[2] < EXECUTE_IO_DEFAULT || params[2] > EXECUTE_IO_IDLE) {
+        pContext->ThrowNativeError("Invalid IO class %d", params[2]);
+        return 0;
+    }
+
+    options->ioClass = static_cast<ExecuteIOClass>(params[2]);
+    return 1;
+}
+
+cell_t NativeExecuteOptions_GetIOLevel(IPluginContext* pContext, const cell_t* params) {
+    ExecuteOptions* options = ExecuteOptions::ConvertExecuteOptions(params[1], pContext);
+    if (!options) {
+        return 0;
+    }
+
+    return options->ioLevel;
+}
+
+cell_t NativeExecuteOptions_SetIOLevel(IPluginContext* pContext, const cell_t* params) {
+    ExecuteOptions* options = ExecuteOptions::ConvertExecuteOptions(params[1], pContext);
+    if (!options) {
+        return 0;
+    }
+
+    if (params[2] < 0 || params[2] > 7) {
+        pContext->ThrowNativeError("Invalid IO level %d", params[2]);
+        return 0;
+    }
+
+    options->ioLevel = params[2];
+    return 1;
+}
+
 cell_t NativeExecute(IPluginContext* pContext, const cell_t* params) {
     char* command;
     pContext->LocalToString(params[3], &command);
@@ -0,0 +1,40 @@
+/**
+ * -----------------------------------------------------
+ * File        ExecuteOptions.cpp
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "ExecuteOptions.h"
+
+ExecuteOptions::ExecuteOptions() :
+    timeout(0), killDelay(DEFAULT_KILL_DELAY), cpuLimit(0), memoryLimit(0), nice(0), ioClass(EXECUTE_IO_DEFAULT), ioLevel(4) {}
+
+ExecuteOptions* ExecuteOptions::ConvertExecuteOptions(Handle_t hndl, IPluginContext* pContext) {
+    HandleError err;
+
+    ExecuteOptions* options = nullptr;
+    if ((err = executeOptionsHandler.ReadHandle(hndl, pContext->GetIdentity(), &options)) != HandleError_None) {
+        pContext->ThrowNativeError("Invalid execute options handle %x (error %d)", hndl, err);
+        return nullptr;
+    }
+
+    return options;
+}
@@ -0,0 +1,50 @@
+/**
+ * -----------------------------------------------------
+ * File        ExecuteOptions.h
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#ifndef _SYSTEM2_EXECUTE_OPTIONS_H_
+#define _SYSTEM2_EXECUTE_OPTIONS_H_
+
+#include "extension.h"
+#include "ExecuteOptionsHandler.h"
+#include "ExecuteIOClass.h"
+
+// Default seconds between SIGTERM and SIGKILL
+#define DEFAULT_KILL_DELAY 5
+
+class ExecuteOptions {
+public:
+    int timeout;
+    int killDelay;
+    int cpuLimit;
+    int memoryLimit;
+    int nice;
+    ExecuteIOClass ioClass;
+    int ioLevel;
+
+    ExecuteOptions();
+
+    static ExecuteOptions* ConvertExecuteOptions(Handle_t hndl, IPluginContext* pContext);
+};
+
+#endif
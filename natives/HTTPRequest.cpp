@@ -24,13 +24,17 @@
 
 #include "HTTPRequest.h"
 #include "HTTPRequestThread.h"
+#include "Codec.h"
 
 HTTPRequest::HTTPRequest(std::string url, std::shared_ptr<CallbackFunction_t> responseCallbackFunction)
-    : Request(url, responseCallbackFunction), followRedirects(true) {}
+    : Request(url, responseCallbackFunction), bodyEncoding(BODY_ENCODING_NONE), followRedirects(true), hostLimit(false), eventStreamFormat(STREAM_NONE), eventBacklog(1024), eventReconnects(10),
+    eventCallbackFunction(nullptr) {}
 
 HTTPRequest::HTTPRequest(const HTTPRequest& request) :
-    Request(request), bodyData(request.bodyData), headers(request.headers), userAgent(request.userAgent),
-    username(request.username), password(request.password), followRedirects(request.followRedirects) {}
+    Request(request), bodyData(request.bodyData), bodyEncoding(request.bodyEncoding), headers(request.headers), userAgent(request.userAgent),
+    username(request.username), password(request.password), followRedirects(request.followRedirects), hostLimit(request.hostLimit),
+    eventStreamFormat(request.eventStreamFormat), eventBacklog(request.eventBacklog), eventReconnects(request.eventReconnects),
+    eventCallbackFunction(request.eventCallbackFunction) {}
 
 HTTPRequest* HTTPRequest::Clone() const {
     return new HTTPRequest(*this);
@@ -60,6 +64,16 @@ void HTTPRequest::Head() {
     MakeThread(METHOD_HEAD);
 }
 
+void HTTPRequest::EncodeBody() {
+    if (this->bodyEncoding == BODY_ENCODING_BASE64) {
+        this->bodyData = Codec::Base64Encode(this->bodyData);
+    } else if (this->bodyEncoding == BODY_ENCODING_HEX) {
+        this->bodyData = Codec::HexEncode(this->bodyData);
+    }
+
+    this->bodyEncoding = BODY_ENCODING_NONE;
+}
+
 void HTTPRequest::MakeThread(HTTPRequestMethod method) {
     // Make a copy for the thread, so it works independent
     HTTPRequestThread* requestThread = new HTTPRequestThread(this->Clone(), method);
@@ -27,17 +27,26 @@
 
 #include "Request.h"
 #include "HTTPRequestMethod.h"
+#include "EventStreamFormat.h"
+#include "BodyEncoding.h"
 
 #include <map>
 
 class HTTPRequest : public Request {
 public:
     std::string bodyData;
+    BodyEncoding bodyEncoding;
     std::map<std::string, std::string> headers;
     std::string userAgent;
     std::string username;
     std::string password;
     bool followRedirects;
+    bool hostLimit;
+    EventStreamFormat eventStreamFormat;
+    int eventBacklog;
+    int eventReconnects;
+
+    std::shared_ptr<CallbackFunction_t> eventCallbackFunction;
 
     HTTPRequest(std::string url, std::shared_ptr<CallbackFunction_t> responseCallbackFunction);
     HTTPRequest(const HTTPRequest& request);
@@ -51,6 +60,9 @@ public:
     void Delete();
     void Head();
 
+    // Encodes the body data with the body encoding, afterwards the body is not encoded again
+    void EncodeBody();
+
 private:
     void MakeThread(HTTPRequestMethod method);
 };
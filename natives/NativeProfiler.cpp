@@ -0,0 +1,140 @@
+/**
+ * -----------------------------------------------------
+ * File        NativeProfiler.cpp
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "NativeProfiler.h"
+
+#include <algorithm>
+#include <utility>
+
+NativeProfiler nativeProfiler;
+
+// Every timed native needs its own function, as the native callback does not know which native was called
+template<size_t Index>
+static cell_t TimedNative(IPluginContext* pContext, const cell_t* params) {
+    return nativeProfiler.Invoke(Index, pContext, params);
+}
+
+template<size_t... Indices>
+static const SPVM_NATIVE_FUNC* GetTimedNatives(std::index_sequence<Indices...>) {
+    static const SPVM_NATIVE_FUNC timedNatives[] = { &TimedNative<Indices>... };
+    return timedNatives;
+}
+
+NativeProfiler::NativeProfiler() : enabled(false), thresholdMs(5.0) {}
+
+void NativeProfiler::Shutdown() {
+    this->enabled = false;
+    this->Reset();
+}
+
+const sp_nativeinfo_t* NativeProfiler::Wrap(const sp_nativeinfo_t* table) {
+    static const SPVM_NATIVE_FUNC* timedNatives = GetTimedNatives(std::make_index_sequence<PROFILER_MAX_NATIVES>());
+
+    // The table has to stay alive as long as the natives are registered
+    this->timedTables.emplace_back();
+    std::vector<sp_nativeinfo_t>& timedTable = this->timedTables.back();
+
+    for (const sp_nativeinfo_t* native = table; native->name; native++) {
+        if (this->natives.size() >= PROFILER_MAX_NATIVES) {
+            timedTable.push_back(*native);
+            continue;
+        }
+
+        timedTable.push_back({ native->name, timedNatives[this->natives.size()] });
+        this->natives.push_back({ native->name, native->func });
+    }
+
+    timedTable.push_back({ nullptr, nullptr });
+    return timedTable.data();
+}
+
+cell_t NativeProfiler::Invoke(size_t index, IPluginContext* pContext, const cell_t* params) {
+    const ProfiledNative_t& native = this->natives[index];
+    if (!this->enabled) {
+        return native.func(pContext, params);
+    }
+
+    std::string plugin = this->GetPluginName(plsys->FindPluginByContext(pContext->GetContext()));
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    cell_t result = native.func(pContext, params);
+    this->Record(native.name, plugin, start);
+
+    return result;
+}
+
+void NativeProfiler::Record(const char* name, const std::string& plugin, std::chrono::steady_clock::time_point start) {
+    uint64_t us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+    // Find the histogram bucket of the duration
+    size_t bucket = 0;
+    for (uint64_t limit = 10; bucket < PROFILER_BUCKETS - 1 && us >= limit; limit *= 10) {
+        bucket++;
+    }
+
+    ProfilerStats_t* stats[] = { &this->nativeStats[name], &this->pluginStats[plugin] };
+    for (ProfilerStats_t* stat : stats) {
+        stat->calls++;
+        stat->totalUs += us;
+        stat->maxUs = std::max(stat->maxUs, us);
+        stat->buckets[bucket]++;
+    }
+
+    if (this->thresholdMs > 0.0 && us >= this->thresholdMs * 1000.0) {
+        smutils->LogMessage(myself, "%s took %.3f ms on the game thread (plugin %s)", name, us / 1000.0, plugin.c_str());
+    }
+}
+
+bool NativeProfiler::IsEnabled() const {
+    return this->enabled;
+}
+
+void NativeProfiler::SetEnabled(bool enabled) {
+    this->enabled = enabled;
+}
+
+double NativeProfiler::GetThreshold() const {
+    return this->thresholdMs;
+}
+
+void NativeProfiler::SetThreshold(double thresholdMs) {
+    this->thresholdMs = thresholdMs;
+}
+
+const std::map<std::string, ProfilerStats_t>& NativeProfiler::GetNativeStats() const {
+    return this->nativeStats;
+}
+
+const std::map<std::string, ProfilerStats_t>& NativeProfiler::GetPluginStats() const {
+    return this->pluginStats;
+}
+
+void NativeProfiler::Reset() {
+    this->nativeStats.clear();
+    this->pluginStats.clear();
+}
+
+std::string NativeProfiler::GetPluginName(IPlugin* plugin) const {
+    return plugin ? plugin->GetFilename() : "<extension>";
+}
@@ -0,0 +1,91 @@
+/**
+ * -----------------------------------------------------
+ * File        NativeProfiler.h
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#ifndef _SYSTEM2_NATIVE_PROFILER_H_
+#define _SYSTEM2_NATIVE_PROFILER_H_
+
+#include "smsdk_ext.h"
+
+#include <chrono>
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+
+// Maximum number of natives which can be timed, further natives are registered untimed
+#define PROFILER_MAX_NATIVES 512
+
+// Histogram buckets: <10us, <100us, <1ms, <10ms, <100ms, >=100ms
+#define PROFILER_BUCKETS 6
+
+typedef struct {
+    uint64_t calls;
+    uint64_t totalUs;
+    uint64_t maxUs;
+    uint64_t buckets[PROFILER_BUCKETS];
+} ProfilerStats_t;
+
+typedef struct {
+    const char* name;
+    SPVM_NATIVE_FUNC func;
+} ProfiledNative_t;
+
+class NativeProfiler {
+private:
+    bool enabled;
+    double thresholdMs;
+
+    std::vector<ProfiledNative_t> natives;
+    std::list<std::vector<sp_nativeinfo_t>> timedTables;
+
+    std::map<std::string, ProfilerStats_t> nativeStats;
+    std::map<std::string, ProfilerStats_t> pluginStats;
+
+public:
+    NativeProfiler();
+
+    void Shutdown();
+
+    // Returns a copy of the native table whose functions are timed when profiling is enabled
+    const sp_nativeinfo_t* Wrap(const sp_nativeinfo_t* table);
+
+    cell_t Invoke(size_t index, IPluginContext* pContext, const cell_t* params);
+    void Record(const char* name, const std::string& plugin, std::chrono::steady_clock::time_point start);
+
+    bool IsEnabled() const;
+    void SetEnabled(bool enabled);
+
+    double GetThreshold() const;
+    void SetThreshold(double thresholdMs);
+
+    const std::map<std::string, ProfilerStats_t>& GetNativeStats() const;
+    const std::map<std::string, ProfilerStats_t>& GetPluginStats() const;
+    void Reset();
+
+    std::string GetPluginName(IPlugin* plugin) const;
+};
+
+extern NativeProfiler nativeProfiler;
+
+#endif
@@ -33,21 +33,38 @@ cell_t NativeRequest_SetPort(IPluginContext* pContext, const cell_t* params);
 cell_t NativeRequest_GetPort(IPluginContext* pContext, const cell_t* params);
 cell_t NativeRequest_SetOutputFile(IPluginContext* pContext, const cell_t* params);
 cell_t NativeRequest_GetOutputFile(IPluginContext* pContext, const cell_t* params);
+cell_t NativeRequest_SetExtractDirectory(IPluginContext* pContext, const cell_t* params);
+cell_t NativeRequest_GetExtractDirectory(IPluginContext* pContext, const cell_t* params);
 cell_t NativeRequest_SetVerifySSL(IPluginContext* pContext, const cell_t* params);
 cell_t NativeRequest_GetVerifySSL(IPluginContext* pContext, const cell_t* params);
 cell_t NativeRequest_SetProxy(IPluginContext* pContext, const cell_t* params);
 cell_t NativeRequest_SetProxyAuthentication(IPluginContext* pContext, const cell_t* params);
+cell_t NativeRequest_SetUnixSocketPath(IPluginContext* pContext, const cell_t* params);
+cell_t NativeRequest_GetUnixSocketPath(IPluginContext* pContext, const cell_t* params);
+cell_t NativeRequest_SetTuningProfile(IPluginContext* pContext, const cell_t* params);
 cell_t NativeRequest_GetTimeout(IPluginContext* pContext, const cell_t* params);
 cell_t NativeRequest_SetTimeout(IPluginContext* pContext, const cell_t* params);
+cell_t NativeRequest_GetDeadline(IPluginContext* pContext, const cell_t* params);
+cell_t NativeRequest_SetDeadline(IPluginContext* pContext, const cell_t* params);
+cell_t NativeRequest_GetError(IPluginContext* pContext, const cell_t* params);
 cell_t NativeRequest_GetAnyData(IPluginContext* pContext, const cell_t* params);
 cell_t NativeRequest_SetAnyData(IPluginContext* pContext, const cell_t* params);
 cell_t NativeRequest_SetMaxSendSpeed(IPluginContext* pContext, const cell_t* params);
 cell_t NativeRequest_SetMaxRecvSpeed(IPluginContext* pContext, const cell_t* params);
+cell_t NativeRequest_GetMaxMemoryContent(IPluginContext* pContext, const cell_t* params);
+cell_t NativeRequest_SetMaxMemoryContent(IPluginContext* pContext, const cell_t* params);
+cell_t NativeRequest_GetWriteBehind(IPluginContext* pContext, const cell_t* params);
+cell_t NativeRequest_SetWriteBehind(IPluginContext* pContext, const cell_t* params);
 
 cell_t NativeHTTPRequest_HTTPRequest(IPluginContext* pContext, const cell_t* params);
 cell_t NativeHTTPRequest_SetProgressCallback(IPluginContext* pContext, const cell_t* params);
 cell_t NativeHTTPRequest_SetData(IPluginContext* pContext, const cell_t* params);
 cell_t NativeHTTPRequest_GetData(IPluginContext* pContext, const cell_t* params);
+cell_t NativeHTTPRequest_SetBinaryData(IPluginContext* pContext, const cell_t* params);
+cell_t NativeHTTPRequest_GetBinaryData(IPluginContext* pContext, const cell_t* params);
+cell_t NativeHTTPRequest_GetDataLength(IPluginContext* pContext, const cell_t* params);
+cell_t NativeHTTPRequest_GetBodyEncoding(IPluginContext* pContext, const cell_t* params);
+cell_t NativeHTTPRequest_SetBodyEncoding(IPluginContext* pContext, const cell_t* params);
 cell_t NativeHTTPRequest_SetHeader(IPluginContext* pContext, const cell_t* params);
 cell_t NativeHTTPRequest_GetHeader(IPluginContext* pContext, const cell_t* params);
 cell_t NativeHTTPRequest_GetHeaderName(IPluginContext* pContext, const cell_t* params);
@@ -60,8 +77,16 @@ cell_t NativeHTTPRequest_PUT(IPluginContext* pContext, const cell_t* params);
 cell_t NativeHTTPRequest_PATCH(IPluginContext* pContext, const cell_t* params);
 cell_t NativeHTTPRequest_DELETE(IPluginContext* pContext, const cell_t* params);
 cell_t NativeHTTPRequest_HEAD(IPluginContext* pContext, const cell_t* params);
+cell_t NativeHTTPRequest_Enqueue(IPluginContext* pContext, const cell_t* params);
 cell_t NativeHTTPRequest_GetFollowRedirects(IPluginContext* pContext, const cell_t* params);
 cell_t NativeHTTPRequest_SetFollowRedirects(IPluginContext* pContext, const cell_t* params);
+cell_t NativeHTTPRequest_GetHostLimit(IPluginContext* pContext, const cell_t* params);
+cell_t NativeHTTPRequest_SetHostLimit(IPluginContext* pContext, const cell_t* params);
+cell_t NativeHTTPRequest_SetEventCallback(IPluginContext* pContext, const cell_t* params);
+cell_t NativeHTTPRequest_GetEventBacklog(IPluginContext* pContext, const cell_t* params);
+cell_t NativeHTTPRequest_SetEventBacklog(IPluginContext* pContext, const cell_t* params);
+cell_t NativeHTTPRequest_GetEventReconnects(IPluginContext* pContext, const cell_t* params);
+cell_t NativeHTTPRequest_SetEventReconnects(IPluginContext* pContext, const cell_t* params);
 
 cell_t NativeFTPRequest_FTPRequest(IPluginContext* pContext, const cell_t* params);
 cell_t NativeFTPRequest_SetProgressCallback(IPluginContext* pContext, const cell_t* params);
@@ -78,6 +103,7 @@ cell_t NativeFTPRequest_SetListFilenamesOnly(IPluginContext* pContext, const cel
 
 cell_t NativeResponse_GetLastURL(IPluginContext* pContext, const cell_t* params);
 cell_t NativeResponse_GetContent(IPluginContext* pContext, const cell_t* params);
+cell_t NativeResponse_GetBinaryContent(IPluginContext* pContext, const cell_t* params);
 cell_t NativeResponse_GetContentLength(IPluginContext* pContext, const cell_t* params);
 cell_t NativeResponse_GetStatusCode(IPluginContext* pContext, const cell_t* params);
 cell_t NativeResponse_GetTotalTime(IPluginContext* pContext, const cell_t* params);
@@ -92,21 +118,123 @@ cell_t NativeHTTPResponse_GetHeaderName(IPluginContext* pContext, const cell_t*
 cell_t NativeHTTPResponse_GetHeaders(IPluginContext* pContext, const cell_t* params);
 cell_t NativeHTTPResponse_GetHTTPVersion(IPluginContext* pContext, const cell_t* params);
 
+cell_t NativeEventBatch_GetCount(IPluginContext* pContext, const cell_t* params);
+cell_t NativeEventBatch_GetDropped(IPluginContext* pContext, const cell_t* params);
+cell_t NativeEventBatch_GetData(IPluginContext* pContext, const cell_t* params);
+cell_t NativeEventBatch_GetType(IPluginContext* pContext, const cell_t* params);
+cell_t NativeEventBatch_GetId(IPluginContext* pContext, const cell_t* params);
+
+cell_t NativeTuningProfile_TuningProfile(IPluginContext* pContext, const cell_t* params);
+cell_t NativeTuningProfile_GetNoDelay(IPluginContext* pContext, const cell_t* params);
+cell_t NativeTuningProfile_SetNoDelay(IPluginContext* pContext, const cell_t* params);
+cell_t NativeTuningProfile_GetKeepAliveIdle(IPluginContext* pContext, const cell_t* params);
+cell_t NativeTuningProfile_SetKeepAliveIdle(IPluginContext* pContext, const cell_t* params);
+cell_t NativeTuningProfile_GetKeepAliveInterval(IPluginContext* pContext, const cell_t* params);
+cell_t NativeTuningProfile_SetKeepAliveInterval(IPluginContext* pContext, const cell_t* params);
+cell_t NativeTuningProfile_GetFastOpen(IPluginContext* pContext, const cell_t* params);
+cell_t NativeTuningProfile_SetFastOpen(IPluginContext* pContext, const cell_t* params);
+cell_t NativeTuningProfile_GetExpectContinue(IPluginContext* pContext, const cell_t* params);
+cell_t NativeTuningProfile_SetExpectContinue(IPluginContext* pContext, const cell_t* params);
+cell_t NativeTuningProfile_GetLowSpeedLimit(IPluginContext* pContext, const cell_t* params);
+cell_t NativeTuningProfile_SetLowSpeedLimit(IPluginContext* pContext, const cell_t* params);
+cell_t NativeTuningProfile_GetLowSpeedTime(IPluginContext* pContext, const cell_t* params);
+cell_t NativeTuningProfile_SetLowSpeedTime(IPluginContext* pContext, const cell_t* params);
+cell_t NativeTuningProfile_GetBufferSize(IPluginContext* pContext, const cell_t* params);
+cell_t NativeTuningProfile_SetBufferSize(IPluginContext* pContext, const cell_t* params);
+
+cell_t NativePreparedRequest_PreparedRequest(IPluginContext* pContext, const cell_t* params);
+cell_t NativePreparedRequest_Send(IPluginContext* pContext, const cell_t* params);
+cell_t NativePreparedRequest_SendBinary(IPluginContext* pContext, const cell_t* params);
+
+cell_t NativeBatchChannel_BatchChannel(IPluginContext* pContext, const cell_t* params);
+cell_t NativeBatchChannel_Add(IPluginContext* pContext, const cell_t* params);
+cell_t NativeBatchChannel_Flush(IPluginContext* pContext, const cell_t* params);
+cell_t NativeBatchChannel_GetMaxRecords(IPluginContext* pContext, const cell_t* params);
+cell_t NativeBatchChannel_SetMaxRecords(IPluginContext* pContext, const cell_t* params);
+cell_t NativeBatchChannel_GetMaxBytes(IPluginContext* pContext, const cell_t* params);
+cell_t NativeBatchChannel_SetMaxBytes(IPluginContext* pContext, const cell_t* params);
+cell_t NativeBatchChannel_GetMaxDelay(IPluginContext* pContext, const cell_t* params);
+cell_t NativeBatchChannel_SetMaxDelay(IPluginContext* pContext, const cell_t* params);
+cell_t NativeBatchChannel_GetPending(IPluginContext* pContext, const cell_t* params);
+
+cell_t NativeSequenceChannel_SequenceChannel(IPluginContext* pContext, const cell_t* params);
+cell_t NativeSequenceChannel_Send(IPluginContext* pContext, const cell_t* params);
+cell_t NativeSequenceChannel_GetMaxInFlight(IPluginContext* pContext, const cell_t* params);
+cell_t NativeSequenceChannel_SetMaxInFlight(IPluginContext* pContext, const cell_t* params);
+cell_t NativeSequenceChannel_GetMaxRetries(IPluginContext* pContext, const cell_t* params);
+cell_t NativeSequenceChannel_SetMaxRetries(IPluginContext* pContext, const cell_t* params);
+cell_t NativeSequenceChannel_GetPending(IPluginContext* pContext, const cell_t* params);
+
+cell_t NativePackWriter_PackWriter(IPluginContext* pContext, const cell_t* params);
+cell_t NativePackWriter_WriteNil(IPluginContext* pContext, const cell_t* params);
+cell_t NativePackWriter_WriteBool(IPluginContext* pContext, const cell_t* params);
+cell_t NativePackWriter_WriteInt(IPluginContext* pContext, const cell_t* params);
+cell_t NativePackWriter_WriteFloat(IPluginContext* pContext, const cell_t* params);
+cell_t NativePackWriter_WriteString(IPluginContext* pContext, const cell_t* params);
+cell_t NativePackWriter_WriteBinary(IPluginContext* pContext, const cell_t* params);
+cell_t NativePackWriter_WriteArray(IPluginContext* pContext, const cell_t* params);
+cell_t NativePackWriter_WriteMap(IPluginContext* pContext, const cell_t* params);
+cell_t NativePackWriter_GetLength(IPluginContext* pContext, const cell_t* params);
+cell_t NativePackWriter_AttachTo(IPluginContext* pContext, const cell_t* params);
+cell_t NativePackWriter_SendPrepared(IPluginContext* pContext, const cell_t* params);
+
+cell_t NativePackReader_PackReader(IPluginContext* pContext, const cell_t* params);
+cell_t NativePackReader_GetType(IPluginContext* pContext, const cell_t* params);
+cell_t NativePackReader_ReadBool(IPluginContext* pContext, const cell_t* params);
+cell_t NativePackReader_ReadInt(IPluginContext* pContext, const cell_t* params);
+cell_t NativePackReader_ReadFloat(IPluginContext* pContext, const cell_t* params);
+cell_t NativePackReader_ReadString(IPluginContext* pContext, const cell_t* params);
+cell_t NativePackReader_ReadBinary(IPluginContext* pContext, const cell_t* params);
+cell_t NativePackReader_ReadArray(IPluginContext* pContext, const cell_t* params);
+cell_t NativePackReader_ReadMap(IPluginContext* pContext, const cell_t* params);
+cell_t NativePackReader_Skip(IPluginContext* pContext, const cell_t* params);
+cell_t NativePackReader_FindKey(IPluginContext* pContext, const cell_t* params);
+cell_t NativePackReader_GetPosition(IPluginContext* pContext, const cell_t* params);
+cell_t NativePackReader_SetPosition(IPluginContext* pContext, const cell_t* params);
+cell_t NativePackReader_GetLength(IPluginContext* pContext, const cell_t* params);
+
 cell_t NativeURLEncode(IPluginContext* pContext, const cell_t* params);
 cell_t NativeURLDecode(IPluginContext* pContext, const cell_t* params);
+cell_t NativeBase64Encode(IPluginContext* pContext, const cell_t* params);
+cell_t NativeBase64Decode(IPluginContext* pContext, const cell_t* params);
+cell_t NativeHexEncode(IPluginContext* pContext, const cell_t* params);
+cell_t NativeHexDecode(IPluginContext* pContext, const cell_t* params);
 
 cell_t NativeCopyFile(IPluginContext* pContext, const cell_t* params);
+cell_t NativeSetThreadPolicy(IPluginContext* pContext, const cell_t* params);
+cell_t NativeSetSpillDirectory(IPluginContext* pContext, const cell_t* params);
 
 cell_t NativeCheck7ZIP(IPluginContext* pContext, const cell_t* params);
 cell_t NativeCompress(IPluginContext* pContext, const cell_t* params);
 cell_t NativeExtract(IPluginContext* pContext, const cell_t* params);
+cell_t NativeGzipFile(IPluginContext* pContext, const cell_t* params);
+cell_t NativeBuildFastDL(IPluginContext* pContext, const cell_t* params);
 bool Get7ZIPExecutable(bool force32Bit, std::string& binDir);
 
 cell_t NativeExecuteThreaded(IPluginContext* pContext, const cell_t* params);
 cell_t NativeExecuteFormattedThreaded(IPluginContext* pContext, const cell_t* params);
+cell_t NativeExecuteThreadedWithInput(IPluginContext* pContext, const cell_t* params);
+cell_t NativeExecuteThreadedWithInputFile(IPluginContext* pContext, const cell_t* params);
 cell_t NativeExecuteOutput_GetOutput(IPluginContext* pContext, const cell_t* params);
 cell_t NativeExecuteOutput_GetLength(IPluginContext* pContext, const cell_t* params);
 cell_t NativeExecuteOutput_GetExitStatus(IPluginContext* pContext, const cell_t* params);
+cell_t NativeExecuteOutput_GetStatus(IPluginContext* pContext, const cell_t* params);
+
+cell_t NativeExecuteOptions_ExecuteOptions(IPluginContext* pContext, const cell_t* params);
+cell_t NativeExecuteOptions_GetTimeout(IPluginContext* pContext, const cell_t* params);
+cell_t NativeExecuteOptions_SetTimeout(IPluginContext* pContext, const cell_t* params);
+cell_t NativeExecuteOptions_GetKillDelay(IPluginContext* pContext, const cell_t* params);
+cell_t NativeExecuteOptions_SetKillDelay(IPluginContext* pContext, const cell_t* params);
+cell_t NativeExecuteOptions_GetCPULimit(IPluginContext* pContext, const cell_t* params);
+cell_t NativeExecuteOptions_SetCPULimit(IPluginContext* pContext, const cell_t* params);
+cell_t NativeExecuteOptions_GetMemoryLimit(IPluginContext* pContext, const cell_t* params);
+cell_t NativeExecuteOptions_SetMemoryLimit(IPluginContext* pContext, const cell_t* params);
+cell_t NativeExecuteOptions_GetNice(IPluginContext* pContext, const cell_t* params);
+cell_t NativeExecuteOptions_SetNice(IPluginContext* pContext, const cell_t* params);
+cell_t NativeExecuteOptions_GetIOClass(IPluginContext* pContext, const cell_t* params);
+cell_t NativeExecuteOptions_SetIOClass(IPluginContext* pContext, const cell_t* params);
+cell_t NativeExecuteOptions_GetIOLevel(IPluginContext* pContext, const cell_t* params);
+cell_t NativeExecuteOptions_SetIOLevel(IPluginContext* pContext, const cell_t* params);
 
 cell_t NativeExecute(IPluginContext* pContext, const cell_t* params);
 cell_t NativeExecuteFormatted(IPluginContext* pContext, const cell_t* params);
@@ -128,21 +256,38 @@ const sp_nativeinfo_t system2_natives[] =
     { "System2Request.GetPort", NativeRequest_GetPort },
     { "System2Request.SetOutputFile", NativeRequest_SetOutputFile },
     { "System2Request.GetOutputFile", NativeRequest_GetOutputFile },
+    { "System2Request.SetExtractDirectory", NativeRequest_SetExtractDirectory },
+    { "System2Request.GetExtractDirectory", NativeRequest_GetExtractDirectory },
     { "System2Request.SetVerifySSL", NativeRequest_SetVerifySSL },
     { "System2Request.GetVerifySSL", NativeRequest_GetVerifySSL },
     { "System2Request.SetProxy", NativeRequest_SetProxy },
     { "System2Request.SetProxyAuthentication", NativeRequest_SetProxyAuthentication },
+    { "System2Request.SetUnixSocketPath", NativeRequest_SetUnixSocketPath },
+    { "System2Request.GetUnixSocketPath", NativeRequest_GetUnixSocketPath },
+    { "System2Request.SetTuningProfile", NativeRequest_SetTuningProfile },
     { "System2Request.Timeout.get", NativeRequest_GetTimeout },
     { "System2Request.Timeout.set", NativeRequest_SetTimeout },
+    { "System2Request.Deadline.get", NativeRequest_GetDeadline },
+    { "System2Request.Deadline.set", NativeRequest_SetDeadline },
+    { "System2Request.Error.get", NativeRequest_GetError },
     { "System2Request.Any.get", NativeRequest_GetAnyData },
     { "System2Request.Any.set", NativeRequest_SetAnyData },
     { "System2Request.MaxSendSpeed.set", NativeRequest_SetMaxSendSpeed },
     { "System2Request.MaxRecvSpeed.set", NativeRequest_SetMaxRecvSpeed },
+    { "System2Request.MaxMemoryContent.get", NativeRequest_GetMaxMemoryContent },
+    { "System2Request.MaxMemoryContent.set", NativeRequest_SetMaxMemoryContent },
+    { "System2Request.WriteBehind.get", NativeRequest_GetWriteBehind },
+    { "System2Request.WriteBehind.set", NativeRequest_SetWriteBehind },
 
     { "System2HTTPRequest.System2HTTPRequest", NativeHTTPRequest_HTTPRequest },
     { "System2HTTPRequest.SetProgressCallback", NativeHTTPRequest_SetProgressCallback },
     { "System2HTTPRequest.SetData", NativeHTTPRequest_SetData },
     { "System2HTTPRequest.GetData", NativeHTTPRequest_GetData },
+    { "System2HTTPRequest.SetBinaryData", NativeHTTPRequest_SetBinaryData },
+    { "System2HTTPRequest.GetBinaryData", NativeHTTPRequest_GetBinaryData },
+    { "System2HTTPRequest.DataLength.get", NativeHTTPRequest_GetDataLength },
+    { "System2HTTPRequest.BodyEncoding.get", NativeHTTPRequest_GetBodyEncoding },
+    { "System2HTTPRequest.BodyEncoding.set", NativeHTTPRequest_SetBodyEncoding },
     { "System2HTTPRequest.SetHeader", NativeHTTPRequest_SetHeader },
     { "System2HTTPRequest.GetHeader", NativeHTTPRequest_GetHeader },
     { "System2HTTPRequest.GetHeaderName", NativeHTTPRequest_GetHeaderName },
@@ -154,9 +299,17 @@ const sp_nativeinfo_t system2_natives[] =
     { "System2HTTPRequest.PATCH", NativeHTTPRequest_PATCH },
     { "System2HTTPRequest.DELETE", NativeHTTPRequest_DELETE },
     { "System2HTTPRequest.HEAD", NativeHTTPRequest_HEAD },
+    { "System2HTTPRequest.Enqueue", NativeHTTPRequest_Enqueue },
     { "System2HTTPRequest.FollowRedirects.get", NativeHTTPRequest_GetFollowRedirects },
     { "System2HTTPRequest.FollowRedirects.set", NativeHTTPRequest_SetFollowRedirects },
+    { "System2HTTPRequest.HostLimit.get", NativeHTTPRequest_GetHostLimit },
+    { "System2HTTPRequest.HostLimit.set", NativeHTTPRequest_SetHostLimit },
     { "System2HTTPRequest.Headers.get", NativeHTTPRequest_GetHeaders },
+    { "System2HTTPRequest.SetEventCallback", NativeHTTPRequest_SetEventCallback },
+    { "System2HTTPRequest.EventBacklog.get", NativeHTTPRequest_GetEventBacklog },
+    { "System2HTTPRequest.EventBacklog.set", NativeHTTPRequest_SetEventBacklog },
+    { "System2HTTPRequest.EventReconnects.get", NativeHTTPRequest_GetEventReconnects },
+    { "System2HTTPRequest.EventReconnects.set", NativeHTTPRequest_SetEventReconnects },
 
     { "System2FTPRequest.System2FTPRequest", NativeFTPRequest_FTPRequest },
     { "System2FTPRequest.SetProgressCallback", NativeFTPRequest_SetProgressCallback },
@@ -173,6 +326,7 @@ const sp_nativeinfo_t system2_natives[] =
 
     { "System2Response.GetLastURL", NativeResponse_GetLastURL },
     { "System2Response.GetContent", NativeResponse_GetContent },
+    { "System2Response.GetBinaryContent", NativeResponse_GetBinaryContent },
     { "System2Response.ContentLength.get", NativeResponse_GetContentLength },
     { "System2Response.StatusCode.get", NativeResponse_GetStatusCode },
     { "System2Response.TotalTime.get", NativeResponse_GetTotalTime },
@@ -187,20 +341,122 @@ const sp_nativeinfo_t system2_natives[] =
     { "System2HTTPResponse.HTTPVersion.get", NativeHTTPResponse_GetHTTPVersion },
     { "System2HTTPResponse.Headers.get", NativeHTTPResponse_GetHeaders },
 
+    { "System2EventBatch.Count.get", NativeEventBatch_GetCount },
+    { "System2EventBatch.Dropped.get", NativeEventBatch_GetDropped },
+    { "System2EventBatch.GetData", NativeEventBatch_GetData },
+    { "System2EventBatch.GetType", NativeEventBatch_GetType },
+    { "System2EventBatch.GetId", NativeEventBatch_GetId },
+
+    { "System2TuningProfile.System2TuningProfile", NativeTuningProfile_TuningProfile },
+    { "System2TuningProfile.NoDelay.get", NativeTuningProfile_GetNoDelay },
+    { "System2TuningProfile.NoDelay.set", NativeTuningProfile_SetNoDelay },
+    { "System2TuningProfile.KeepAliveIdle.get", NativeTuningProfile_GetKeepAliveIdle },
+    { "System2TuningProfile.KeepAliveIdle.set", NativeTuningProfile_SetKeepAliveIdle },
+    { "System2TuningProfile.KeepAliveInterval.get", NativeTuningProfile_GetKeepAliveInterval },
+    { "System2TuningProfile.KeepAliveInterval.set", NativeTuningProfile_SetKeepAliveInterval },
+    { "System2TuningProfile.FastOpen.get", NativeTuningProfile_GetFastOpen },
+    { "System2TuningProfile.FastOpen.set", NativeTuningProfile_SetFastOpen },
+    { "System2TuningProfile.ExpectContinue.get", NativeTuningProfile_GetExpectContinue },
+    { "System2TuningProfile.ExpectContinue.set", NativeTuningProfile_SetExpectContinue },
+    { "System2TuningProfile.LowSpeedLimit.get", NativeTuningProfile_GetLowSpeedLimit },
+    { "System2TuningProfile.LowSpeedLimit.set", NativeTuningProfile_SetLowSpeedLimit },
+    { "System2TuningProfile.LowSpeedTime.get", NativeTuningProfile_GetLowSpeedTime },
+    { "System2TuningProfile.LowSpeedTime.set", NativeTuningProfile_SetLowSpeedTime },
+    { "System2TuningProfile.BufferSize.get", NativeTuningProfile_GetBufferSize },
+    { "System2TuningProfile.BufferSize.set", NativeTuningProfile_SetBufferSize },
+
+    { "System2PreparedRequest.System2PreparedRequest", NativePreparedRequest_PreparedRequest },
+    { "System2PreparedRequest.Send", NativePreparedRequest_Send },
+    { "System2PreparedRequest.SendBinary", NativePreparedRequest_SendBinary },
+
+    { "System2BatchChannel.System2BatchChannel", NativeBatchChannel_BatchChannel },
+    { "System2BatchChannel.Add", NativeBatchChannel_Add },
+    { "System2BatchChannel.Flush", NativeBatchChannel_Flush },
+    { "System2BatchChannel.MaxRecords.get", NativeBatchChannel_GetMaxRecords },
+    { "System2BatchChannel.MaxRecords.set", NativeBatchChannel_SetMaxRecords },
+    { "System2BatchChannel.MaxBytes.get", NativeBatchChannel_GetMaxBytes },
+    { "System2BatchChannel.MaxBytes.set", NativeBatchChannel_SetMaxBytes },
+    { "System2BatchChannel.MaxDelay.get", NativeBatchChannel_GetMaxDelay },
+    { "System2BatchChannel.MaxDelay.set", NativeBatchChannel_SetMaxDelay },
+    { "System2BatchChannel.Pending.get", NativeBatchChannel_GetPending },
+
+    { "System2SequenceChannel.System2SequenceChannel", NativeSequenceChannel_SequenceChannel },
+    { "System2SequenceChannel.Send", NativeSequenceChannel_Send },
+    { "System2SequenceChannel.MaxInFlight.get", NativeSequenceChannel_GetMaxInFlight },
+    { "System2SequenceChannel.MaxInFlight.set", NativeSequenceChannel_SetMaxInFlight },
+    { "System2SequenceChannel.MaxRetries.get", NativeSequenceChannel_GetMaxRetries },
+    { "System2SequenceChannel.MaxRetries.set", NativeSequenceChannel_SetMaxRetries },
+    { "System2SequenceChannel.Pending.get", NativeSequenceChannel_GetPending },
+
+    { "System2PackWriter.System2PackWriter", NativePackWriter_PackWriter },
+    { "System2PackWriter.WriteNil", NativePackWriter_WriteNil },
+    { "System2PackWriter.WriteBool", NativePackWriter_WriteBool },
+    { "System2PackWriter.WriteInt", NativePackWriter_WriteInt },
+    { "System2PackWriter.WriteFloat", NativePackWriter_WriteFloat },
+    { "System2PackWriter.WriteString", NativePackWriter_WriteString },
+    { "System2PackWriter.WriteBinary", NativePackWriter_WriteBinary },
+    { "System2PackWriter.WriteArray", NativePackWriter_WriteArray },
+    { "System2PackWriter.WriteMap", NativePackWriter_WriteMap },
+    { "System2PackWriter.Length.get", NativePackWriter_GetLength },
+    { "System2PackWriter.AttachTo", NativePackWriter_AttachTo },
+    { "System2PackWriter.SendPrepared", NativePackWriter_SendPrepared },
+
+    { "System2PackReader.System2PackReader", NativePackReader_PackReader },
+    { "System2PackReader.Type.get", NativePackReader_GetType },
+    { "System2PackReader.ReadBool", NativePackReader_ReadBool },
+    { "System2PackReader.ReadInt", NativePackReader_ReadInt },
+    { "System2PackReader.ReadFloat", NativePackReader_ReadFloat },
+    { "System2PackReader.ReadString", NativePackReader_ReadString },
+    { "System2PackReader.ReadBinary", NativePackReader_ReadBinary },
+    { "System2PackReader.ReadArray", NativePackReader_ReadArray },
+    { "System2PackReader.ReadMap", NativePackReader_ReadMap },
+    { "System2PackReader.Skip", NativePackReader_Skip },
+    { "System2PackReader.FindKey", NativePackReader_FindKey },
+    { "System2PackReader.Position.get", NativePackReader_GetPosition },
+    { "System2PackReader.Position.set", NativePackReader_SetPosition },
+    { "System2PackReader.Length.get", NativePackReader_GetLength },
+
     { "System2_URLEncode", NativeURLEncode },
     { "System2_URLDecode", NativeURLDecode },
+    { "System2_Base64Encode", NativeBase64Encode },
+    { "System2_Base64Decode", NativeBase64Decode },
+    { "System2_HexEncode", NativeHexEncode },
+    { "System2_HexDecode", NativeHexDecode },
 
     { "System2_CopyFile", NativeCopyFile },
+    { "System2_SetThreadPolicy", NativeSetThreadPolicy },
+    { "System2_SetSpillDirectory", NativeSetSpillDirectory },
 
     { "System2_Check7ZIP", NativeCheck7ZIP },
     { "System2_Compress", NativeCompress },
     { "System2_Extract", NativeExtract },
+    { "System2_GzipFile", NativeGzipFile },
+    { "System2_BuildFastDL", NativeBuildFastDL },
 
     { "System2_ExecuteThreaded", NativeExecuteThreaded },
     { "System2_ExecuteFormattedThreaded", NativeExecuteFormattedThreaded },
+    { "System2_ExecuteThreadedWithInput", NativeExecuteThreadedWithInput },
+    { "System2_ExecuteThreadedWithInputFile", NativeExecuteThreadedWithInputFile },
     { "System2ExecuteOutput.GetOutput", NativeExecuteOutput_GetOutput },
     { "System2ExecuteOutput.Length.get", NativeExecuteOutput_GetLength },
     { "System2ExecuteOutput.ExitStatus.get", NativeExecuteOutput_GetExitStatus },
+    { "System2ExecuteOutput.Status.get", NativeExecuteOutput_GetStatus },
+
+    { "System2ExecuteOptions.System2ExecuteOptions", NativeExecuteOptions_ExecuteOptions },
+    { "System2ExecuteOptions.Timeout.get", NativeExecuteOptions_GetTimeout },
+    { "System2ExecuteOptions.Timeout.set", NativeExecuteOptions_SetTimeout },
+    { "System2ExecuteOptions.KillDelay.get", NativeExecuteOptions_GetKillDelay },
+    { "System2ExecuteOptions.KillDelay.set", NativeExecuteOptions_SetKillDelay },
+    { "System2ExecuteOptions.CPULimit.get", NativeExecuteOptions_GetCPULimit },
+    { "System2ExecuteOptions.CPULimit.set", NativeExecuteOptions_SetCPULimit },
+    { "System2ExecuteOptions.MemoryLimit.get", NativeExecuteOptions_GetMemoryLimit },
+    { "System2ExecuteOptions.MemoryLimit.set", NativeExecuteOptions_SetMemoryLimit },
+    { "System2ExecuteOptions.Nice.get", NativeExecuteOptions_GetNice },
+    { "System2ExecuteOptions.Nice.set", NativeExecuteOptions_SetNice },
+    { "System2ExecuteOptions.IOClass.get", NativeExecuteOptions_GetIOClass },
+    { "System2ExecuteOptions.IOClass.set", NativeExecuteOptions_SetIOClass },
+    { "System2ExecuteOptions.IOLevel.get", NativeExecuteOptions_GetIOLevel },
+    { "System2ExecuteOptions.IOLevel.set", NativeExecuteOptions_SetIOLevel },
 
     { "System2_Execute", NativeExecute },
     { "System2_ExecuteFormatted", NativeExecuteFormatted },
@@ -0,0 +1,45 @@
+/**
+ * -----------------------------------------------------
+ * File        PackFormat.h
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#ifndef _SYSTEM2_PACK_FORMAT_H_
+#define _SYSTEM2_PACK_FORMAT_H_
+
+enum PackFormat {
+    PACK_MSGPACK,
+    PACK_CBOR
+};
+
+enum PackType {
+    PACK_TYPE_NONE,
+    PACK_TYPE_NIL,
+    PACK_TYPE_BOOL,
+    PACK_TYPE_INT,
+    PACK_TYPE_FLOAT,
+    PACK_TYPE_STRING,
+    PACK_TYPE_BINARY,
+    PACK_TYPE_ARRAY,
+    PACK_TYPE_MAP
+};
+
+#endif
\ No newline at end of file
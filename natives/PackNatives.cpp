@@ -0,0 +1,408 @@
+/**
+ * -----------------------------------------------------
+ * File        PackNatives.cpp
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "Natives.h"
+#include "PackWriter.h"
+#include "PackReader.h"
+#include "PackWriterHandler.h"
+#include "PackReaderHandler.h"
+#include "HTTPRequest.h"
+#include "HTTPRequestThread.h"
+#include "PreparedRequest.h"
+#include "ResponseCallback.h"
+
+static const char* packTypeNames[] = { "none", "nil", "bool", "int", "float", "string", "binary", "array", "map" };
+
+// Reads the next value of the reader and throws an error if it has not the expected type
+static bool ReadPackValue(PackReader* reader, IPluginContext* pContext, PackType expected, PackValue_t& value, std::string* payload = nullptr) {
+    PackType type = reader->GetType();
+    if (type != expected && !(expected == PACK_TYPE_FLOAT && type == PACK_TYPE_INT)) {
+        pContext->ThrowNativeError("Next value is %s, expected %s", packTypeNames[type], packTypeNames[expected]);
+        return false;
+    }
+
+    return reader->Read(value, payload);
+}
+
+cell_t NativePackWriter_PackWriter(IPluginContext* pContext, const cell_t* params) {
+    if (params[1] < PACK_MSGPACK || params[1] > PACK_CBOR) {
+        pContext->ThrowNativeError("Invalid pack format %d", params[1]);
+        return BAD_HANDLE;
+    }
+
+    PackWriter* writer = new PackWriter(static_cast<PackFormat>(params[1]));
+
+    Handle_t hndl = packWriterHandler.CreateHandle(writer, pContext->GetIdentity());
+    if (hndl == BAD_HANDLE) {
+        delete writer;
+        pContext->ThrowNativeError("Couldn't create pack writer handle");
+    }
+
+    return hndl;
+}
+
+cell_t NativePackWriter_WriteNil(IPluginContext* pContext, const cell_t* params) {
+    PackWriter* writer = PackWriter::ConvertPackWriter(params[1], pContext);
+    if (!writer) {
+        return 0;
+    }
+
+    writer->WriteNil();
+    return 1;
+}
+
+cell_t NativePackWriter_WriteBool(IPluginContext* pContext, const cell_t* params) {
+    PackWriter* writer = PackWriter::ConvertPackWriter(params[1], pContext);
+    if (!writer) {
+        return 0;
+    }
+
+    writer->WriteBool(params[2] != 0);
+    return 1;
+}
+
+cell_t NativePackWriter_WriteInt(IPluginContext* pContext, const cell_t* params) {
+    PackWriter* writer = PackWriter::ConvertPackWriter(params[1], pContext);
+    if (!writer) {
+        return 0;
+    }
+
+    writer->WriteInt(params[2]);
+    return 1;
+}
+
+cell_t NativePackWriter_WriteFloat(IPluginContext* pContext, const cell_t* params) {
+    PackWriter* writer = PackWriter::ConvertPackWriter(params[1], pContext);
+    if (!writer) {
+        return 0;
+    }
+
+    writer->WriteFloat(sp_ctof(params[2]));
+    return 1;
+}
+
+cell_t NativePackWriter_WriteString(IPluginContext* pContext, const cell_t* params) {
+    PackWriter* writer = PackWriter::ConvertPackWriter(params[1], pContext);
+    if (!writer) {
+        return 0;
+    }
+
+    char* value;
+    pContext->LocalToString(params[2], &value);
+
+    writer->WriteString(value, strlen(value));
+    return 1;
+}
+
+cell_t NativePackWriter_WriteBinary(IPluginContext* pContext, const cell_t* params) {
+    PackWriter* writer = PackWriter::ConvertPackWriter(params[1], pContext);
+    if (!writer) {
+        return 0;
+    }
+
+    if (params[3] < 0) {
+        pContext->ThrowNativeError("Invalid data length %d", params[3]);
+        return 0;
+    }
+
+    cell_t* data;
+    pContext->LocalToPhysAddr(params[2], &data);
+
+    writer->WriteBinary(reinterpret_cast<const char*>(data), params[3]);
+    return 1;
+}
+
+cell_t NativePackWriter_WriteArray(IPluginContext* pContext, const cell_t* params) {
+    PackWriter* writer = PackWriter::ConvertPackWriter(params[1], pContext);
+    if (!writer) {
+        return 0;
+    }
+
+    if (params[2] < 0) {
+        pContext->ThrowNativeError("Invalid array size %d", params[2]);
+        return 0;
+    }
+
+    writer->WriteArray(params[2]);
+    return 1;
+}
+
+cell_t NativePackWriter_WriteMap(IPluginContext* pContext, const cell_t* params) {
+    PackWriter* writer = PackWriter::ConvertPackWriter(params[1], pContext);
+    if (!writer) {
+        return 0;
+    }
+
+    if (params[2] < 0) {
+        pContext->ThrowNativeError("Invalid map size %d", params[2]);
+        return 0;
+    }
+
+    writer->WriteMap(params[2]);
+    return 1;
+}
+
+cell_t NativePackWriter_GetLength(IPluginContext* pContext, const cell_t* params) {
+    PackWriter* writer = PackWriter::ConvertPackWriter(params[1], pContext);
+    if (!writer) {
+        return 0;
+    }
+
+    return writer->GetData().size();
+}
+
+cell_t NativePackWriter_AttachTo(IPluginContext* pContext, const cell_t* params) {
+    PackWriter* writer = PackWriter::ConvertPackWriter(params[1], pContext);
+    if (!writer) {
+        return 0;
+    }
+
+    HTTPRequest* request = Request::ConvertRequest<HTTPRequest>(params[2], pContext);
+    if (!request) {
+        return 0;
+    }
+
+    request->bodyData = writer->GetData();
+
+    // Announce the format if the plugin didn't set a content type
+    for (auto it = request->headers.begin(); it != request->headers.end(); ++it) {
+        if (HTTPRequestThread::EqualsIgnoreCase(it->first.c_str(), "Content-Type")) {
+            return 1;
+        }
+    }
+
+    request->headers["Content-Type"] = writer->GetContentType();
+    return 1;
+}
+
+cell_t NativePackWriter_SendPrepared(IPluginContext* pContext, const cell_t* params) {
+    PackWriter* writer = PackWriter::ConvertPackWriter(params[1], pContext);
+    if (!writer) {
+        return 0;
+    }
+
+    PreparedRequest* prepared = PreparedRequest::ConvertPreparedRequest(params[2], pContext);
+    if (!prepared) {
+        return 0;
+    }
+
+    prepared->Send(writer->GetData());
+    return 1;
+}
+
+cell_t NativePackReader_PackReader(IPluginContext* pContext, const cell_t* params) {
+    ResponseCallback* response = ResponseCallback::ConvertResponse<ResponseCallback>(params[1], pContext);
+    if (!response) {
+        return BAD_HANDLE;
+    }
+
+    if (params[2] < PACK_MSGPACK || params[2] > PACK_CBOR) {
+        pContext->ThrowNativeError("Invalid pack format %d", params[2]);
+        return BAD_HANDLE;
+    }
+
+    // The reader needs its own copy, as the response is destroyed after the callback
+    std::string content;
+    if (response->content) {
+        content = response->content->Read(0, static_cast<size_t>(response->content->Length()));
+    }
+
+    PackReader* reader = new PackReader(static_cast<PackFormat>(params[2]), std::move(content));
+
+    Handle_t hndl = packReaderHandler.CreateHandle(reader, pContext->GetIdentity());
+    if (hndl == BAD_HANDLE) {
+        delete reader;
+        pContext->ThrowNativeError("Couldn't create pack reader handle");
+    }
+
+    return hndl;
+}
+
+cell_t NativePackReader_GetType(IPluginContext* pContext, const cell_t* params) {
+    PackReader* reader = PackReader::ConvertPackReader(params[1], pContext);
+    if (!reader) {
+        return PACK_TYPE_NONE;
+    }
+
+    return reader->GetType();
+}
+
+cell_t NativePackReader_ReadBool(IPluginContext* pContext, const cell_t* params) {
+    PackReader* reader = PackReader::ConvertPackReader(params[1], pContext);
+    if (!reader) {
+        return 0;
+    }
+
+    PackValue_t value;
+    if (!ReadPackValue(reader, pContext, PACK_TYPE_BOOL, value)) {
+        return 0;
+    }
+
+    return value.boolValue;
+}
+
+cell_t NativePackReader_ReadInt(IPluginContext* pContext, const cell_t* params) {
+    PackReader* reader = PackReader::ConvertPackReader(params[1], pContext);
+    if (!reader) {
+        return 0;
+    }
+
+    PackValue_t value;
+    if (!ReadPackValue(reader, pContext, PACK_TYPE_INT, value)) {
+        return 0;
+    }
+
+    return static_cast<cell_t>(value.intValue);
+}
+
+cell_t NativePackReader_ReadFloat(IPluginContext* pContext, const cell_t* params) {
+    PackReader* reader = PackReader::ConvertPackReader(params[1], pContext);
+    if (!reader) {
+        return sp_ftoc(0.0f);
+    }
+
+    PackValue_t value;
+    if (!ReadPackValue(reader, pContext, PACK_TYPE_FLOAT, value)) {
+        return sp_ftoc(0.0f);
+    }
+
+    float number = static_cast<float>(value.type == PACK_TYPE_INT ? value.intValue : value.floatValue);
+    return sp_ftoc(number);
+}
+
+cell_t NativePackReader_ReadString(IPluginContext* pContext, const cell_t* params) {
+    PackReader* reader = PackReader::ConvertPackReader(params[1], pContext);
+    if (!reader) {
+        return 0;
+    }
+
+    PackValue_t value;
+    std::string payload;
+    if (!ReadPackValue(reader, pContext, PACK_TYPE_STRING, value, &payload)) {
+        return 0;
+    }
+
+    size_t bytes;
+    pContext->StringToLocalUTF8(params[2], params[3], payload.c_str(), &bytes);
+
+    return bytes;
+}
+
+cell_t NativePackReader_ReadBinary(IPluginContext* pContext, const cell_t* params) {
+    PackReader* reader = PackReader::ConvertPackReader(params[1], pContext);
+    if (!reader) {
+        return 0;
+    }
+
+    PackValue_t value;
+    std::string payload;
+    if (!ReadPackValue(reader, pContext, PACK_TYPE_BINARY, value, &payload)) {
+        return 0;
+    }
+
+    cell_t* data;
+    pContext->LocalToPhysAddr(params[2], &data);
+
+    size_t bytes = params[3] > 0 ? std::min(payload.size(), static_cast<size_t>(params[3])) : 0;
+    memcpy(reinterpret_cast<char*>(data), payload.data(), bytes);
+
+    return bytes;
+}
+
+cell_t NativePackReader_ReadArray(IPluginContext* pContext, const cell_t* params) {
+    PackReader* reader = PackReader::ConvertPackReader(params[1], pContext);
+    if (!reader) {
+        return 0;
+    }
+
+    PackValue_t value;
+    if (!ReadPackValue(reader, pContext, PACK_TYPE_ARRAY, value)) {
+        return 0;
+    }
+
+    return static_cast<cell_t>(value.length);
+}
+
+cell_t NativePackReader_ReadMap(IPluginContext* pContext, const cell_t* params) {
+    PackReader* reader = PackReader::ConvertPackReader(params[1], pContext);
+    if (!reader) {
+        return 0;
+    }
+
+    PackValue_t value;
+    if (!ReadPackValue(reader, pContext, PACK_TYPE_MAP, value)) {
+        return 0;
+    }
+
+    return static_cast<cell_t>(value.length);
+}
+
+cell_t NativePackReader_Skip(IPluginContext* pContext, const cell_t* params) {
+    PackReader* reader = PackReader::ConvertPackReader(params[1], pContext);
+    if (!reader) {
+        return 0;
+    }
+
+    return reader->Skip();
+}
+
+cell_t NativePackReader_FindKey(IPluginContext* pContext, const cell_t* params) {
+    PackReader* reader = PackReader::ConvertPackReader(params[1], pContext);
+    if (!reader) {
+        return 0;
+    }
+
+    char* key;
+    pContext->LocalToString(params[2], &key);
+
+    return reader->FindKey(key, params[3] < 0 ? 0 : params[3]);
+}
+
+cell_t NativePackReader_GetPosition(IPluginContext* pContext, const cell_t* params) {
+    PackReader* reader = PackReader::ConvertPackReader(params[1], pContext);
+    if (!reader) {
+        return 0;
+    }
+
+    return reader->GetPosition();
+}
+
+cell_t NativePackReader_SetPosition(IPluginContext* pContext, const cell_t* params) {
+    PackReader* reader = PackReader::ConvertPackReader(params[1], pContext);
+    if (!reader) {
+        return 0;
+    }
+
+    reader->SetPosition(params[2] < 0 ? 0 : params[2]);
+    return 1;
+}
+
+cell_t NativePackReader_GetLength(IPluginContext* pContext, const cell_t* params) {
+    PackReader* reader = PackReader::ConvertPackReader(params[1], pContext);
+    if (!reader) {
+        return 0;
+    }
+
+    return reader->GetLength();
+}
\ No newline at end of file
@@ -0,0 +1,414 @@
+/**
+ * -----------------------------------------------------
+ * File        PackReader.cpp
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "PackReader.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+PackReader::PackReader(PackFormat format, std::string data) : format(format), data(std::move(data)), position(0) {};
+
+PackType PackReader::GetType() const {
+    PackValue_t value;
+    if (!this->Peek(this->position, value)) {
+        return PACK_TYPE_NONE;
+    }
+
+    return value.type;
+}
+
+bool PackReader::Read(PackValue_t& value, std::string* payload) {
+    if (!this->Peek(this->position, value)) {
+        return false;
+    }
+
+    this->position += value.headerLength;
+
+    // Strings and binaries are followed by their bytes
+    if (value.type == PACK_TYPE_STRING || value.type == PACK_TYPE_BINARY) {
+        if (payload) {
+            payload->assign(this->data, this->position, value.length);
+        }
+
+        this->position += value.length;
+    }
+
+    return true;
+}
+
+bool PackReader::Skip() {
+    size_t at = this->position;
+    uint64_t pending = 1;
+
+    while (pending > 0) {
+        PackValue_t value;
+        if (!this->Peek(at, value)) {
+            return false;
+        }
+
+        at += value.headerLength;
+        pending--;
+
+        if (value.type == PACK_TYPE_STRING || value.type == PACK_TYPE_BINARY) {
+            at += value.length;
+        } else if (value.type == PACK_TYPE_ARRAY) {
+            pending += value.length;
+        } else if (value.type == PACK_TYPE_MAP) {
+            pending += value.length * 2;
+        }
+    }
+
+    this->position = at;
+    return true;
+}
+
+bool PackReader::FindKey(const char* key, uint64_t count) {
+    size_t keyLength = strlen(key);
+
+    for (uint64_t i = 0; i < count; i++) {
+        PackValue_t value;
+        if (!this->Peek(this->position, value)) {
+            return false;
+        }
+
+        if (value.type == PACK_TYPE_STRING && value.length == keyLength &&
+            this->data.compare(this->position + value.headerLength, keyLength, key) == 0) {
+            // Stop at the value of the key
+            this->position += value.headerLength + value.length;
+            return true;
+        }
+
+        // Skip the key and the value
+        if (!this->Skip() || !this->Skip()) {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+size_t PackReader::GetPosition() const {
+    return this->position;
+}
+
+void PackReader::SetPosition(size_t position) {
+    this->position = std::min(position, this->data.size());
+}
+
+size_t PackReader::GetLength() const {
+    return this->data.size();
+}
+
+bool PackReader::Peek(size_t at, PackValue_t& value) const {
+    if (at >= this->data.size()) {
+        return false;
+    }
+
+    value = { PACK_TYPE_NONE, 1, 0, 0, 0.0, false };
+    if (!(this->format == PACK_CBOR ? this->PeekCBOR(at, value) : this->PeekMsgPack(at, value))) {
+        return false;
+    }
+
+    // Every element needs at least one byte, so larger lengths can only be invalid data
+    size_t remaining = this->data.size() - at - value.headerLength;
+    if (value.type == PACK_TYPE_STRING || value.type == PACK_TYPE_BINARY || value.type == PACK_TYPE_ARRAY) {
+        return value.length <= remaining;
+    }
+
+    if (value.type == PACK_TYPE_MAP) {
+        return value.length <= remaining / 2;
+    }
+
+    return true;
+}
+
+bool PackReader::PeekMsgPack(size_t at, PackValue_t& value) const {
+    uint8_t byte = static_cast<uint8_t>(this->data[at]);
+    uint64_t argument = 0;
+
+    if (byte <= 0x7f || byte >= 0xe0) {
+        // Positive and negative fixint
+        value.type = PACK_TYPE_INT;
+        value.intValue = static_cast<int8_t>(byte);
+        return true;
+    }
+
+    if (byte <= 0x8f) {
+        value.type = PACK_TYPE_MAP;
+        value.length = byte & 0x0f;
+        return true;
+    }
+
+    if (byte <= 0x9f) {
+        value.type = PACK_TYPE_ARRAY;
+        value.length = byte & 0x0f;
+        return true;
+    }
+
+    if (byte <= 0xbf) {
+        value.type = PACK_TYPE_STRING;
+        value.length = byte & 0x1f;
+        return true;
+    }
+
+    switch (byte) {
+        case 0xc0:
+            value.type = PACK_TYPE_NIL;
+            return true;
+        case 0xc2:
+        case 0xc3:
+            value.type = PACK_TYPE_BOOL;
+            value.boolValue = byte == 0xc3;
+            return true;
+        case 0xc4:
+        case 0xc5:
+        case 0xc6: {
+            int bytes = 1 << (byte - 0xc4);
+            value.type = PACK_TYPE_BINARY;
+            value.headerLength += bytes;
+            return this->ReadBigEndian(at + 1, bytes, value.length);
+        }
+        case 0xca: {
+            if (!this->ReadBigEndian(at + 1, 4, argument)) {
+                return false;
+            }
+
+            uint32_t bits = static_cast<uint32_t>(argument);
+            float number;
+            memcpy(&number, &bits, sizeof(number));
+
+            value.type = PACK_TYPE_FLOAT;
+            value.floatValue = number;
+            value.headerLength += 4;
+            return true;
+        }
+        case 0xcb: {
+            if (!this->ReadBigEndian(at + 1, 8, argument)) {
+                return false;
+            }
+
+            value.type = PACK_TYPE_FLOAT;
+            memcpy(&value.floatValue, &argument, sizeof(value.floatValue));
+            value.headerLength += 8;
+            return true;
+        }
+        case 0xcc:
+        case 0xcd:
+        case 0xce:
+        case 0xcf: {
+            int bytes = 1 << (byte - 0xcc);
+            if (!this->ReadBigEndian(at + 1, bytes, argument)) {
+                return false;
+            }
+
+            value.type = PACK_TYPE_INT;
+            value.intValue = static_cast<int64_t>(argument);
+            value.headerLength += bytes;
+            return true;
+        }
+        case 0xd0:
+        case 0xd1:
+        case 0xd2:
+        case 0xd3: {
+            int bytes = 1 << (byte - 0xd0);
+            if (!this->ReadBigEndian(at + 1, bytes, argument)) {
+                return false;
+            }
+
+            // Sign extend the value
+            int shift = 64 - bytes * 8;
+            value.type = PACK_TYPE_INT;
+            value.intValue = static_cast<int64_t>(argument << shift) >> shift;
+            value.headerLength += bytes;
+            return true;
+        }
+        case 0xd9:
+        case 0xda:
+        case 0xdb: {
+            int bytes = 1 << (byte - 0xd9);
+            value.type = PACK_TYPE_STRING;
+            value.headerLength += bytes;
+            return this->ReadBigEndian(at + 1, bytes, value.length);
+        }
+        case 0xdc:
+        case 0xdd: {
+            int bytes = byte == 0xdc ? 2 : 4;
+            value.type = PACK_TYPE_ARRAY;
+            value.headerLength += bytes;
+            return this->ReadBigEndian(at + 1, bytes, value.length);
+        }
+        case 0xde:
+        case 0xdf: {
+            int bytes = byte == 0xde ? 2 : 4;
+            value.type = PACK_TYPE_MAP;
+            value.headerLength += bytes;
+            return this->ReadBigEndian(at + 1, bytes, value.length);
+        }
+        default:
+            // Extension types are not supported
+            return false;
+    }
+}
+
+bool PackReader::PeekCBOR(size_t at, PackValue_t& value) const {
+    uint8_t major;
+    uint8_t info;
+    uint64_t argument;
+
+    // Tags only describe the following data item, so they are skipped in a loop as any number of them may follow
+    size_t tagLength = 0;
+    while (true) {
+        if (at + tagLength >= this->data.size()) {
+            return false;
+        }
+
+        uint8_t byte = static_cast<uint8_t>(this->data[at + tagLength]);
+        major = byte >> 5;
+        info = byte & 0x1f;
+
+        // Get the argument of the data item, indefinite lengths are not supported
+        argument = info;
+        value.headerLength = 1;
+        if (info >= 24) {
+            if (info > 27) {
+                return false;
+            }
+
+            int bytes = 1 << (info - 24);
+            if (!this->ReadBigEndian(at + tagLength + 1, bytes, argument)) {
+                return false;
+            }
+
+            value.headerLength += bytes;
+        }
+
+        if (major != 6) {
+            break;
+        }
+
+        tagLength += value.headerLength;
+    }
+
+    value.headerLength += tagLength;
+
+    switch (major) {
+        case 0:
+            value.type = PACK_TYPE_INT;
+            value.intValue = static_cast<int64_t>(argument);
+            return true;
+        case 1:
+            value.type = PACK_TYPE_INT;
+            value.intValue = -1 - static_cast<int64_t>(argument);
+            return true;
+        case 2:
+            value.type = PACK_TYPE_BINARY;
+            value.length = argument;
+            return true;
+        case 3:
+            value.type = PACK_TYPE_STRING;
+            value.length = argument;
+            return true;
+        case 4:
+            value.type = PACK_TYPE_ARRAY;
+            value.length = argument;
+            return true;
+        case 5:
+            value.type = PACK_TYPE_MAP;
+            value.length = argument;
+            return true;
+        default:
+            break;
+    }
+
+    // Simple values and floats
+    switch (info) {
+        case 20:
+        case 21:
+            value.type = PACK_TYPE_BOOL;
+            value.boolValue = info == 21;
+            return true;
+        case 22:
+        case 23:
+            value.type = PACK_TYPE_NIL;
+            return true;
+        case 25: {
+            // Half precision float
+            int exponent = (argument >> 10) & 0x1f;
+            int mantissa = argument & 0x3ff;
+            double number;
+            if (exponent == 0) {
+                number = ldexp(mantissa, -24);
+            } else if (exponent != 31) {
+                number = ldexp(mantissa + 1024, exponent - 25);
+            } else {
+                number = mantissa == 0 ? INFINITY : NAN;
+            }
+
+            value.type = PACK_TYPE_FLOAT;
+            value.floatValue = (argument & 0x8000) ? -number : number;
+            return true;
+        }
+        case 26: {
+            uint32_t bits = static_cast<uint32_t>(argument);
+            float number;
+            memcpy(&number, &bits, sizeof(number));
+
+            value.type = PACK_TYPE_FLOAT;
+            value.floatValue = number;
+            return true;
+        }
+        case 27:
+            value.type = PACK_TYPE_FLOAT;
+            memcpy(&value.floatValue, &argument, sizeof(value.floatValue));
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool PackReader::ReadBigEndian(size_t at, int bytes, uint64_t& value) const {
+    if (at + bytes > this->data.size()) {
+        return false;
+    }
+
+    value = 0;
+    for (int i = 0; i < bytes; i++) {
+        value = (value << 8) | static_cast<uint8_t>(this->data[at + i]);
+    }
+
+    return true;
+}
+
+PackReader* PackReader::ConvertPackReader(Handle_t hndl, IPluginContext* pContext) {
+    HandleError err;
+
+    PackReader* reader = nullptr;
+    if ((err = packReaderHandler.ReadHandle(hndl, pContext->GetIdentity(), &reader)) != HandleError_None) {
+        pContext->ThrowNativeError("Invalid pack reader handle %x (error %d)", hndl, err);
+        return nullptr;
+    }
+
+    return reader;
+}
\ No newline at end of file
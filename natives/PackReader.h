@@ -0,0 +1,82 @@
+/**
+ * -----------------------------------------------------
+ * File        PackReader.h
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#ifndef _SYSTEM2_PACK_READER_H_
+#define _SYSTEM2_PACK_READER_H_
+
+#include "extension.h"
+#include "PackFormat.h"
+#include "PackReaderHandler.h"
+
+// Decoded header of a single MessagePack or CBOR value
+typedef struct {
+    PackType type;
+    size_t headerLength;
+
+    // Length of a string or binary, number of elements of an array or map
+    uint64_t length;
+
+    int64_t intValue;
+    double floatValue;
+    bool boolValue;
+} PackValue_t;
+
+// Reads MessagePack or CBOR values one after another.
+// Values are only decoded when they are read, skipped arrays and maps are never decoded.
+class PackReader {
+private:
+    PackFormat format;
+    std::string data;
+    size_t position;
+
+public:
+    PackReader(PackFormat format, std::string data);
+
+    // Type of the next value, PACK_TYPE_NONE at the end or on invalid data
+    PackType GetType() const;
+
+    // Reads the next value, for arrays and maps only the header is read and the elements follow
+    bool Read(PackValue_t& value, std::string* payload = nullptr);
+
+    // Skips the next value with all its elements
+    bool Skip();
+
+    // Searches the next count map entries for a string key and stops at its value
+    bool FindKey(const char* key, uint64_t count);
+
+    size_t GetPosition() const;
+    void SetPosition(size_t position);
+    size_t GetLength() const;
+
+    static PackReader* ConvertPackReader(Handle_t hndl, IPluginContext* pContext);
+
+private:
+    bool Peek(size_t at, PackValue_t& value) const;
+    bool PeekMsgPack(size_t at, PackValue_t& value) const;
+    bool PeekCBOR(size_t at, PackValue_t& value) const;
+
+    bool ReadBigEndian(size_t at, int bytes, uint64_t& value) const;
+};
+
+#endif
\ No newline at end of file
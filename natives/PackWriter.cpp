@@ -0,0 +1,210 @@
+/**
+ * -----------------------------------------------------
+ * File        PackWriter.cpp
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "PackWriter.h"
+
+#include <cstring>
+
+PackWriter::PackWriter(PackFormat format) : format(format) {};
+
+void PackWriter::WriteNil() {
+    this->data.push_back(this->format == PACK_CBOR ? '\xf6' : '\xc0');
+}
+
+void PackWriter::WriteBool(bool value) {
+    if (this->format == PACK_CBOR) {
+        this->data.push_back(value ? '\xf5' : '\xf4');
+    } else {
+        this->data.push_back(value ? '\xc3' : '\xc2');
+    }
+}
+
+void PackWriter::WriteInt(int64_t value) {
+    if (this->format == PACK_CBOR) {
+        if (value >= 0) {
+            this->WriteCBORHeader(0, static_cast<uint64_t>(value));
+        } else {
+            this->WriteCBORHeader(1, static_cast<uint64_t>(-(value + 1)));
+        }
+
+        return;
+    }
+
+    // Use the smallest MessagePack representation
+    if (value >= 0) {
+        if (value <= 0x7f) {
+            this->data.push_back(static_cast<char>(value));
+        } else if (value <= 0xff) {
+            this->data.push_back('\xcc');
+            this->WriteBigEndian(value, 1);
+        } else if (value <= 0xffff) {
+            this->data.push_back('\xcd');
+            this->WriteBigEndian(value, 2);
+        } else if (value <= 0xffffffffLL) {
+            this->data.push_back('\xce');
+            this->WriteBigEndian(value, 4);
+        } else {
+            this->data.push_back('\xcf');
+            this->WriteBigEndian(value, 8);
+        }
+    } else {
+        if (value >= -32) {
+            this->data.push_back(static_cast<char>(value));
+        } else if (value >= INT8_MIN) {
+            this->data.push_back('\xd0');
+            this->WriteBigEndian(static_cast<uint64_t>(value), 1);
+        } else if (value >= INT16_MIN) {
+            this->data.push_back('\xd1');
+            this->WriteBigEndian(static_cast<uint64_t>(value), 2);
+        } else if (value >= INT32_MIN) {
+            this->data.push_back('\xd2');
+            this->WriteBigEndian(static_cast<uint64_t>(value), 4);
+        } else {
+            this->data.push_back('\xd3');
+            this->WriteBigEndian(static_cast<uint64_t>(value), 8);
+        }
+    }
+}
+
+void PackWriter::WriteFloat(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+
+    this->data.push_back(this->format == PACK_CBOR ? '\xfa' : '\xca');
+    this->WriteBigEndian(bits, 4);
+}
+
+void PackWriter::WriteString(const char* value, size_t length) {
+    if (this->format == PACK_CBOR) {
+        this->WriteCBORHeader(3, length);
+    } else if (length < 32) {
+        this->data.push_back(static_cast<char>(0xa0 | length));
+    } else if (length <= 0xff) {
+        this->data.push_back('\xd9');
+        this->WriteBigEndian(length, 1);
+    } else if (length <= 0xffff) {
+        this->data.push_back('\xda');
+        this->WriteBigEndian(length, 2);
+    } else {
+        this->data.push_back('\xdb');
+        this->WriteBigEndian(length, 4);
+    }
+
+    this->data.append(value, length);
+}
+
+void PackWriter::WriteBinary(const char* value, size_t length) {
+    if (this->format == PACK_CBOR) {
+        this->WriteCBORHeader(2, length);
+    } else if (length <= 0xff) {
+        this->data.push_back('\xc4');
+        this->WriteBigEndian(length, 1);
+    } else if (length <= 0xffff) {
+        this->data.push_back('\xc5');
+        this->WriteBigEndian(length, 2);
+    } else {
+        this->data.push_back('\xc6');
+        this->WriteBigEndian(length, 4);
+    }
+
+    this->data.append(value, length);
+}
+
+void PackWriter::WriteArray(uint32_t count) {
+    if (this->format == PACK_CBOR) {
+        this->WriteCBORHeader(4, count);
+    } else if (count < 16) {
+        this->data.push_back(static_cast<char>(0x90 | count));
+    } else if (count <= 0xffff) {
+        this->data.push_back('\xdc');
+        this->WriteBigEndian(count, 2);
+    } else {
+        this->data.push_back('\xdd');
+        this->WriteBigEndian(count, 4);
+    }
+}
+
+void PackWriter::WriteMap(uint32_t count) {
+    if (this->format == PACK_CBOR) {
+        this->WriteCBORHeader(5, count);
+    } else if (count < 16) {
+        this->data.push_back(static_cast<char>(0x80 | count));
+    } else if (count <= 0xffff) {
+        this->data.push_back('\xde');
+        this->WriteBigEndian(count, 2);
+    } else {
+        this->data.push_back('\xdf');
+        this->WriteBigEndian(count, 4);
+    }
+}
+
+const std::string& PackWriter::GetData() const {
+    return this->data;
+}
+
+PackFormat PackWriter::GetFormat() const {
+    return this->format;
+}
+
+const char* PackWriter::GetContentType() const {
+    return this->format == PACK_CBOR ? "application/cbor" : "application/msgpack";
+}
+
+void PackWriter::WriteBigEndian(uint64_t value, int bytes) {
+    for (int i = bytes - 1; i >= 0; i--) {
+        this->data.push_back(static_cast<char>((value >> (i * 8)) & 0xff));
+    }
+}
+
+void PackWriter::WriteCBORHeader(uint8_t major, uint64_t argument) {
+    uint8_t type = major << 5;
+
+    if (argument < 24) {
+        this->data.push_back(static_cast<char>(type | argument));
+    } else if (argument <= 0xff) {
+        this->data.push_back(static_cast<char>(type | 24));
+        this->WriteBigEndian(argument, 1);
+    } else if (argument <= 0xffff) {
+        this->data.push_back(static_cast<char>(type | 25));
+        this->WriteBigEndian(argument, 2);
+    } else if (argument <= 0xffffffffULL) {
+        this->data.push_back(static_cast<char>(type | 26));
+        this->WriteBigEndian(argument, 4);
+    } else {
+        this->data.push_back(static_cast<char>(type | 27));
+        this->WriteBigEndian(argument, 8);
+    }
+}
+
+PackWriter* PackWriter::ConvertPackWriter(Handle_t hndl, IPluginContext* pContext) {
+    HandleError err;
+
+    PackWriter* writer = nullptr;
+    if ((err = packWriterHandler.ReadHandle(hndl, pContext->GetIdentity(), &writer)) != HandleError_None) {
+        pContext->ThrowNativeError("Invalid pack writer handle %x (error %d)", hndl, err);
+        return nullptr;
+    }
+
+    return writer;
+}
\ No newline at end of file
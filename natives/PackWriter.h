@@ -0,0 +1,64 @@
+/**
+ * -----------------------------------------------------
+ * File        PackWriter.h
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#ifndef _SYSTEM2_PACK_WRITER_H_
+#define _SYSTEM2_PACK_WRITER_H_
+
+#include "extension.h"
+#include "PackFormat.h"
+#include "PackWriterHandler.h"
+
+// Encodes values as MessagePack or CBOR.
+// Arrays and maps are written as a header with the number of elements followed by the elements.
+class PackWriter {
+private:
+    PackFormat format;
+    std::string data;
+
+public:
+    explicit PackWriter(PackFormat format);
+
+    void WriteNil();
+    void WriteBool(bool value);
+    void WriteInt(int64_t value);
+    void WriteFloat(float value);
+    void WriteString(const char* value, size_t length);
+    void WriteBinary(const char* value, size_t length);
+    void WriteArray(uint32_t count);
+    void WriteMap(uint32_t count);
+
+    const std::string& GetData() const;
+    PackFormat GetFormat() const;
+    const char* GetContentType() const;
+
+    static PackWriter* ConvertPackWriter(Handle_t hndl, IPluginContext* pContext);
+
+private:
+    void WriteBigEndian(uint64_t value, int bytes);
+
+    // Writes the major type and argument of a CBOR data item
+    void WriteCBORHeader(uint8_t major, uint64_t argument);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,56 @@
+/**
+ * -----------------------------------------------------
+ * File        PreparedRequest.cpp
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "PreparedRequest.h"
+#include "PreparedRequestThread.h"
+
+PreparedRequest::PreparedRequest(HTTPRequest* httpRequest, HTTPRequestMethod method, std::shared_ptr<CurlHandlePool> pool)
+    : httpRequest(httpRequest), method(method), pool(pool) {};
+
+PreparedRequest::~PreparedRequest() {
+    delete this->httpRequest;
+}
+
+void PreparedRequest::Send(const std::string& body) {
+    // Every transfer gets its own copy, as it is owned by the response callback
+    HTTPRequest* request = this->httpRequest->Clone();
+    if (!body.empty()) {
+        request->bodyData = body;
+    }
+
+    PreparedRequestThread* requestThread = new PreparedRequestThread(request, this->method, this->pool);
+    requestThread->RunThread();
+}
+
+PreparedRequest* PreparedRequest::ConvertPreparedRequest(Handle_t hndl, IPluginContext* pContext) {
+    HandleError err;
+
+    PreparedRequest* prepared = nullptr;
+    if ((err = preparedRequestHandler.ReadHandle(hndl, pContext->GetIdentity(), &prepared)) != HandleError_None) {
+        pContext->ThrowNativeError("Invalid prepared request handle %x (error %d)", hndl, err);
+        return nullptr;
+    }
+
+    return prepared;
+}
\ No newline at end of file
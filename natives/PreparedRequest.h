@@ -0,0 +1,49 @@
+/**
+ * -----------------------------------------------------
+ * File        PreparedRequest.h
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#ifndef _SYSTEM2_PREPARED_REQUEST_H_
+#define _SYSTEM2_PREPARED_REQUEST_H_
+
+#include "extension.h"
+#include "HTTPRequest.h"
+#include "CurlHandlePool.h"
+#include "PreparedRequestHandler.h"
+
+class PreparedRequest {
+public:
+    HTTPRequest* httpRequest;
+    HTTPRequestMethod method;
+    std::shared_ptr<CurlHandlePool> pool;
+
+    // Takes ownership of the request snapshot
+    PreparedRequest(HTTPRequest* httpRequest, HTTPRequestMethod method, std::shared_ptr<CurlHandlePool> pool);
+    ~PreparedRequest();
+
+    // Sends the prepared request, a non empty body replaces the body of the snapshot
+    void Send(const std::string& body);
+
+    static PreparedRequest* ConvertPreparedRequest(Handle_t hndl, IPluginContext* pContext);
+};
+
+#endif
\ No newline at end of file
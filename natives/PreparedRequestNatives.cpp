@@ -0,0 +1,102 @@
+/**
+ * -----------------------------------------------------
+ * File        PreparedRequestNatives.cpp
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "Natives.h"
+#include "PreparedRequest.h"
+#include "PreparedRequestHandler.h"
+#include "PreparedRequestThread.h"
+
+cell_t NativePreparedRequest_PreparedRequest(IPluginContext* pContext, const cell_t* params) {
+    HTTPRequest* request = Request::ConvertRequest<HTTPRequest>(params[1], pContext);
+    if (!request) {
+        return BAD_HANDLE;
+    }
+
+    if (params[2] < METHOD_GET || params[2] > METHOD_HEAD) {
+        pContext->ThrowNativeError("Invalid request method %d", params[2]);
+        return BAD_HANDLE;
+    }
+
+    if (request->url.empty()) {
+        pContext->ThrowNativeError("URL of the request is empty");
+        return BAD_HANDLE;
+    }
+
+    if (request->eventCallbackFunction) {
+        pContext->ThrowNativeError("Event stream requests can't be prepared");
+        return BAD_HANDLE;
+    }
+
+    // Take a snapshot, so later changes to the request don't affect the prepared one
+    HTTPRequest* snapshot = request->Clone();
+    HTTPRequestMethod method = static_cast<HTTPRequestMethod>(params[2]);
+
+    std::shared_ptr<CurlHandlePool> pool = PreparedRequestThread::Prepare(snapshot, method);
+    if (!pool) {
+        delete snapshot;
+        pContext->ThrowNativeError("Couldn't initialize CURL");
+        return BAD_HANDLE;
+    }
+
+    PreparedRequest* prepared = new PreparedRequest(snapshot, method, pool);
+
+    Handle_t hndl = preparedRequestHandler.CreateHandle(prepared, pContext->GetIdentity());
+    if (hndl == BAD_HANDLE) {
+        delete prepared;
+        pContext->ThrowNativeError("Couldn't create prepared request handle");
+    }
+
+    return hndl;
+}
+
+cell_t NativePreparedRequest_Send(IPluginContext* pContext, const cell_t* params) {
+    PreparedRequest* prepared = PreparedRequest::ConvertPreparedRequest(params[1], pContext);
+    if (!prepared) {
+        return 0;
+    }
+
+    char* body;
+    pContext->LocalToString(params[2], &body);
+
+    prepared->Send(body);
+    return 1;
+}
+
+cell_t NativePreparedRequest_SendBinary(IPluginContext* pContext, const cell_t* params) {
+    PreparedRequest* prepared = PreparedRequest::ConvertPreparedRequest(params[1], pContext);
+    if (!prepared) {
+        return 0;
+    }
+
+    if (params[3] < 0) {
+        pContext->ThrowNativeError("Invalid body length %d", params[3]);
+        return 0;
+    }
+
+    cell_t* body;
+    pContext->LocalToPhysAddr(params[2], &body);
+
+    prepared->Send(std::string(reinterpret_cast<const char*>(body), params[3]));
+    return 1;
+}
\ No newline at end of file
@@ -25,13 +25,30 @@
 #include "Request.h"
 
 Request::Request(std::string url, std::shared_ptr<CallbackFunction_t> responseCallbackFunction) :
-    url(url), port(0), verifySSL(true), proxyHttpTunnel(false), timeout(0), data(0),
+    url(url), port(0), verifySSL(true), proxyHttpTunnel(false), unixSocketAbstract(false), timeout(0), data(0),
+    maxMemoryContent(DEFAULT_MAX_MEMORY_CONTENT), writeBehind(DEFAULT_WRITE_BEHIND), hasDeadline(false), error(REQUEST_ERROR_NONE),
     responseCallbackFunction(responseCallbackFunction), progressCallbackFunction(nullptr) {}
 
 Request::Request(const Request& request) :
-    url(request.url), port(request.port), outputFile(request.outputFile), verifySSL(request.verifySSL), proxy(request.proxy),
+    url(request.url), port(request.port), outputFile(request.outputFile), extractDirectory(request.extractDirectory), verifySSL(request.verifySSL), proxy(request.proxy),
     proxyHttpTunnel(request.proxyHttpTunnel), proxyUsername(request.proxyUsername), proxyPassword(request.proxyPassword),
+    unixSocketPath(request.unixSocketPath), unixSocketAbstract(request.unixSocketAbstract),
     timeout(request.timeout), data(request.data), maxSendSpeed(request.maxSendSpeed), maxRecvSpeed(request.maxRecvSpeed),
+    maxMemoryContent(request.maxMemoryContent), writeBehind(request.writeBehind),
+    tuningProfile(request.tuningProfile), hasDeadline(request.hasDeadline), deadline(request.deadline), error(REQUEST_ERROR_NONE),
     responseCallbackFunction(request.responseCallbackFunction), progressCallbackFunction(request.progressCallbackFunction) {}
 
-Request::~Request() {}
\ No newline at end of file
+Request::~Request() {}
+
+int Request::GetRemainingTime() const {
+    if (!this->hasDeadline) {
+        return -1;
+    }
+
+    auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(this->deadline - std::chrono::steady_clock::now()).count();
+    return remaining > 0 ? static_cast<int>(remaining) : 0;
+}
+
+bool Request::HasExpired() const {
+    return this->hasDeadline && std::chrono::steady_clock::now() >= this->deadline;
+}
\ No newline at end of file
@@ -27,21 +27,44 @@
 
 #include "extension.h"
 #include "RequestHandler.h"
+#include "TuningProfile.h"
+#include "RequestError.h"
+
+#include <chrono>
+
+// Response content above this size is moved to a temporary file by default
+#define DEFAULT_MAX_MEMORY_CONTENT 4194304
+
+// Downloaded data for an output file which may wait for the disk by default
+#define DEFAULT_WRITE_BEHIND 4194304
 
 class Request {
 public:
     std::string url;
     int port;
     std::string outputFile;
+    std::string extractDirectory;
     bool verifySSL;
     std::string proxy;
     bool proxyHttpTunnel;
     std::string proxyUsername;
     std::string proxyPassword;
+    std::string unixSocketPath;
+    bool unixSocketAbstract;
     int timeout;
     int data;
     curl_off_t maxSendSpeed;
     curl_off_t maxRecvSpeed;
+    int maxMemoryContent;
+    int writeBehind;
+    std::shared_ptr<const TuningProfile> tuningProfile;
+
+    // Absolute point in time until the response has to be delivered
+    bool hasDeadline;
+    std::chrono::steady_clock::time_point deadline;
+
+    // Why the request failed, only set on the copy which is passed to the response callback
+    RequestError error;
 
     std::shared_ptr<CallbackFunction_t> responseCallbackFunction;
     std::shared_ptr<CallbackFunction_t> progressCallbackFunction;
@@ -52,6 +75,10 @@ public:
 
     virtual Request* Clone() const = 0;
 
+    // Returns the milliseconds left until the deadline, or -1 if there is no deadline
+    int GetRemainingTime() const;
+    bool HasExpired() const;
+
     template<class RequestClass>
     static RequestClass* ConvertRequest(Handle_t hndl, IPluginContext* pContext) {
         HandleError err;
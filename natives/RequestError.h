@@ -0,0 +1,36 @@
+/**
+ * -----------------------------------------------------
+ * File        RequestError.h
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#ifndef _SYSTEM2_REQUEST_ERROR_H_
+#define _SYSTEM2_REQUEST_ERROR_H_
+
+enum RequestError {
+    REQUEST_ERROR_NONE,
+    REQUEST_ERROR_TRANSFER,
+    REQUEST_ERROR_CIRCUIT_OPEN,
+    REQUEST_ERROR_HOST_BUSY,
+    REQUEST_ERROR_DEADLINE
+};
+
+#endif
\ No newline at end of file
@@ -27,6 +27,7 @@
 #include "FTPRequest.h"
 #include "RequestHandler.h"
 #include "HTTPRequestThread.h"
+#include "Outbox.h"
 
 cell_t NativeRequest_SetURL(IPluginContext* pContext, const cell_t* params) {
     Request* request = Request::ConvertRequest<Request>(params[1], pContext);
@@ -98,6 +99,29 @@ cell_t NativeRequest_GetOutputFile(IPluginContext* pContext, const cell_t* param
     return 1;
 }
 
+cell_t NativeRequest_SetExtractDirectory(IPluginContext* pContext, const cell_t* params) {
+    Request* request = Request::ConvertRequest<Request>(params[1], pContext);
+    if (!request) {
+        return 0;
+    }
+
+    char extractDirectory[PLATFORM_MAX_PATH + 1];
+    smutils->FormatString(extractDirectory, sizeof(extractDirectory), pContext, params, 2);
+
+    request->extractDirectory = extractDirectory;
+    return 1;
+}
+
+cell_t NativeRequest_GetExtractDirectory(IPluginContext* pContext, const cell_t* params) {
+    Request* request = Request::ConvertRequest<Request>(params[1], pContext);
+    if (!request) {
+        return 0;
+    }
+
+    pContext->StringToLocalUTF8(params[2], params[3], request->extractDirectory.c_str(), nullptr);
+    return 1;
+}
+
 cell_t NativeRequest_SetVerifySSL(IPluginContext* pContext, const cell_t* params) {
     Request* request = Request::ConvertRequest<Request>(params[1], pContext);
     if (!request) {
@@ -147,6 +171,36 @@ cell_t NativeRequest_SetProxyAuthentication(IPluginContext* pContext, const cell
     return 1;
 }
 
+cell_t NativeRequest_SetUnixSocketPath(IPluginContext* pContext, const cell_t* params) {
+    Request* request = Request::ConvertRequest<Request>(params[1], pContext);
+    if (!request) {
+        return 0;
+    }
+
+    char* path;
+    pContext->LocalToString(params[2], &path);
+
+    // Linux only accepts 107 characters for a socket path
+    if (strlen(path) > 107) {
+        pContext->ThrowNativeError("Unix socket path %s is too long", path);
+        return 0;
+    }
+
+    request->unixSocketPath = path;
+    request->unixSocketAbstract = params[3];
+    return 1;
+}
+
+cell_t NativeRequest_GetUnixSocketPath(IPluginContext* pContext, const cell_t* params) {
+    Request* request = Request::ConvertRequest<Request>(params[1], pContext);
+    if (!request) {
+        return 0;
+    }
+
+    pContext->StringToLocalUTF8(params[2], params[3], request->unixSocketPath.c_str(), nullptr);
+    return request->unixSocketAbstract;
+}
+
 cell_t NativeRequest_GetTimeout(IPluginContext* pContext, const cell_t* params) {
     Request* request = Request::ConvertRequest<Request>(params[1], pContext);
     if (!request) {
@@ -171,6 +225,41 @@ cell_t NativeRequest_SetTimeout(IPluginContext* pContext, const cell_t* params)
     return 1;
 }
 
+cell_t NativeRequest_GetDeadline(IPluginContext* pContext, const cell_t* params) {
+    Request* request = Request::ConvertRequest<Request>(params[1], pContext);
+    if (!request) {
+        return 0;
+    }
+
+    return request->GetRemainingTime();
+}
+
+cell_t NativeRequest_SetDeadline(IPluginContext* pContext, const cell_t* params) {
+    Request* request = Request::ConvertRequest<Request>(params[1], pContext);
+    if (!request) {
+        return 0;
+    }
+
+    if (params[2] < -1) {
+        pContext->ThrowNativeError("Invalid deadline %d", params[2]);
+        return 0;
+    }
+
+    // The deadline is relative to now, but stays fixed afterwards
+    request->hasDeadline = params[2] >= 0;
+    request->deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(params[2]);
+    return 1;
+}
+
+cell_t NativeRequest_GetError(IPluginContext* pContext, const cell_t* params) {
+    Request* request = Request::ConvertRequest<Request>(params[1], pContext);
+    if (!request) {
+        return 0;
+    }
+
+    return request->error;
+}
+
 cell_t NativeRequest_GetAnyData(IPluginContext* pContext, const cell_t* params) {
     Request* request = Request::ConvertRequest<Request>(params[1], pContext);
     if (!request) {
@@ -210,6 +299,44 @@ cell_t NativeRequest_SetMaxRecvSpeed(IPluginContext* pContext, const cell_t* par
     return 1;
 }
 
+cell_t NativeRequest_GetMaxMemoryContent(IPluginContext* pContext, const cell_t* params) {
+    Request* request = Request::ConvertRequest<Request>(params[1], pContext);
+    if (!request) {
+        return 0;
+    }
+
+    return request->maxMemoryContent;
+}
+
+cell_t NativeRequest_SetMaxMemoryContent(IPluginContext* pContext, const cell_t* params) {
+    Request* request = Request::ConvertRequest<Request>(params[1], pContext);
+    if (!request) {
+        return 0;
+    }
+
+    request->maxMemoryContent = params[2] < 0 ? -1 : params[2];
+    return 1;
+}
+
+cell_t NativeRequest_GetWriteBehind(IPluginContext* pContext, const cell_t* params) {
+    Request* request = Request::ConvertRequest<Request>(params[1], pContext);
+    if (!request) {
+        return 0;
+    }
+
+    return request->writeBehind;
+}
+
+cell_t NativeRequest_SetWriteBehind(IPluginContext* pContext, const cell_t* params) {
+    Request* request = Request::ConvertRequest<Request>(params[1], pContext);
+    if (!request) {
+        return 0;
+    }
+
+    request->writeBehind = params[2] < 0 ? 0 : params[2];
+    return 1;
+}
+
 cell_t NativeHTTPRequest_HTTPRequest(IPluginContext* pContext, const cell_t* params) {
     auto callback = system2Extension.CreateCallbackFunction(pContext->GetFunctionById(params[1]));
     if (!callback) {
@@ -267,6 +394,73 @@ cell_t NativeHTTPRequest_GetData(IPluginContext* pContext, const cell_t* params)
     return 1;
 }
 
+cell_t NativeHTTPRequest_SetBinaryData(IPluginContext* pContext, const cell_t* params) {
+    HTTPRequest* request = Request::ConvertRequest<HTTPRequest>(params[1], pContext);
+    if (!request) {
+        return 0;
+    }
+
+    if (params[3] < 0) {
+        pContext->ThrowNativeError("Invalid data length %d", params[3]);
+        return 0;
+    }
+
+    // Copy the bytes as they are, they may contain NUL bytes
+    cell_t* data;
+    pContext->LocalToPhysAddr(params[2], &data);
+
+    request->bodyData.assign(reinterpret_cast<const char*>(data), params[3]);
+    return 1;
+}
+
+cell_t NativeHTTPRequest_GetBinaryData(IPluginContext* pContext, const cell_t* params) {
+    HTTPRequest* request = Request::ConvertRequest<HTTPRequest>(params[1], pContext);
+    if (!request) {
+        return 0;
+    }
+
+    cell_t* data;
+    pContext->LocalToPhysAddr(params[2], &data);
+
+    size_t bytes = params[3] > 0 ? std::min(request->bodyData.size(), static_cast<size_t>(params[3])) : 0;
+    memcpy(reinterpret_cast<char*>(data), request->bodyData.data(), bytes);
+
+    return bytes;
+}
+
+cell_t NativeHTTPRequest_GetDataLength(IPluginContext* pContext, const cell_t* params) {
+    HTTPRequest* request = Request::ConvertRequest<HTTPRequest>(params[1], pContext);
+    if (!request) {
+        return 0;
+    }
+
+    return request->bodyData.size();
+}
+
+cell_t NativeHTTPRequest_GetBodyEncoding(IPluginContext* pContext, const cell_t* params) {
+    HTTPRequest* request = Request::ConvertRequest<HTTPRequest>(params[1], pContext);
+    if (!request) {
+        return 0;
+    }
+
+    return request->bodyEncoding;
+}
+
+cell_t NativeHTTPRequest_SetBodyEncoding(IPluginContext* pContext, const cell_t* params) {
+    HTTPRequest* request = Request::ConvertRequest<HTTPRequest>(params[1], pContext);
+    if (!request) {
+        return 0;
+    }
+
+    if (params[2] < BODY_ENCODING_NONE || params[2] > BODY_ENCODING_HEX) {
+        pContext->ThrowNativeError("Invalid body encoding %d", params[2]);
+        return 0;
+    }
+
+    request->bodyEncoding = static_cast<BodyEncoding>(params[2]);
+    return 1;
+}
+
 cell_t NativeHTTPRequest_SetHeader(IPluginContext* pContext, const cell_t* params) {
     HTTPRequest* request = Request::ConvertRequest<HTTPRequest>(params[1], pContext);
     if (!request) {
@@ -293,7 +487,7 @@ cell_t NativeHTTPRequest_GetHeader(IPluginContext* pContext, const cell_t* param
     pContext->LocalToString(params[2], &header);
 
     for (auto it = request->headers.begin(); it != request->headers.end(); ++it) {
-        if (HTTPRequestThread::EqualsIgnoreCase(it->first, header)) {
+        if (HTTPRequestThread::EqualsIgnoreCase(it->first.c_str(), header)) {
             pContext->StringToLocalUTF8(params[3], params[4], request->headers[header].c_str(), nullptr);
             return true;
         }
@@ -420,6 +614,26 @@ cell_t NativeHTTPRequest_HEAD(IPluginContext* pContext, const cell_t* params) {
     return 1;
 }
 
+cell_t NativeHTTPRequest_Enqueue(IPluginContext* pContext, const cell_t* params) {
+    HTTPRequest* request = Request::ConvertRequest<HTTPRequest>(params[1], pContext);
+    if (!request) {
+        return 0;
+    }
+
+    if (params[2] < METHOD_GET || params[2] > METHOD_HEAD) {
+        pContext->ThrowNativeError("Invalid request method %d", params[2]);
+        return 0;
+    }
+
+    if (request->eventCallbackFunction) {
+        pContext->ThrowNativeError("Requests with an event callback can't be queued");
+        return 0;
+    }
+
+    // Only a copy of the request is queued, it is written to the journal by the outbox thread
+    return outbox.Enqueue(request, static_cast<HTTPRequestMethod>(params[2]));
+}
+
 cell_t NativeHTTPRequest_GetFollowRedirects(IPluginContext* pContext, const cell_t* params) {
     HTTPRequest* request = Request::ConvertRequest<HTTPRequest>(params[1], pContext);
     if (!request) {
@@ -439,6 +653,90 @@ cell_t NativeHTTPRequest_SetFollowRedirects(IPluginContext* pContext, const cell
     return 1;
 }
 
+cell_t NativeHTTPRequest_GetHostLimit(IPluginContext* pContext, const cell_t* params) {
+    HTTPRequest* request = Request::ConvertRequest<HTTPRequest>(params[1], pContext);
+    if (!request) {
+        return 0;
+    }
+
+    return request->hostLimit;
+}
+
+cell_t NativeHTTPRequest_SetHostLimit(IPluginContext* pContext, const cell_t* params) {
+    HTTPRequest* request = Request::ConvertRequest<HTTPRequest>(params[1], pContext);
+    if (!request) {
+        return 0;
+    }
+
+    request->hostLimit = params[2];
+    return 1;
+}
+
+cell_t NativeHTTPRequest_SetEventCallback(IPluginContext* pContext, const cell_t* params) {
+    HTTPRequest* request = Request::ConvertRequest<HTTPRequest>(params[1], pContext);
+    if (!request) {
+        return 0;
+    }
+
+    if (params[3] < STREAM_NONE || params[3] > STREAM_NDJSON) {
+        pContext->ThrowNativeError("Invalid event stream format %d", params[3]);
+        return 0;
+    }
+
+    auto callback = system2Extension.CreateCallbackFunction(pContext->GetFunctionById(params[2]));
+    if (!callback) {
+        pContext->ThrowNativeError("Callback ID %x is invalid", params[2]);
+        return 0;
+    }
+
+    request->eventCallbackFunction = callback;
+    request->eventStreamFormat = static_cast<EventStreamFormat>(params[3]);
+    return 1;
+}
+
+cell_t NativeHTTPRequest_GetEventBacklog(IPluginContext* pContext, const cell_t* params) {
+    HTTPRequest* request = Request::ConvertRequest<HTTPRequest>(params[1], pContext);
+    if (!request) {
+        return 0;
+    }
+
+    return request->eventBacklog;
+}
+
+cell_t NativeHTTPRequest_SetEventBacklog(IPluginContext* pContext, const cell_t* params) {
+    HTTPRequest* request = Request::ConvertRequest<HTTPRequest>(params[1], pContext);
+    if (!request) {
+        return 0;
+    }
+
+    if (params[2] < 1) {
+        pContext->ThrowNativeError("Invalid event backlog %d", params[2]);
+        return 0;
+    }
+
+    request->eventBacklog = params[2];
+    return 1;
+}
+
+cell_t NativeHTTPRequest_GetEventReconnects(IPluginContext* pContext, const cell_t* params) {
+    HTTPRequest* request = Request::ConvertRequest<HTTPRequest>(params[1], pContext);
+    if (!request) {
+        return 0;
+    }
+
+    return request->eventReconnects;
+}
+
+cell_t NativeHTTPRequest_SetEventReconnects(IPluginContext* pContext, const cell_t* params) {
+    HTTPRequest* request = Request::ConvertRequest<HTTPRequest>(params[1], pContext);
+    if (!request) {
+        return 0;
+    }
+
+    request->eventReconnects = params[2] < 0 ? -1 : params[2];
+    return 1;
+}
+
 cell_t NativeFTPRequest_FTPRequest(IPluginContext* pContext, const cell_t* params) {
     auto callback = system2Extension.CreateCallbackFunction(pContext->GetFunctionById(params[1]));
     if (!callback) {
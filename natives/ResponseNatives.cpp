@@ -25,6 +25,7 @@
 #include "ResponseCallback.h"
 #include "HTTPResponseCallback.h"
 #include "HTTPRequestThread.h"
+#include "EventCallback.h"
 
 cell_t NativeResponse_GetLastURL(IPluginContext* pContext, const cell_t* params) {
     ResponseCallback* response = ResponseCallback::ConvertResponse<ResponseCallback>(params[1], pContext);
@@ -43,10 +44,8 @@ cell_t NativeResponse_GetContent(IPluginContext* pContext, const cell_t* params)
     }
 
     // Get offset and check range
-    std::string output = response->content;
-
     int offset = params[4];
-    int length = static_cast<int>(output.length());
+    int length = response->content ? static_cast<int>(response->content->Length()) : 0;
     if (offset < 0) {
         offset = 0;
     }
@@ -57,23 +56,26 @@ cell_t NativeResponse_GetContent(IPluginContext* pContext, const cell_t* params)
 
     char* delimiter;
     pContext->LocalToString(params[5], &delimiter);
+    size_t delimiterLength = strlen(delimiter);
+
+    // Only read the part of the content which can be stored in the buffer (and a delimiter which begins in it)
+    std::string output;
+    if (response->content && params[3] > 0) {
+        output = response->content->Read(offset, params[3] - 1 + delimiterLength);
+    }
 
-    if (strlen(delimiter) > 0) {
+    if (delimiterLength > 0) {
         // Find the delimiter
-        size_t delimiterPos = output.find(delimiter, offset);
+        size_t delimiterPos = output.find(delimiter);
         if (delimiterPos != std::string::npos) {
             bool includeDelimiter = params[6];
             if (includeDelimiter) {
                 // Include the delimiter in the response
-                delimiterPos += strlen(delimiter);
+                delimiterPos += delimiterLength;
             }
 
-            output = output.substr(offset, delimiterPos - offset);
-        } else {
-            output = output.substr(offset);
+            output.resize(delimiterPos);
         }
-    } else {
-        output = output.substr(offset);
     }
 
     size_t bytes;
@@ -82,13 +84,30 @@ cell_t NativeResponse_GetContent(IPluginContext* pContext, const cell_t* params)
     return bytes;
 }
 
+cell_t NativeResponse_GetBinaryContent(IPluginContext* pContext, const cell_t* params) {
+    ResponseCallback* response = ResponseCallback::ConvertResponse<ResponseCallback>(params[1], pContext);
+    if (!response) {
+        return 0;
+    }
+
+    if (!response->content || params[3] <= 0 || params[4] < 0) {
+        return 0;
+    }
+
+    // Copy the bytes directly into the buffer without any conversion
+    cell_t* content;
+    pContext->LocalToPhysAddr(params[2], &content);
+
+    return response->content->Read(params[4], reinterpret_cast<char*>(content), params[3]);
+}
+
 cell_t NativeResponse_GetContentLength(IPluginContext* pContext, const cell_t* params) {
     ResponseCallback* response = ResponseCallback::ConvertResponse<ResponseCallback>(params[1], pContext);
     if (!response) {
         return 0;
     }
 
-    return response->contentLength;
+    return static_cast<cell_t>(response->contentLength);
 }
 
 cell_t NativeResponse_GetStatusCode(IPluginContext* pContext, const cell_t* params) {
@@ -165,8 +184,8 @@ cell_t NativeHTTPResponse_GetHeader(IPluginContext* pContext, const cell_t* para
     pContext->LocalToString(params[2], &header);
 
     for (auto it = response->headers.begin(); it != response->headers.end(); ++it) {
-        if (HTTPRequestThread::EqualsIgnoreCase(it->first, header)) {
-            pContext->StringToLocalUTF8(params[3], params[4], response->headers[header].c_str(), nullptr);
+        if (HTTPRequestThread::EqualsIgnoreCase(it->first.c_str(), header)) {
+            pContext->StringToLocalUTF8(params[3], params[4], it->second.c_str(), nullptr);
             return 1;
         }
     }
@@ -210,4 +229,69 @@ cell_t NativeHTTPResponse_GetHTTPVersion(IPluginContext* pContext, const cell_t*
     }
 
     return response->httpVersion;
-}
\ No newline at end of file
+}
+
+cell_t NativeEventBatch_GetCount(IPluginContext* pContext, const cell_t* params) {
+    EventCallback* batch = EventCallback::ConvertEventBatch(params[1], pContext);
+    if (!batch) {
+        return 0;
+    }
+
+    return batch->events.size();
+}
+
+cell_t NativeEventBatch_GetDropped(IPluginContext* pContext, const cell_t* params) {
+    EventCallback* batch = EventCallback::ConvertEventBatch(params[1], pContext);
+    if (!batch) {
+        return 0;
+    }
+
+    return batch->dropped;
+}
+
+cell_t NativeEventBatch_GetData(IPluginContext* pContext, const cell_t* params) {
+    EventCallback* batch = EventCallback::ConvertEventBatch(params[1], pContext);
+    if (!batch) {
+        return 0;
+    }
+
+    if (params[2] < 0 || params[2] >= static_cast<int>(batch->events.size())) {
+        pContext->ThrowNativeError("Invalid event index %d (count %d)", params[2], batch->events.size());
+        return 0;
+    }
+
+    size_t bytes;
+    pContext->StringToLocalUTF8(params[3], params[4], batch->events[params[2]].data.c_str(), &bytes);
+
+    return bytes;
+}
+
+cell_t NativeEventBatch_GetType(IPluginContext* pContext, const cell_t* params) {
+    EventCallback* batch = EventCallback::ConvertEventBatch(params[1], pContext);
+    if (!batch) {
+        return 0;
+    }
+
+    if (params[2] < 0 || params[2] >= static_cast<int>(batch->events.size())) {
+        pContext->ThrowNativeError("Invalid event index %d (count %d)", params[2], batch->events.size());
+        return 0;
+    }
+
+    pContext->StringToLocalUTF8(params[3], params[4], batch->events[params[2]].type.c_str(), nullptr);
+    return 1;
+}
+
+cell_t NativeEventBatch_GetId(IPluginContext* pContext, const cell_t* params) {
+    EventCallback* batch = EventCallback::ConvertEventBatch(params[1], pContext);
+    if (!batch) {
+        return 0;
+    }
+
+    if (params[2] < 0 || params[2] >= static_cast<int>(batch->events.size())) {
+        pContext->ThrowNativeError("Invalid event index %d (count %d)", params[2], batch->events.size());
+        return 0;
+    }
+
+    pContext->StringToLocalUTF8(params[3], params[4], batch->events[params[2]].id.c_str(), nullptr);
+    return 1;
+}
@@ -0,0 +1,52 @@
+/**
+ * -----------------------------------------------------
+ * File        SequenceChannel.cpp
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "SequenceChannel.h"
+#include "SequenceThread.h"
+
+SequenceChannel::SequenceChannel() : queue(std::make_shared<SequenceQueue>()) {
+    SequenceThread* sequenceThread = new SequenceThread(this->queue);
+    sequenceThread->RunThread();
+}
+
+SequenceChannel::~SequenceChannel() {
+    // Pending requests are still sent and delivered
+    this->queue->Close();
+}
+
+void SequenceChannel::Send(const HTTPRequest* httpRequest, HTTPRequestMethod method) {
+    this->queue->Add(httpRequest->Clone(), method);
+}
+
+SequenceChannel* SequenceChannel::ConvertSequenceChannel(Handle_t hndl, IPluginContext* pContext) {
+    HandleError err;
+
+    SequenceChannel* channel = nullptr;
+    if ((err = sequenceChannelHandler.ReadHandle(hndl, pContext->GetIdentity(), &channel)) != HandleError_None) {
+        pContext->ThrowNativeError("Invalid sequence channel handle %x (error %d)", hndl, err);
+        return nullptr;
+    }
+
+    return channel;
+}
\ No newline at end of file
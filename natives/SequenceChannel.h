@@ -0,0 +1,47 @@
+/**
+ * -----------------------------------------------------
+ * File        SequenceChannel.h
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#ifndef _SYSTEM2_SEQUENCE_CHANNEL_H_
+#define _SYSTEM2_SEQUENCE_CHANNEL_H_
+
+#include "extension.h"
+#include "HTTPRequest.h"
+#include "SequenceQueue.h"
+#include "SequenceChannelHandler.h"
+
+class SequenceChannel {
+public:
+    std::shared_ptr<SequenceQueue> queue;
+
+    // Starts the thread of the channel, which finishes once the channel is deleted and all requests were delivered
+    SequenceChannel();
+    ~SequenceChannel();
+
+    // Sends a copy of the request
+    void Send(const HTTPRequest* httpRequest, HTTPRequestMethod method);
+
+    static SequenceChannel* ConvertSequenceChannel(Handle_t hndl, IPluginContext* pContext);
+};
+
+#endif
\ No newline at end of file
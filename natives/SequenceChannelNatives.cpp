@@ -0,0 +1,132 @@
+/**
+ * -----------------------------------------------------
+ * File        SequenceChannelNatives.cpp
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "Natives.h"
+#include "SequenceChannel.h"
+#include "SequenceChannelHandler.h"
+
+cell_t NativeSequenceChannel_SequenceChannel(IPluginContext* pContext, const cell_t* params) {
+    if (params[1] < 1 || params[1] > SEQUENCE_MAX_IN_FLIGHT) {
+        pContext->ThrowNativeError("Invalid max in flight %d", params[1]);
+        return BAD_HANDLE;
+    }
+
+    SequenceChannel* channel = new SequenceChannel();
+    channel->queue->SetMaxInFlight(params[1]);
+
+    Handle_t hndl = sequenceChannelHandler.CreateHandle(channel, pContext->GetIdentity());
+    if (hndl == BAD_HANDLE) {
+        delete channel;
+        pContext->ThrowNativeError("Couldn't create sequence channel handle");
+    }
+
+    return hndl;
+}
+
+cell_t NativeSequenceChannel_Send(IPluginContext* pContext, const cell_t* params) {
+    SequenceChannel* channel = SequenceChannel::ConvertSequenceChannel(params[1], pContext);
+    if (!channel) {
+        return 0;
+    }
+
+    HTTPRequest* request = Request::ConvertRequest<HTTPRequest>(params[2], pContext);
+    if (!request) {
+        return 0;
+    }
+
+    if (params[3] < METHOD_GET || params[3] > METHOD_HEAD) {
+        pContext->ThrowNativeError("Invalid request method %d", params[3]);
+        return 0;
+    }
+
+    if (request->url.empty()) {
+        pContext->ThrowNativeError("URL of the request is empty");
+        return 0;
+    }
+
+    if (request->eventCallbackFunction) {
+        pContext->ThrowNativeError("Event stream requests can't be sequenced");
+        return 0;
+    }
+
+    channel->Send(request, static_cast<HTTPRequestMethod>(params[3]));
+    return 1;
+}
+
+cell_t NativeSequenceChannel_GetMaxInFlight(IPluginContext* pContext, const cell_t* params) {
+    SequenceChannel* channel = SequenceChannel::ConvertSequenceChannel(params[1], pContext);
+    if (!channel) {
+        return 0;
+    }
+
+    return channel->queue->GetMaxInFlight();
+}
+
+cell_t NativeSequenceChannel_SetMaxInFlight(IPluginContext* pContext, const cell_t* params) {
+    SequenceChannel* channel = SequenceChannel::ConvertSequenceChannel(params[1], pContext);
+    if (!channel) {
+        return 0;
+    }
+
+    if (params[2] < 1 || params[2] > SEQUENCE_MAX_IN_FLIGHT) {
+        pContext->ThrowNativeError("Invalid max in flight %d", params[2]);
+        return 0;
+    }
+
+    channel->queue->SetMaxInFlight(params[2]);
+    return 1;
+}
+
+cell_t NativeSequenceChannel_GetMaxRetries(IPluginContext* pContext, const cell_t* params) {
+    SequenceChannel* channel = SequenceChannel::ConvertSequenceChannel(params[1], pContext);
+    if (!channel) {
+        return 0;
+    }
+
+    return channel->queue->GetMaxRetries();
+}
+
+cell_t NativeSequenceChannel_SetMaxRetries(IPluginContext* pContext, const cell_t* params) {
+    SequenceChannel* channel = SequenceChannel::ConvertSequenceChannel(params[1], pContext);
+    if (!channel) {
+        return 0;
+    }
+
+    if (params[2] < 0) {
+        pContext->ThrowNativeError("Invalid max retries %d", params[2]);
+        return 0;
+    }
+
+    channel->queue->SetMaxRetries(params[2]);
+    return 1;
+}
+
+cell_t NativeSequenceChannel_GetPending(IPluginContext* pContext, const cell_t* params) {
+    SequenceChannel* channel = SequenceChannel::ConvertSequenceChannel(params[1], pContext);
+    if (!channel) {
+        return 0;
+    }
+
+    return static_cast<cell_t>(channel->queue->GetPending());
+}
\ No newline at end of file
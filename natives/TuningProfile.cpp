@@ -0,0 +1,89 @@
+/**
+ * -----------------------------------------------------
+ * File        TuningProfile.cpp
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "TuningProfile.h"
+
+TuningProfile::TuningProfile(TuningPreset preset) :
+    noDelay(true), keepAliveIdle(0), keepAliveInterval(0), fastOpen(false), expectContinue(true),
+    lowSpeedLimit(0), lowSpeedTime(0), bufferSize(0) {
+    switch (preset) {
+        case TUNING_LOW_LATENCY:
+            // Keep connections warm and skip the 100-continue round trip
+            // There is no low speed limit, as event streams and long polls may be silent for a long time
+            this->keepAliveIdle = 30;
+            this->keepAliveInterval = 10;
+            this->fastOpen = true;
+            this->expectContinue = false;
+            break;
+        case TUNING_BULK:
+            // Large buffers for throughput, let the server reject uploads before they are sent
+            this->keepAliveIdle = 60;
+            this->keepAliveInterval = 30;
+            this->lowSpeedLimit = 1024;
+            this->lowSpeedTime = 60;
+            this->bufferSize = MAX_TUNING_BUFFER_SIZE;
+            break;
+        case TUNING_CUSTOM:
+            // Defaults of curl
+            break;
+    }
+}
+
+void TuningProfile::Apply(CURL* curl) const {
+    curl_easy_setopt(curl, CURLOPT_TCP_NODELAY, this->noDelay ? 1L : 0L);
+
+    if (this->keepAliveIdle > 0) {
+        curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+        curl_easy_setopt(curl, CURLOPT_TCP_KEEPIDLE, static_cast<long>(this->keepAliveIdle));
+
+        if (this->keepAliveInterval > 0) {
+            curl_easy_setopt(curl, CURLOPT_TCP_KEEPINTVL, static_cast<long>(this->keepAliveInterval));
+        }
+    }
+
+    if (this->fastOpen) {
+        curl_easy_setopt(curl, CURLOPT_TCP_FASTOPEN, 1L);
+    }
+
+    if (this->lowSpeedLimit > 0 && this->lowSpeedTime > 0) {
+        curl_easy_setopt(curl, CURLOPT_LOW_SPEED_LIMIT, static_cast<long>(this->lowSpeedLimit));
+        curl_easy_setopt(curl, CURLOPT_LOW_SPEED_TIME, static_cast<long>(this->lowSpeedTime));
+    }
+
+    if (this->bufferSize > 0) {
+        curl_easy_setopt(curl, CURLOPT_BUFFERSIZE, static_cast<long>(this->bufferSize));
+    }
+}
+
+TuningProfile* TuningProfile::ConvertTuningProfile(Handle_t hndl, IPluginContext* pContext) {
+    HandleError err;
+
+    TuningProfile* profile = nullptr;
+    if ((err = tuningProfileHandler.ReadHandle(hndl, pContext->GetIdentity(), &profile)) != HandleError_None) {
+        pContext->ThrowNativeError("Invalid tuning profile handle %x (error %d)", hndl, err);
+        return nullptr;
+    }
+
+    return profile;
+}
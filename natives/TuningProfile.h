@@ -0,0 +1,60 @@
+/**
+ * -----------------------------------------------------
+ * File        TuningProfile.h
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#ifndef _SYSTEM2_TUNING_PROFILE_H_
+#define _SYSTEM2_TUNING_PROFILE_H_
+
+#include "extension.h"
+#include "TuningProfileHandler.h"
+
+// Largest receive buffer libcurl accepts (CURL_MAX_READ_SIZE)
+#define MAX_TUNING_BUFFER_SIZE 524288
+#define MIN_TUNING_BUFFER_SIZE 1024
+
+enum TuningPreset {
+    TUNING_CUSTOM,
+    TUNING_LOW_LATENCY,
+    TUNING_BULK
+};
+
+class TuningProfile {
+public:
+    bool noDelay;
+    int keepAliveIdle;
+    int keepAliveInterval;
+    bool fastOpen;
+    bool expectContinue;
+    int lowSpeedLimit;
+    int lowSpeedTime;
+    int bufferSize;
+
+    explicit TuningProfile(TuningPreset preset);
+
+    // Applies the socket and transfer options to a curl handle
+    void Apply(CURL* curl) const;
+
+    static TuningProfile* ConvertTuningProfile(Handle_t hndl, IPluginContext* pContext);
+};
+
+#endif
@@ -0,0 +1,243 @@
+/**
+ * -----------------------------------------------------
+ * File        TuningProfileNatives.cpp
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "Natives.h"
+#include "Request.h"
+#include "TuningProfile.h"
+#include "TuningProfileHandler.h"
+
+cell_t NativeTuningProfile_TuningProfile(IPluginContext* pContext, const cell_t* params) {
+    if (params[1] < TUNING_CUSTOM || params[1] > TUNING_BULK) {
+        pContext->ThrowNativeError("Invalid tuning preset %d", params[1]);
+        return BAD_HANDLE;
+    }
+
+    TuningProfile* profile = new TuningProfile(static_cast<TuningPreset>(params[1]));
+
+    Handle_t hndl = tuningProfileHandler.CreateHandle(profile, pContext->GetIdentity());
+    if (hndl == BAD_HANDLE) {
+        delete profile;
+        pContext->ThrowNativeError("Couldn't create tuning profile handle");
+    }
+
+    return hndl;
+}
+
+cell_t NativeTuningProfile_GetNoDelay(IPluginContext* pContext, const cell_t* params) {
+    TuningProfile* profile = TuningProfile::ConvertTuningProfile(params[1], pContext);
+    if (!profile) {
+        return 0;
+    }
+
+    return profile->noDelay;
+}
+
+cell_t NativeTuningProfile_SetNoDelay(IPluginContext* pContext, const cell_t* params) {
+    TuningProfile* profile = TuningProfile::ConvertTuningProfile(params[1], pContext);
+    if (!profile) {
+        return 0;
+    }
+
+    profile->noDelay = params[2] != 0;
+    return 1;
+}
+
+cell_t NativeTuningProfile_GetKeepAliveIdle(IPluginContext* pContext, const cell_t* params) {
+    TuningProfile* profile = TuningProfile::ConvertTuningProfile(params[1], pContext);
+    if (!profile) {
+        return 0;
+    }
+
+    return profile->keepAliveIdle;
+}
+
+cell_t NativeTuningProfile_SetKeepAliveIdle(IPluginContext* pContext, const cell_t* params) {
+    TuningProfile* profile = TuningProfile::ConvertTuningProfile(params[1], pContext);
+    if (!profile) {
+        return 0;
+    }
+
+    if (params[2] < 0) {
+        pContext->ThrowNativeError("Invalid keep alive idle time %d", params[2]);
+        return 0;
+    }
+
+    profile->keepAliveIdle = params[2];
+    return 1;
+}
+
+cell_t NativeTuningProfile_GetKeepAliveInterval(IPluginContext* pContext, const cell_t* params) {
+    TuningProfile* profile = TuningProfile::ConvertTuningProfile(params[1], pContext);
+    if (!profile) {
+        return 0;
+    }
+
+    return profile->keepAliveInterval;
+}
+
+cell_t NativeTuningProfile_SetKeepAliveInterval(IPluginContext* pContext, const cell_t* params) {
+    TuningProfile* profile = TuningProfile::ConvertTuningProfile(params[1], pContext);
+    if (!profile) {
+        return 0;
+    }
+
+    if (params[2] < 0) {
+        pContext->ThrowNativeError("Invalid keep alive interval %d", params[2]);
+        return 0;
+    }
+
+    profile->keepAliveInterval = params[2];
+    return 1;
+}
+
+cell_t NativeTuningProfile_GetFastOpen(IPluginContext* pContext, const cell_t* params) {
+    TuningProfile* profile = TuningProfile::ConvertTuningProfile(params[1], pContext);
+    if (!profile) {
+        return 0;
+    }
+
+    return profile->fastOpen;
+}
+
+cell_t NativeTuningProfile_SetFastOpen(IPluginContext* pContext, const cell_t* params) {
+    TuningProfile* profile = TuningProfile::ConvertTuningProfile(params[1], pContext);
+    if (!profile) {
+        return 0;
+    }
+
+    profile->fastOpen = params[2] != 0;
+    return 1;
+}
+
+cell_t NativeTuningProfile_GetExpectContinue(IPluginContext* pContext, const cell_t* params) {
+    TuningProfile* profile = TuningProfile::ConvertTuningProfile(params[1], pContext);
+    if (!profile) {
+        return 0;
+    }
+
+    return profile->expectContinue;
+}
+
+cell_t NativeTuningProfile_SetExpectContinue(IPluginContext* pContext, const cell_t* params) {
+    TuningProfile* profile = TuningProfile::ConvertTuningProfile(params[1], pContext);
+    if (!profile) {
+        return 0;
+    }
+
+    profile->expectContinue = params[2] != 0;
+    return 1;
+}
+
+cell_t NativeTuningProfile_GetLowSpeedLimit(IPluginContext* pContext, const cell_t* params) {
+    TuningProfile* profile = TuningProfile::ConvertTuningProfile(params[1], pContext);
+    if (!profile) {
+        return 0;
+    }
+
+    return profile->lowSpeedLimit;
+}
+
+cell_t NativeTuningProfile_SetLowSpeedLimit(IPluginContext* pContext, const cell_t* params) {
+    TuningProfile* profile = TuningProfile::ConvertTuningProfile(params[1], pContext);
+    if (!profile) {
+        return 0;
+    }
+
+    if (params[2] < 0) {
+        pContext->ThrowNativeError("Invalid low speed limit %d", params[2]);
+        return 0;
+    }
+
+    profile->lowSpeedLimit = params[2];
+    return 1;
+}
+
+cell_t NativeTuningProfile_GetLowSpeedTime(IPluginContext* pContext, const cell_t* params) {
+    TuningProfile* profile = TuningProfile::ConvertTuningProfile(params[1], pContext);
+    if (!profile) {
+        return 0;
+    }
+
+    return profile->lowSpeedTime;
+}
+
+cell_t NativeTuningProfile_SetLowSpeedTime(IPluginContext* pContext, const cell_t* params) {
+    TuningProfile* profile = TuningProfile::ConvertTuningProfile(params[1], pContext);
+    if (!profile) {
+        return 0;
+    }
+
+    if (params[2] < 0) {
+        pContext->ThrowNativeError("Invalid low speed time %d", params[2]);
+        return 0;
+    }
+
+    profile->lowSpeedTime = params[2];
+    return 1;
+}
+
+cell_t NativeTuningProfile_GetBufferSize(IPluginContext* pContext, const cell_t* params) {
+    TuningProfile* profile = TuningProfile::ConvertTuningProfile(params[1], pContext);
+    if (!profile) {
+        return 0;
+    }
+
+    return profile->bufferSize;
+}
+
+cell_t NativeTuningProfile_SetBufferSize(IPluginContext* pContext, const cell_t* params) {
+    TuningProfile* profile = TuningProfile::ConvertTuningProfile(params[1], pContext);
+    if (!profile) {
+        return 0;
+    }
+
+    if (params[2] != 0 && (params[2] < MIN_TUNING_BUFFER_SIZE || params[2] > MAX_TUNING_BUFFER_SIZE)) {
+        pContext->ThrowNativeError("Invalid buffer size %d", params[2]);
+        return 0;
+    }
+
+    profile->bufferSize = params[2];
+    return 1;
+}
+
+cell_t NativeRequest_SetTuningProfile(IPluginContext* pContext, const cell_t* params) {
+    Request* request = Request::ConvertRequest<Request>(params[1], pContext);
+    if (!request) {
+        return 0;
+    }
+
+    if (params[2] == BAD_HANDLE) {
+        request->tuningProfile = nullptr;
+        return 1;
+    }
+
+    TuningProfile* profile = TuningProfile::ConvertTuningProfile(params[2], pContext);
+    if (!profile) {
+        return 0;
+    }
+
+    // Take a copy, so the profile can't be changed while a request thread uses it
+    request->tuningProfile = std::make_shared<const TuningProfile>(*profile);
+    return 1;
+}
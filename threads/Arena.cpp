@@ -0,0 +1,94 @@
+/**
+ * -----------------------------------------------------
+ * File        Arena.cpp
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "Arena.h"
+
+#include <algorithm>
+#include <stdlib.h>
+
+std::atomic<uint64_t> Arena::arenas(0);
+std::atomic<uint64_t> Arena::blocks(0);
+std::atomic<uint64_t> Arena::allocatedBytes(0);
+
+Arena::Arena() : head(nullptr), current(nullptr), available(0) {
+    Arena::arenas++;
+}
+
+Arena::~Arena() {
+    // Free all blocks at once
+    while (this->head) {
+        Block_t* next = this->head->next;
+        free(this->head);
+        this->head = next;
+    }
+}
+
+void Arena::AddBlock(size_t minSize) {
+    size_t size = this->head ? std::min<size_t>(this->head->size * 2, ARENA_MAX_BLOCK_SIZE) : ARENA_MIN_BLOCK_SIZE;
+
+    // Big allocations get an own block
+    if (size < minSize + sizeof(Block_t)) {
+        size = minSize + sizeof(Block_t);
+    }
+
+    Block_t* block = static_cast<Block_t*>(malloc(size));
+    if (!block) {
+        abort();
+    }
+
+    block->next = this->head;
+    block->size = size;
+
+    this->head = block;
+    this->current = reinterpret_cast<char*>(block + 1);
+    this->available = size - sizeof(Block_t);
+
+    Arena::blocks++;
+    Arena::allocatedBytes += size;
+}
+
+void* Arena::Allocate(size_t size, size_t alignment) {
+    size_t padding = (alignment - reinterpret_cast<uintptr_t>(this->current) % alignment) % alignment;
+
+    if (!this->current || padding + size > this->available) {
+        this->AddBlock(size + alignment);
+        padding = (alignment - reinterpret_cast<uintptr_t>(this->current) % alignment) % alignment;
+    }
+
+    char* memory = this->current + padding;
+    this->current = memory + size;
+    this->available -= padding + size;
+
+    return memory;
+}
+
+ArenaStats_t Arena::GetStats() {
+    return { Arena::arenas, Arena::blocks, Arena::allocatedBytes };
+}
+
+void Arena::ResetStats() {
+    Arena::arenas = 0;
+    Arena::blocks = 0;
+    Arena::allocatedBytes = 0;
+}
@@ -0,0 +1,115 @@
+/**
+ * -----------------------------------------------------
+ * File        Arena.h
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#ifndef _SYSTEM2_ARENA_H_
+#define _SYSTEM2_ARENA_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <scoped_allocator>
+#include <string>
+
+// Size of the first block of an arena, each further block doubles the size up to the maximum
+#define ARENA_MIN_BLOCK_SIZE 4096
+#define ARENA_MAX_BLOCK_SIZE 65536
+
+typedef struct {
+    uint64_t arenas;
+    uint64_t blocks;
+    uint64_t allocatedBytes;
+} ArenaStats_t;
+
+// Monotonic memory for the objects of a request, which is only freed all at once when the arena is destroyed
+class Arena {
+private:
+    static std::atomic<uint64_t> arenas;
+    static std::atomic<uint64_t> blocks;
+    static std::atomic<uint64_t> allocatedBytes;
+
+    typedef struct Block {
+        struct Block* next;
+        size_t size;
+    } Block_t;
+
+    Block_t* head;
+    char* current;
+    size_t available;
+
+    void AddBlock(size_t minSize);
+
+public:
+    Arena();
+    ~Arena();
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    void* Allocate(size_t size, size_t alignment);
+
+    static ArenaStats_t GetStats();
+    static void ResetStats();
+};
+
+// STL allocator which takes the memory from an arena
+template<class T>
+class ArenaAllocator {
+public:
+    typedef T value_type;
+
+    Arena* arena;
+
+    explicit ArenaAllocator(Arena* arena) : arena(arena) {}
+
+    template<class U>
+    ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.arena) {}
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(this->arena->Allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* p, size_t n) {
+        // Memory is freed with the arena
+    }
+
+    template<class U>
+    bool operator==(const ArenaAllocator<U>& other) const {
+        return this->arena == other.arena;
+    }
+
+    template<class U>
+    bool operator!=(const ArenaAllocator<U>& other) const {
+        return this->arena != other.arena;
+    }
+};
+
+typedef std::basic_string<char, std::char_traits<char>, ArenaAllocator<char>> ArenaString;
+
+typedef std::map<ArenaString, ArenaString, std::less<ArenaString>,
+                 std::scoped_allocator_adaptor<ArenaAllocator<std::pair<const ArenaString, ArenaString>>>> ArenaStringMap;
+
+#endif
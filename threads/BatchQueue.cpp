@@ -0,0 +1,208 @@
+/**
+ * -----------------------------------------------------
+ * File        BatchQueue.cpp
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "BatchQueue.h"
+
+#include <algorithm>
+
+BatchQueue::BatchQueue(BatchFraming framing)
+    : framing(framing), pendingBytes(0), maxRecords(BATCH_DEFAULT_RECORDS), maxBytes(BATCH_DEFAULT_BYTES), maxDelay(BATCH_DEFAULT_DELAY),
+    flushRequested(false), closed(false), users(0) {};
+
+bool BatchQueue::Add(const std::string& record, std::shared_ptr<CallbackFunction_t> callbackFunction, int data) {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (this->pendingBytes + record.size() > BATCH_MAX_PENDING_BYTES) {
+        return false;
+    }
+
+    // The delay starts with the first record of a batch
+    if (this->records.empty()) {
+        this->firstRecordTime = std::chrono::steady_clock::now();
+    }
+
+    this->records.push_back({ record, callbackFunction, data });
+    this->pendingBytes += record.size();
+
+    // Only wake up the batch thread if it has something to do
+    if (this->records.size() >= static_cast<size_t>(this->maxRecords) || this->pendingBytes >= static_cast<size_t>(this->maxBytes)) {
+        this->condition.notify_one();
+    }
+
+    return true;
+}
+
+void BatchQueue::Flush() {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (!this->records.empty()) {
+        this->flushRequested = true;
+        this->condition.notify_one();
+    }
+}
+
+void BatchQueue::Close() {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->closed = true;
+    this->condition.notify_one();
+}
+
+bool BatchQueue::IsClosed() {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->closed && this->records.empty();
+}
+
+bool BatchQueue::WaitForBatch(int milliseconds, std::vector<BatchRecord_t>& batch, std::string& body) {
+    std::unique_lock<std::mutex> lock(this->mutex);
+
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    if (!this->IsDue(now)) {
+        std::chrono::steady_clock::time_point until = now + std::chrono::milliseconds(milliseconds);
+        if (!this->records.empty()) {
+            until = std::min(until, this->firstRecordTime + std::chrono::milliseconds(this->maxDelay));
+        }
+
+        this->condition.wait_until(lock, until);
+        if (!this->IsDue(std::chrono::steady_clock::now())) {
+            return false;
+        }
+    }
+
+    this->TakeBatch(batch);
+    lock.unlock();
+
+    // Build the body without blocking new records
+    this->BuildBody(batch, body);
+    return true;
+}
+
+bool BatchQueue::TakeRemaining(std::vector<BatchRecord_t>& batch, std::string& body) {
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        if (this->records.empty()) {
+            return false;
+        }
+
+        this->TakeBatch(batch);
+    }
+
+    this->BuildBody(batch, body);
+    return true;
+}
+
+bool BatchQueue::IsDue(std::chrono::steady_clock::time_point now) {
+    if (this->records.empty()) {
+        return false;
+    }
+
+    return this->flushRequested || this->closed ||
+        this->records.size() >= static_cast<size_t>(this->maxRecords) ||
+        this->pendingBytes >= static_cast<size_t>(this->maxBytes) ||
+        now >= this->firstRecordTime + std::chrono::milliseconds(this->maxDelay);
+}
+
+void BatchQueue::TakeBatch(std::vector<BatchRecord_t>& batch) {
+    batch.clear();
+
+    // Records which don't fit into the batch stay for the next one
+    size_t bytes = 0;
+    while (!this->records.empty() && batch.size() < static_cast<size_t>(this->maxRecords) &&
+           (batch.empty() || bytes + this->records.front().record.size() <= static_cast<size_t>(this->maxBytes))) {
+        bytes += this->records.front().record.size();
+        batch.push_back(std::move(this->records.front()));
+        this->records.pop_front();
+    }
+
+    // Left over records are already waiting, so they are due again right away
+    this->pendingBytes -= bytes;
+    this->flushRequested = this->flushRequested && !this->records.empty();
+}
+
+void BatchQueue::BuildBody(const std::vector<BatchRecord_t>& batch, std::string& body) {
+    size_t size = batch.size() + 2;
+    for (const BatchRecord_t& record : batch) {
+        size += record.record.size();
+    }
+
+    body.clear();
+    body.reserve(size);
+
+    if (this->framing == BATCH_JSON_ARRAY) {
+        body.push_back('[');
+        for (size_t i = 0; i < batch.size(); i++) {
+            if (i > 0) {
+                body.push_back(',');
+            }
+
+            body.append(batch[i].record);
+        }
+        body.push_back(']');
+    } else {
+        for (const BatchRecord_t& record : batch) {
+            body.append(record.record);
+            body.push_back('\n');
+        }
+    }
+}
+
+BatchFraming BatchQueue::GetFraming() const {
+    // The framing never changes, so no lock is needed
+    return this->framing;
+}
+
+size_t BatchQueue::GetPending() {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->records.size();
+}
+
+int BatchQueue::GetMaxRecords() {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->maxRecords;
+}
+
+void BatchQueue::SetMaxRecords(int maxRecords) {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->maxRecords = maxRecords;
+    this->condition.notify_one();
+}
+
+int BatchQueue::GetMaxBytes() {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->maxBytes;
+}
+
+void BatchQueue::SetMaxBytes(int maxBytes) {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->maxBytes = maxBytes;
+    this->condition.notify_one();
+}
+
+int BatchQueue::GetMaxDelay() {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->maxDelay;
+}
+
+void BatchQueue::SetMaxDelay(int maxDelay) {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->maxDelay = maxDelay;
+    this->condition.notify_one();
+}
\ No newline at end of file
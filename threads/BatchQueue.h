@@ -0,0 +1,104 @@
+/**
+ * -----------------------------------------------------
+ * File        BatchQueue.h
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#ifndef _SYSTEM2_BATCH_QUEUE_H_
+#define _SYSTEM2_BATCH_QUEUE_H_
+
+#include "BatchFraming.h"
+#include "CallbackFunction.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Default limits after which a batch is sent
+#define BATCH_DEFAULT_RECORDS 100
+#define BATCH_DEFAULT_BYTES 65536
+#define BATCH_DEFAULT_DELAY 1000
+
+// Records above this size are rejected until the pending batches were sent
+#define BATCH_MAX_PENDING_BYTES (16 * 1024 * 1024)
+
+typedef struct {
+    std::string record;
+    std::shared_ptr<CallbackFunction_t> callbackFunction;
+    int data;
+} BatchRecord_t;
+
+/**
+ * Records of a batch channel which are shared between the game thread and the batch thread.
+ * Channels with the same URL, framing and compression share one queue.
+ */
+class BatchQueue {
+private:
+    std::mutex mutex;
+    std::condition_variable condition;
+
+    BatchFraming framing;
+    std::deque<BatchRecord_t> records;
+    size_t pendingBytes;
+    std::chrono::steady_clock::time_point firstRecordTime;
+
+    int maxRecords;
+    int maxBytes;
+    int maxDelay;
+    bool flushRequested;
+    bool closed;
+
+    bool IsDue(std::chrono::steady_clock::time_point now);
+    void TakeBatch(std::vector<BatchRecord_t>& batch);
+    void BuildBody(const std::vector<BatchRecord_t>& batch, std::string& body);
+
+public:
+    // Number of channel handles using the queue, only used on the game thread
+    int users;
+
+    explicit BatchQueue(BatchFraming framing);
+
+    // Returns false if too many records are pending
+    bool Add(const std::string& record, std::shared_ptr<CallbackFunction_t> callbackFunction, int data);
+    void Flush();
+    void Close();
+    bool IsClosed();
+
+    // Waits until a batch is due, returns false if none is due after the timeout
+    bool WaitForBatch(int milliseconds, std::vector<BatchRecord_t>& batch, std::string& body);
+
+    // Takes the next batch regardless of the limits, returns false if no records are pending
+    bool TakeRemaining(std::vector<BatchRecord_t>& batch, std::string& body);
+
+    BatchFraming GetFraming() const;
+    size_t GetPending();
+    int GetMaxRecords();
+    void SetMaxRecords(int maxRecords);
+    int GetMaxBytes();
+    void SetMaxBytes(int maxBytes);
+    int GetMaxDelay();
+    void SetMaxDelay(int maxDelay);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,182 @@
+/**
+ * -----------------------------------------------------
+ * File        BatchThread.cpp
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "BatchThread.h"
+#include "BatchCallback.h"
+
+#include <chrono>
+#include <map>
+#include <zlib.h>
+
+BatchThread::BatchThread(HTTPRequest* httpRequest, std::shared_ptr<BatchQueue> queue, bool compress)
+    : HTTPRequestThread(httpRequest, METHOD_POST), queue(queue), compress(compress) {};
+
+BatchThread::~BatchThread() {
+    // The thread uses the request until it is finished
+    this->TerminateThread();
+    delete this->httpRequest;
+}
+
+void BatchThread::Run() {
+    CURL* curl = curl_easy_init();
+    if (!curl) {
+        return;
+    }
+
+    // Describe the body if the request doesn't do it already
+    bool hasContentType = false;
+    for (auto it = this->httpRequest->headers.begin(); it != this->httpRequest->headers.end(); ++it) {
+        if (this->EqualsIgnoreCase(it->first.c_str(), "Content-Type")) {
+            hasContentType = true;
+        }
+    }
+    if (!hasContentType) {
+        this->httpRequest->headers["Content-Type"] = this->queue->GetFraming() == BATCH_JSON_ARRAY ? "application/json" : "application/x-ndjson";
+    }
+    if (this->compress) {
+        this->httpRequest->headers["Content-Encoding"] = "gzip";
+    }
+
+    // Everything except the body is the same for every batch, so the connection can be reused
+    this->ApplyOptions(curl);
+    struct curl_slist* headers = this->ApplyHTTPOptions(curl);
+    curl_easy_setopt(curl, CURLOPT_POST, 1L);
+
+    // The response content is not passed to the callbacks
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, BatchThread::DiscardData);
+
+    std::vector<BatchRecord_t> batch;
+    std::string body;
+    while (!this->ShouldTerminate()) {
+        if (this->queue->WaitForBatch(BATCH_POLL_INTERVAL, batch, body)) {
+            this->Send(curl, batch, body);
+        } else if (this->queue->IsClosed()) {
+            break;
+        }
+    }
+
+    // Don't let an unavailable service delay the unload, all remaining batches share the time and the first failure drops the rest
+    bool isUnloading = this->ShouldTerminate();
+    bool dropRemaining = false;
+    std::chrono::steady_clock::time_point unloadDeadline = std::chrono::steady_clock::now() + std::chrono::seconds(BATCH_UNLOAD_TIMEOUT);
+
+    // Send the records which are left after the channel was closed
+    while (this->queue->TakeRemaining(batch, body)) {
+        if (isUnloading) {
+            long remaining = static_cast<long>(std::chrono::duration_cast<std::chrono::milliseconds>(unloadDeadline - std::chrono::steady_clock::now()).count());
+            if (dropRemaining || remaining <= 0) {
+                this->Report(batch, "Batch was dropped while unloading", 0);
+                continue;
+            }
+
+            curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, remaining);
+        }
+
+        if (!this->Send(curl, batch, body) && isUnloading) {
+            dropRemaining = true;
+        }
+    }
+
+    curl_easy_cleanup(curl);
+    if (headers) {
+        curl_slist_free_all(headers);
+    }
+}
+
+bool BatchThread::Send(CURL* curl, std::vector<BatchRecord_t>& batch, std::string& body) {
+    std::string compressed;
+    if (this->compress && BatchThread::Compress(body, compressed)) {
+        body.swap(compressed);
+    }
+
+    char errorBuffer[CURL_ERROR_SIZE + 1];
+    errorBuffer[0] = '\0';
+    curl_easy_setopt(curl, CURLOPT_ERRORBUFFER, errorBuffer);
+    curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, static_cast<long>(body.size()));
+    curl_easy_setopt(curl, CURLOPT_POSTFIELDS, body.c_str());
+
+    CURLcode result = curl_easy_perform(curl);
+    curl_easy_setopt(curl, CURLOPT_ERRORBUFFER, nullptr);
+
+    long statusCode = 0;
+    std::string error;
+    if (result == CURLE_OK) {
+        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &statusCode);
+        if (statusCode < 200 || statusCode >= 300) {
+            error = "HTTP status " + std::to_string(statusCode);
+        }
+    } else {
+        error = strlen(errorBuffer) ? errorBuffer : curl_easy_strerror(result);
+    }
+
+    this->Report(batch, error, statusCode);
+    return error.empty();
+}
+
+void BatchThread::Report(std::vector<BatchRecord_t>& batch, const std::string& error, long statusCode) {
+    // All records of a callback function are reported with a single callback
+    std::map<CallbackFunction_t*, std::shared_ptr<BatchCallback>> callbacks;
+    for (const BatchRecord_t& record : batch) {
+        if (!record.callbackFunction) {
+            continue;
+        }
+
+        std::shared_ptr<BatchCallback>& callback = callbacks[record.callbackFunction.get()];
+        if (!callback) {
+            callback = std::make_shared<BatchCallback>(record.callbackFunction, error.empty(), error, static_cast<int>(statusCode),
+                                                       static_cast<int>(batch.size()));
+        }
+
+        callback->data.push_back(record.data);
+    }
+
+    for (auto it = callbacks.begin(); it != callbacks.end(); ++it) {
+        system2Extension.AppendCallback(it->second);
+    }
+}
+
+size_t BatchThread::DiscardData(char* ptr, size_t size, size_t nmemb, void* userdata) {
+    return size * nmemb;
+}
+
+bool BatchThread::Compress(const std::string& input, std::string& output) {
+    z_stream stream = z_stream();
+
+    // Add 16 to the window bits to get a gzip header
+    if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        return false;
+    }
+
+    output.resize(deflateBound(&stream, static_cast<uLong>(input.size())));
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+    stream.avail_in = static_cast<uInt>(input.size());
+    stream.next_out = reinterpret_cast<Bytef*>(&output[0]);
+    stream.avail_out = static_cast<uInt>(output.size());
+
+    int result = deflate(&stream, Z_FINISH);
+    output.resize(stream.total_out);
+    deflateEnd(&stream);
+
+    return result == Z_STREAM_END;
+}
\ No newline at end of file
@@ -0,0 +1,60 @@
+/**
+ * -----------------------------------------------------
+ * File        BatchThread.h
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#ifndef _SYSTEM2_BATCH_THREAD_H_
+#define _SYSTEM2_BATCH_THREAD_H_
+
+#include "HTTPRequestThread.h"
+#include "BatchQueue.h"
+
+// The batch thread checks for due batches and termination at least this often in milliseconds
+#define BATCH_POLL_INTERVAL 100
+
+// Total time in seconds for sending the last records while the extension unloads
+#define BATCH_UNLOAD_TIMEOUT 5
+
+// Sends the batches of a queue over a single connection
+class BatchThread : public HTTPRequestThread {
+private:
+    std::shared_ptr<BatchQueue> queue;
+    bool compress;
+
+    // Returns false if the batch couldn't be delivered
+    bool Send(CURL* curl, std::vector<BatchRecord_t>& batch, std::string& body);
+    void Report(std::vector<BatchRecord_t>& batch, const std::string& error, long statusCode);
+
+    static size_t DiscardData(char* ptr, size_t size, size_t nmemb, void* userdata);
+
+public:
+    // Takes ownership of the request, which is used as template for every batch
+    BatchThread(HTTPRequest* httpRequest, std::shared_ptr<BatchQueue> queue, bool compress);
+    ~BatchThread();
+
+    static bool Compress(const std::string& input, std::string& output);
+
+protected:
+    virtual void Run();
+};
+
+#endif
\ No newline at end of file
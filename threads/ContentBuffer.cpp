@@ -0,0 +1,319 @@
+/**
+ * -----------------------------------------------------
+ * File        ContentBuffer.cpp
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#if !defined _WIN32 && !defined _WIN64
+// Positioned reads have to reach beyond 2 GB in 32 bit builds
+#define _FILE_OFFSET_BITS 64
+#endif
+
+#include "ContentBuffer.h"
+#include "FileIO.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined _WIN32 || defined _WIN64
+#include <windows.h>
+#include <fcntl.h>
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+#endif
+
+std::atomic<uint64_t> ContentBuffer::buffers(0);
+std::atomic<uint64_t> ContentBuffer::allocations(0);
+std::atomic<uint64_t> ContentBuffer::allocatedBytes(0);
+std::atomic<uint64_t> ContentBuffer::spilled(0);
+
+std::mutex ContentBuffer::directoryMutex;
+std::string ContentBuffer::spillDirectory;
+
+ContentBuffer::ContentBuffer(int memoryLimit) : file(nullptr), length(0), memoryLimit(memoryLimit) {
+    ContentBuffer::buffers++;
+}
+
+ContentBuffer::~ContentBuffer() {
+    // The temporary file is removed automatically when it's closed
+    if (this->file) {
+        fclose(this->file);
+    }
+}
+
+void ContentBuffer::AddChunk(size_t size) {
+    this->chunks.emplace_back();
+    this->chunks.back().reserve(size);
+
+    ContentBuffer::allocations++;
+    ContentBuffer::allocatedBytes += size;
+}
+
+bool ContentBuffer::Spill() {
+    this->file = ContentBuffer::OpenSpillFile();
+    if (!this->file) {
+        return false;
+    }
+
+    for (auto it = this->chunks.begin(); it != this->chunks.end(); ++it) {
+        if (fwrite(it->data(), 1, it->size(), this->file) != it->size()) {
+            fclose(this->file);
+            this->file = nullptr;
+            return false;
+        }
+    }
+
+    // Release the memory completely
+    std::vector<std::string>().swap(this->chunks);
+    ContentBuffer::spilled++;
+
+    return true;
+}
+
+FILE* ContentBuffer::OpenSpillFile() {
+    std::string directory = ContentBuffer::GetSpillDirectory();
+    if (directory.empty()) {
+        return tmpfile();
+    }
+
+    FILE* file = ContentBuffer::CreateUnlinkedFile(directory);
+    if (!file && FileIO::MakeDirectories(directory)) {
+        file = ContentBuffer::CreateUnlinkedFile(directory);
+    }
+
+    // The temporary directory of the system is better than keeping everything in memory
+    return file ? file : tmpfile();
+}
+
+FILE* ContentBuffer::CreateUnlinkedFile(const std::string& directory) {
+#if defined _WIN32 || defined _WIN64
+    char path[MAX_PATH];
+    if (!GetTempFileNameA(directory.c_str(), "s2", 0, path)) {
+        return nullptr;
+    }
+
+    // The file is removed by Windows when it's closed
+    HANDLE handle = CreateFileA(path, GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS,
+                                FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE, nullptr);
+    if (handle == INVALID_HANDLE_VALUE) {
+        DeleteFileA(path);
+        return nullptr;
+    }
+
+    int fd = _open_osfhandle(reinterpret_cast<intptr_t>(handle), _O_RDWR | _O_BINARY);
+    if (fd < 0) {
+        CloseHandle(handle);
+        return nullptr;
+    }
+
+    FILE* file = _fdopen(fd, "w+b");
+    if (!file) {
+        _close(fd);
+    }
+
+    return file;
+#else
+    int fd = -1;
+
+#if defined O_TMPFILE
+    // The file never gets a name, so nothing is left behind after a crash
+    fd = open(directory.c_str(), O_TMPFILE | O_RDWR | O_EXCL | O_CLOEXEC, 0600);
+#endif
+
+    if (fd < 0) {
+        std::string path = directory + "/system2_XXXXXX";
+#if defined __linux__
+        fd = mkostemp(&path[0], O_CLOEXEC);
+#else
+        fd = mkstemp(&path[0]);
+#endif
+        if (fd < 0) {
+            return nullptr;
+        }
+
+        unlink(path.c_str());
+    }
+
+    FILE* file = fdopen(fd, "w+b");
+    if (!file) {
+        close(fd);
+    }
+
+    return file;
+#endif
+}
+
+void ContentBuffer::Reserve(uint64_t expectedLength) {
+    if (this->file || this->length > 0) {
+        return;
+    }
+
+    if (this->memoryLimit >= 0 && expectedLength > static_cast<uint64_t>(this->memoryLimit)) {
+        // Content will not fit into memory, so write it to the file right away
+        if (!this->Spill()) {
+            this->memoryLimit = -1;
+        } else {
+            return;
+        }
+    }
+
+    this->AddChunk(static_cast<size_t>(std::min<uint64_t>(expectedLength, CONTENT_MAX_RESERVE)));
+}
+
+bool ContentBuffer::Append(const char* data, size_t size) {
+    if (!this->file && this->memoryLimit >= 0 && this->length + size > static_cast<uint64_t>(this->memoryLimit)) {
+        if (!this->Spill()) {
+            // Keep the content in memory if no temporary file could be created
+            this->memoryLimit = -1;
+        }
+    }
+
+    if (this->file) {
+        if (fwrite(data, 1, size, this->file) != size) {
+            return false;
+        }
+
+        this->length += size;
+        return true;
+    }
+
+    this->length += size;
+
+    while (size > 0) {
+        // Start a new chunk if the last one is full
+        if (this->chunks.empty()) {
+            this->AddChunk(CONTENT_MIN_CHUNK_SIZE);
+        } else if (this->chunks.back().size() == this->chunks.back().capacity()) {
+            this->AddChunk(std::min<size_t>(this->chunks.back().capacity() * 2, CONTENT_MAX_CHUNK_SIZE));
+        }
+
+        std::string& chunk = this->chunks.back();
+        size_t part = std::min(size, chunk.capacity() - chunk.size());
+
+        chunk.append(data, part);
+        data += part;
+        size -= part;
+    }
+
+    return true;
+}
+
+std::string ContentBuffer::Read(uint64_t offset, size_t size) {
+    if (offset >= this->length) {
+        return std::string();
+    }
+
+    if (size > this->length - offset) {
+        size = static_cast<size_t>(this->length - offset);
+    }
+
+    std::string output(size, '\0');
+    output.resize(this->Read(offset, &output[0], size));
+
+    return output;
+}
+
+size_t ContentBuffer::Read(uint64_t offset, char* buffer, size_t size) {
+    if (offset >= this->length) {
+        return 0;
+    }
+
+    if (size > this->length - offset) {
+        size = static_cast<size_t>(this->length - offset);
+    }
+
+    if (!this->file) {
+        size_t read = 0;
+
+        // Collect the requested part from the chunks, content in memory always fits into size_t
+        size_t chunkOffset = static_cast<size_t>(offset);
+        for (auto it = this->chunks.begin(); it != this->chunks.end() && read < size; ++it) {
+            if (chunkOffset >= it->size()) {
+                chunkOffset -= it->size();
+                continue;
+            }
+
+            size_t part = std::min(it->size() - chunkOffset, size - read);
+            memcpy(buffer + read, it->data() + chunkOffset, part);
+            read += part;
+            chunkOffset = 0;
+        }
+
+        return read;
+    }
+
+    // Write buffered data before reading from the file
+    fflush(this->file);
+
+    size_t read = 0;
+
+#if defined _WIN32 || defined _WIN64
+    if (_fseeki64(this->file, static_cast<__int64>(offset), SEEK_SET) == 0) {
+        read = fread(buffer, 1, size, this->file);
+    }
+
+    // Further appends have to be at the end of the file
+    _fseeki64(this->file, 0, SEEK_END);
+#else
+    while (read < size) {
+        ssize_t result = pread(fileno(this->file), buffer + read, size - read, static_cast<off_t>(offset + read));
+        if (result <= 0) {
+            break;
+        }
+
+        read += result;
+    }
+#endif
+
+    return read;
+}
+
+uint64_t ContentBuffer::Length() const {
+    return this->length;
+}
+
+bool ContentBuffer::IsSpilled() const {
+    return this->file != nullptr;
+}
+
+ContentBufferStats_t ContentBuffer::GetStats() {
+    return { ContentBuffer::buffers, ContentBuffer::allocations, ContentBuffer::allocatedBytes, ContentBuffer::spilled };
+}
+
+void ContentBuffer::ResetStats() {
+    ContentBuffer::buffers = 0;
+    ContentBuffer::allocations = 0;
+    ContentBuffer::allocatedBytes = 0;
+    ContentBuffer::spilled = 0;
+}
+
+void ContentBuffer::SetSpillDirectory(const std::string& directory) {
+    std::lock_guard<std::mutex> lock(ContentBuffer::directoryMutex);
+    ContentBuffer::spillDirectory = directory;
+}
+
+std::string ContentBuffer::GetSpillDirectory() {
+    std::lock_guard<std::mutex> lock(ContentBuffer::directoryMutex);
+    return ContentBuffer::spillDirectory;
+}
@@ -0,0 +1,101 @@
+/**
+ * -----------------------------------------------------
+ * File        ContentBuffer.h
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#ifndef _SYSTEM2_CONTENT_BUFFER_H_
+#define _SYSTEM2_CONTENT_BUFFER_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Size of the content chunks if the length of the content is unknown, each chunk doubles the size up to the maximum
+#define CONTENT_MIN_CHUNK_SIZE 16384
+#define CONTENT_MAX_CHUNK_SIZE 1048576
+
+// Maximum size which is reserved up front, so a wrong content length can't allocate too much memory
+#define CONTENT_MAX_RESERVE 67108864
+
+typedef struct {
+    uint64_t buffers;
+    uint64_t allocations;
+    uint64_t allocatedBytes;
+    uint64_t spilled;
+} ContentBufferStats_t;
+
+// Content of a response, which is kept in memory up to a limit and moved to an unlinked file in the spill directory afterwards.
+// In memory the content is stored in chunks, so it never has to be reallocated and copied while growing.
+class ContentBuffer {
+private:
+    static std::atomic<uint64_t> buffers;
+    static std::atomic<uint64_t> allocations;
+    static std::atomic<uint64_t> allocatedBytes;
+    static std::atomic<uint64_t> spilled;
+
+    static std::mutex directoryMutex;
+    static std::string spillDirectory;
+
+    std::vector<std::string> chunks;
+    FILE* file;
+    uint64_t length;
+    int memoryLimit;
+
+    void AddChunk(size_t size);
+    bool Spill();
+
+    static FILE* OpenSpillFile();
+    static FILE* CreateUnlinkedFile(const std::string& directory);
+
+public:
+    // Negative memory limit keeps all content in memory
+    explicit ContentBuffer(int memoryLimit);
+    ~ContentBuffer();
+
+    ContentBuffer(const ContentBuffer&) = delete;
+    ContentBuffer& operator=(const ContentBuffer&) = delete;
+
+    // Prepares the buffer for content with the expected length
+    void Reserve(uint64_t expectedLength);
+    bool Append(const char* data, size_t size);
+
+    // Reads at most size bytes beginning at offset
+    std::string Read(uint64_t offset, size_t size);
+
+    // Copies at most size bytes beginning at offset into the buffer and returns the number of copied bytes
+    size_t Read(uint64_t offset, char* buffer, size_t size);
+
+    uint64_t Length() const;
+    bool IsSpilled() const;
+
+    static ContentBufferStats_t GetStats();
+    static void ResetStats();
+
+    // Directory of the files for content which doesn't fit into memory, empty for the temporary directory of the system
+    static void SetSpillDirectory(const std::string& directory);
+    static std::string GetSpillDirectory();
+};
+
+#endif
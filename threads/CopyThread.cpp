@@ -24,12 +24,15 @@
 
 #include "CopyThread.h"
 #include "CopyCallback.h"
-
-#include <fstream>
+#include "FileIO.h"
 
 CopyThread::CopyThread(std::string from, std::string to, int data, std::shared_ptr<CallbackFunction_t> callbackFunction)
     : Thread(), from(from), to(to), data(data), callbackFunction(callbackFunction) {}
 
+ThreadCategory CopyThread::GetCategory() const {
+    return THREAD_FILE;
+}
+
 void CopyThread::Run() {
     char filePath[PLATFORM_MAX_PATH + 1];
     char copyPath[PLATFORM_MAX_PATH + 1];
@@ -38,28 +41,8 @@ void CopyThread::Run() {
     g_pSM->BuildPath(Path_Game, filePath, sizeof(filePath), this->from.c_str());
     g_pSM->BuildPath(Path_Game, copyPath, sizeof(copyPath), this->to.c_str());
 
-    // Open both files
-    std::ifstream file1(filePath, std::ifstream::in | std::ifstream::binary);
-    std::ofstream file2(copyPath, std::ofstream::out | std::ofstream::trunc | std::ofstream::binary);
-
-    bool success;
-    if (file1.bad() || file2.bad() || !file1.is_open() || !file2.is_open()) {
-        // Couldn't open a file
-        success = false;
-    } else {
-        // Copy the file
-        file2 << file1.rdbuf();
-        success = true;
-    }
-
-    // Close the files
-    if (file1.is_open()) {
-        file1.close();
-    }
-
-    if (file2.is_open()) {
-        file2.close();
-    }
+    // Copy the file, fails if a file couldn't be opened or written
+    bool success = FileIO::Copy(filePath, copyPath);
 
     // Add callback to queue
     system2Extension.AppendCallback(std::make_shared<CopyCallback>(this->callbackFunction, success, this->from, this->to, this->data));
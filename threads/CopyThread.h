@@ -41,6 +41,7 @@ public:
 
 protected:
     void Run();
+    ThreadCategory GetCategory() const;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,65 @@
+/**
+ * -----------------------------------------------------
+ * File        CurlHandlePool.cpp
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "CurlHandlePool.h"
+
+CurlHandlePool::CurlHandlePool(CURL* templateHandle, struct curl_slist* headers)
+    : templateHandle(templateHandle), headers(headers) {};
+
+CurlHandlePool::~CurlHandlePool() {
+    for (CURL* curl : this->idleHandles) {
+        curl_easy_cleanup(curl);
+    }
+
+    // Handles only reference the headers, so they have to be freed last
+    curl_easy_cleanup(this->templateHandle);
+    if (this->headers) {
+        curl_slist_free_all(this->headers);
+    }
+}
+
+CURL* CurlHandlePool::Acquire() {
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    if (!this->idleHandles.empty()) {
+        CURL* curl = this->idleHandles.back();
+        this->idleHandles.pop_back();
+
+        return curl;
+    }
+
+    return curl_easy_duphandle(this->templateHandle);
+}
+
+void CurlHandlePool::Release(CURL* curl) {
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        if (this->idleHandles.size() < MAX_IDLE_HANDLES) {
+            this->idleHandles.push_back(curl);
+            return;
+        }
+    }
+
+    curl_easy_cleanup(curl);
+}
\ No newline at end of file
@@ -0,0 +1,60 @@
+/**
+ * -----------------------------------------------------
+ * File        CurlHandlePool.h
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#ifndef _SYSTEM2_CURL_HANDLE_POOL_H_
+#define _SYSTEM2_CURL_HANDLE_POOL_H_
+
+#include "extension.h"
+
+#include <mutex>
+#include <vector>
+
+// Max number of idle handles kept per pool
+#define MAX_IDLE_HANDLES 8
+
+// Pool of curl handles which are duplicated from a prepared template handle.
+// Idle handles keep their connection cache, so following transfers can reuse open connections.
+class CurlHandlePool {
+private:
+    CURL* templateHandle;
+    struct curl_slist* headers;
+    std::vector<CURL*> idleHandles;
+    std::mutex mutex;
+
+public:
+    // Takes ownership of the template handle and the headers it uses
+    CurlHandlePool(CURL* templateHandle, struct curl_slist* headers);
+    ~CurlHandlePool();
+
+    CurlHandlePool(const CurlHandlePool&) = delete;
+    CurlHandlePool& operator=(const CurlHandlePool&) = delete;
+
+    // Gets an idle handle or duplicates the template, returns nullptr on failure
+    CURL* Acquire();
+
+    // Gives a handle back to the pool after its transfer has finished
+    void Release(CURL* curl);
+};
+
+#endif
\ No newline at end of file
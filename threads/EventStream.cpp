@@ -0,0 +1,85 @@
+/**
+ * -----------------------------------------------------
+ * File        EventStream.cpp
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "EventStream.h"
+
+#include <iterator>
+
+EventStream::EventStream(size_t maxBacklog, size_t maxBacklogSize)
+    : backlogSize(0), maxBacklog(maxBacklog), maxBacklogSize(maxBacklogSize), dropped(0), callbackPending(false), closed(false) {}
+
+static size_t GetEventSize(const StreamEvent_t& event) {
+    return event.type.size() + event.id.size() + event.data.size();
+}
+
+bool EventStream::Push(std::vector<StreamEvent_t>& events) {
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    for (auto it = events.begin(); it != events.end(); ++it) {
+        this->backlogSize += GetEventSize(*it);
+        this->backlog.push_back(std::move(*it));
+    }
+
+    // Drop the oldest events if the game thread can't keep up
+    while (!this->backlog.empty() && (this->backlog.size() > this->maxBacklog || this->backlogSize > this->maxBacklogSize)) {
+        this->backlogSize -= GetEventSize(this->backlog.front());
+        this->backlog.pop_front();
+        this->dropped++;
+    }
+
+    if (this->callbackPending || this->closed || this->backlog.empty()) {
+        return false;
+    }
+
+    // Only one callback is queued at a time, it delivers everything collected until it fires
+    this->callbackPending = true;
+    return true;
+}
+
+int EventStream::TakeBatch(std::vector<StreamEvent_t>& batch) {
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    batch.assign(std::make_move_iterator(this->backlog.begin()), std::make_move_iterator(this->backlog.end()));
+    this->backlog.clear();
+    this->backlogSize = 0;
+    this->callbackPending = false;
+
+    int dropped = this->dropped;
+    this->dropped = 0;
+
+    return dropped;
+}
+
+void EventStream::Close() {
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    this->closed = true;
+    this->backlog.clear();
+    this->backlogSize = 0;
+}
+
+bool EventStream::IsClosed() {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->closed;
+}
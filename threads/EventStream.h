@@ -0,0 +1,62 @@
+/**
+ * -----------------------------------------------------
+ * File        EventStream.h
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#ifndef _SYSTEM2_EVENT_STREAM_H_
+#define _SYSTEM2_EVENT_STREAM_H_
+
+#include "EventStreamParser.h"
+
+#include <deque>
+#include <mutex>
+
+/**
+ * Shared state between a streaming request thread and the event callbacks on the game thread.
+ */
+class EventStream {
+private:
+    std::mutex mutex;
+
+    std::deque<StreamEvent_t> backlog;
+    size_t backlogSize;
+    size_t maxBacklog;
+    size_t maxBacklogSize;
+    int dropped;
+
+    bool callbackPending;
+    bool closed;
+
+public:
+    EventStream(size_t maxBacklog, size_t maxBacklogSize);
+
+    // Adds events to the backlog, returns true if a new callback has to be queued
+    bool Push(std::vector<StreamEvent_t>& events);
+
+    // Takes all events from the backlog, returns the number of events dropped since the last batch
+    int TakeBatch(std::vector<StreamEvent_t>& batch);
+
+    void Close();
+    bool IsClosed();
+};
+
+#endif
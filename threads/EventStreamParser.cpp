@@ -0,0 +1,188 @@
+/**
+ * -----------------------------------------------------
+ * File        EventStreamParser.cpp
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "EventStreamParser.h"
+
+#include <cstdlib>
+
+EventStreamParser::EventStreamParser(EventStreamFormat format, size_t maxRecordSize)
+    : format(format), maxRecordSize(maxRecordSize), lastWasCR(false), discardLine(false), hasData(false), retry(-1) {}
+
+void EventStreamParser::Feed(const char* data, size_t length, std::vector<StreamEvent_t>& events) {
+    size_t start = 0;
+    for (size_t i = 0; i < length; i++) {
+        char c = data[i];
+        if (c != '\r' && c != '\n') {
+            continue;
+        }
+
+        // A LF directly after a CR belongs to the same line break
+        if (c == '\n' && this->lastWasCR && i == start && this->line.empty()) {
+            this->lastWasCR = false;
+            start = i + 1;
+            continue;
+        }
+
+        if (!this->discardLine) {
+            if (this->line.length() + (i - start) > this->maxRecordSize) {
+                // Line is too long, drop it
+                this->line.clear();
+                this->discardLine = true;
+            } else {
+                this->line.append(data + start, i - start);
+            }
+        }
+
+        this->ProcessLine(events);
+        this->lastWasCR = (c == '\r');
+        start = i + 1;
+    }
+
+    // Keep the incomplete rest of the line for the next chunk
+    if (start < length) {
+        this->lastWasCR = false;
+
+        if (!this->discardLine) {
+            if (this->line.length() + (length - start) > this->maxRecordSize) {
+                // Line is too long, drop it until the next line break
+                this->line.clear();
+                this->discardLine = true;
+            } else {
+                this->line.append(data + start, length - start);
+            }
+        }
+    }
+}
+
+void EventStreamParser::Reset() {
+    // Only the partial state is reset, the last event id and retry value survive a reconnect
+    this->line.clear();
+    this->lastWasCR = false;
+    this->discardLine = false;
+    this->eventType.clear();
+    this->eventData.clear();
+    this->hasData = false;
+}
+
+const std::string& EventStreamParser::GetLastEventId() const {
+    return this->lastEventId;
+}
+
+long EventStreamParser::GetRetry() const {
+    return this->retry;
+}
+
+void EventStreamParser::ProcessLine(std::vector<StreamEvent_t>& events) {
+    if (this->discardLine) {
+        this->discardLine = false;
+        this->line.clear();
+        return;
+    }
+
+    if (this->format == STREAM_NDJSON) {
+        // Every non empty line is one record
+        if (!this->line.empty()) {
+            StreamEvent_t event;
+            event.data.swap(this->line);
+            events.push_back(std::move(event));
+        }
+
+        this->line.clear();
+        return;
+    }
+
+    if (this->line.empty()) {
+        // An empty line dispatches the event
+        if (this->hasData) {
+            // Remove the last line break of the data
+            if (!this->eventData.empty() && this->eventData.back() == '\n') {
+                this->eventData.pop_back();
+            }
+
+            StreamEvent_t event;
+            event.type = this->eventType.empty() ? "message" : this->eventType;
+            event.id = this->lastEventId;
+            event.data.swap(this->eventData);
+            events.push_back(std::move(event));
+        }
+
+        this->eventType.clear();
+        this->eventData.clear();
+        this->hasData = false;
+        return;
+    }
+
+    // Lines starting with a colon are comments
+    if (this->line[0] == ':') {
+        this->line.clear();
+        return;
+    }
+
+    std::string field;
+    std::string value;
+
+    size_t colon = this->line.find(':');
+    if (colon == std::string::npos) {
+        field = this->line;
+    } else {
+        field = this->line.substr(0, colon);
+
+        // A single space after the colon is not part of the value
+        size_t valueStart = colon + 1;
+        if (valueStart < this->line.length() && this->line[valueStart] == ' ') {
+            valueStart++;
+        }
+
+        value = this->line.substr(valueStart);
+    }
+
+    this->line.clear();
+    this->ProcessField(field, value, events);
+}
+
+void EventStreamParser::ProcessField(const std::string& field, const std::string& value, std::vector<StreamEvent_t>& events) {
+    if (field == "event") {
+        this->eventType = value;
+    } else if (field == "data") {
+        if (this->eventData.length() + value.length() + 1 > this->maxRecordSize) {
+            // Event is too big, drop the data collected so far
+            this->eventData.clear();
+            this->hasData = false;
+            return;
+        }
+
+        this->eventData.append(value);
+        this->eventData.push_back('\n');
+        this->hasData = true;
+    } else if (field == "id") {
+        // Ids containing a NUL character are ignored
+        if (value.find('\0') == std::string::npos) {
+            this->lastEventId = value;
+        }
+    } else if (field == "retry") {
+        if (!value.empty() && value.find_first_not_of("0123456789") == std::string::npos) {
+            this->retry = strtol(value.c_str(), nullptr, 10);
+        }
+    }
+}
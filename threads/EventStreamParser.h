@@ -0,0 +1,73 @@
+/**
+ * -----------------------------------------------------
+ * File        EventStreamParser.h
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#ifndef _SYSTEM2_EVENT_STREAM_PARSER_H_
+#define _SYSTEM2_EVENT_STREAM_PARSER_H_
+
+#include "EventStreamFormat.h"
+
+#include <string>
+#include <vector>
+
+typedef struct {
+    std::string type;
+    std::string id;
+    std::string data;
+} StreamEvent_t;
+
+/**
+ * Incremental parser for Server-Sent Events and newline delimited JSON.
+ * Data can be fed in arbitrary chunks, complete records are appended to the given events.
+ */
+class EventStreamParser {
+private:
+    EventStreamFormat format;
+    size_t maxRecordSize;
+
+    std::string line;
+    bool lastWasCR;
+    bool discardLine;
+
+    std::string eventType;
+    std::string eventData;
+    bool hasData;
+
+    std::string lastEventId;
+    long retry;
+
+public:
+    EventStreamParser(EventStreamFormat format, size_t maxRecordSize);
+
+    void Feed(const char* data, size_t length, std::vector<StreamEvent_t>& events);
+    void Reset();
+
+    const std::string& GetLastEventId() const;
+    long GetRetry() const;
+
+private:
+    void ProcessLine(std::vector<StreamEvent_t>& events);
+    void ProcessField(const std::string& field, const std::string& value, std::vector<StreamEvent_t>& events);
+};
+
+#endif
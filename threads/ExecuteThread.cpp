@@ -24,34 +24,384 @@
 
 #include "ExecuteThread.h"
 #include "ExecuteCallback.h"
+#include "ThreadPolicy.h"
+
+#include <chrono>
+
+#if !defined _WIN32
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
 
 ExecuteThread::ExecuteThread(std::string command, int data, std::shared_ptr<CallbackFunction_t> callbackFunction)
-    : Thread(), command(command), data(data), callbackFunction(callbackFunction) {}
+    : Thread(), command(command), data(data), inputType(INPUT_NONE), timedOut(false), callbackFunction(callbackFunction) {}
+
+void ExecuteThread::SetInput(const std::string& input) {
+    this->inputType = INPUT_BUFFER;
+    this->input = input;
+}
+
+void ExecuteThread::SetInputFile(const std::string& path) {
+    this->inputType = INPUT_FILE;
+    this->input = path;
+}
+
+void ExecuteThread::SetOptions(const ExecuteOptions& options) {
+    this->options = std::make_shared<const ExecuteOptions>(options);
+}
+
+ThreadCategory ExecuteThread::GetCategory() const {
+    return THREAD_EXECUTE;
+}
 
 void ExecuteThread::Run() {
-    bool success = true;
     std::string output;
-    int exitStatus;
+    int exitStatus = 0;
 
-    // Execute the command
-    FILE* commandFile = PosixOpen(this->command.c_str(), "r");
-    if (commandFile) {
-        char buffer[1024];
-        while (fgets(buffer, sizeof(buffer), commandFile)) {
-            // Add buffer to the output
-            output += buffer;
-        }
-
-        // Close
-        exitStatus = PosixClose(commandFile);
+#if defined _WIN32
+    bool success;
+    if (this->inputType == INPUT_NONE) {
+        success = this->RunCommand(output, exitStatus);
     } else {
-        success = false;
+        success = this->RunPipedCommand(output, exitStatus);
+    }
+#else
+    // Commands run in their own process group, so they can be killed on a timeout or unload
+    bool success = this->RunPipedCommand(output, exitStatus);
+#endif
+
+    ExecuteStatus status = EXECUTE_OK;
+    if (!success) {
+        status = EXECUTE_ERROR;
 
         char errnoError[128];
         strerror_r(errno, errnoError, sizeof(errnoError));
         output = "ERRNO " + std::to_string(errno) + ": " + errnoError;
+    } else if (this->timedOut) {
+        // The output collected until the timeout is still available
+        success = false;
+        status = EXECUTE_TIMEOUT;
     }
 
     // Add return status to queue
-    system2Extension.AppendCallback(std::make_shared<ExecuteCallback>(this->callbackFunction, success, exitStatus, output, this->command, this->data));
-}
\ No newline at end of file
+    system2Extension.AppendCallback(std::make_shared<ExecuteCallback>(this->callbackFunction, success, status, exitStatus, output, this->command, this->data));
+}
+
+bool ExecuteThread::RunCommand(std::string& output, int& exitStatus) {
+    // Execute the command
+    FILE* commandFile = PosixOpen(this->command.c_str(), "r");
+    if (!commandFile) {
+        return false;
+    }
+
+    char buffer[1024];
+    while (fgets(buffer, sizeof(buffer), commandFile)) {
+        // Add buffer to the output
+        output += buffer;
+    }
+
+    // Close
+    exitStatus = PosixClose(commandFile);
+    return true;
+}
+
+#if defined _WIN32
+bool ExecuteThread::RunPipedCommand(std::string& output, int& exitStatus) {
+    // _popen can't read and write at the same time, so the input is redirected from a file
+    std::string inputFile = this->input;
+    if (this->inputType == INPUT_BUFFER) {
+        char tempFile[L_tmpnam_s];
+        if (tmpnam_s(tempFile, sizeof(tempFile)) != 0) {
+            return false;
+        }
+
+        FILE* file = fopen(tempFile, "wb");
+        if (!file) {
+            return false;
+        }
+
+        fwrite(this->input.data(), 1, this->input.length(), file);
+        fclose(file);
+
+        inputFile = tempFile;
+    }
+
+    std::string command = this->command;
+    this->command = "\"" + command + " < \"" + inputFile + "\"\"";
+
+    bool success = this->RunCommand(output, exitStatus);
+    this->command = command;
+
+    if (this->inputType == INPUT_BUFFER) {
+        remove(inputFile.c_str());
+    }
+
+    return success;
+}
+#else
+void ExecuteThread::SetupChild() const {
+    // Only async signal safe calls are allowed here, as the parent is multi threaded
+    setpgid(0, 0);
+
+    if (!this->options) {
+        return;
+    }
+
+    if (this->options->cpuLimit > 0) {
+        // SIGXCPU at the soft limit, SIGKILL one second later
+        struct rlimit limit = { static_cast<rlim_t>(this->options->cpuLimit), static_cast<rlim_t>(this->options->cpuLimit + 1) };
+        setrlimit(RLIMIT_CPU, &limit);
+    }
+
+    if (this->options->memoryLimit > 0) {
+        // Computed in 64 bits, as rlim_t only has 32 bits in the 32 bit build
+        uint64_t bytes = static_cast<uint64_t>(this->options->memoryLimit) * 1024 * 1024;
+        rlim_t maxBytes = bytes >= static_cast<uint64_t>(RLIM_INFINITY) ? RLIM_INFINITY : static_cast<rlim_t>(bytes);
+        struct rlimit limit = { maxBytes, maxBytes };
+        setrlimit(RLIMIT_AS, &limit);
+    }
+
+    if (this->options->nice > 0) {
+        setpriority(PRIO_PROCESS, 0, this->options->nice);
+    }
+
+#if defined __linux__
+    SetIOPriority(0, this->options->ioClass, this->options->ioLevel);
+#endif
+}
+
+bool ExecuteThread::CheckKill(KillInfo& killInfo) {
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+    // Terminate the process group on a timeout or unload
+    if (killInfo.stage == KILL_NONE && ((killInfo.hasTimeout && now >= killInfo.terminateAt) || this->ShouldTerminate())) {
+        this->timedOut = !this->ShouldTerminate();
+        kill(-killInfo.pid, SIGTERM);
+
+        // Don't give the command time to clean up when unloading
+        int killDelay = this->options ? this->options->killDelay : DEFAULT_KILL_DELAY;
+        killInfo.killAt = now + std::chrono::seconds(this->ShouldTerminate() ? 0 : killDelay);
+        killInfo.stage = KILL_TERM_SENT;
+    }
+
+    // Kill it if it doesn't stop in time
+    if (killInfo.stage == KILL_TERM_SENT && now >= killInfo.killAt) {
+        kill(-killInfo.pid, SIGKILL);
+        killInfo.killAt = now + std::chrono::milliseconds(EXECUTE_KILL_GRACE);
+        killInfo.stage = KILL_SENT;
+    }
+
+    return killInfo.stage == KILL_SENT && now >= killInfo.killAt;
+}
+
+bool ExecuteThread::RunPipedCommand(std::string& output, int& exitStatus) {
+    FILE* inputFile = nullptr;
+    if (this->inputType == INPUT_FILE) {
+        inputFile = fopen(this->input.c_str(), "rb");
+        if (!inputFile) {
+            return false;
+        }
+    }
+
+    int stdinPipe[2];
+    int stdoutPipe[2];
+    if (pipe(stdinPipe) != 0) {
+        if (inputFile) {
+            fclose(inputFile);
+        }
+
+        return false;
+    }
+
+    if (pipe(stdoutPipe) != 0) {
+        int error = errno;
+        close(stdinPipe[0]);
+        close(stdinPipe[1]);
+
+        if (inputFile) {
+            fclose(inputFile);
+        }
+
+        errno = error;
+        return false;
+    }
+
+    // Our pipe ends must not leak into other commands started meanwhile
+    fcntl(stdinPipe[1], F_SETFD, FD_CLOEXEC);
+    fcntl(stdoutPipe[0], F_SETFD, FD_CLOEXEC);
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        // Child: Connect the pipes and run the command through the shell like popen does
+        dup2(stdinPipe[0], STDIN_FILENO);
+        dup2(stdoutPipe[1], STDOUT_FILENO);
+        close(stdinPipe[0]);
+        close(stdoutPipe[1]);
+
+        this->SetupChild();
+
+        execl("/bin/sh", "sh", "-c", this->command.c_str(), static_cast<char*>(nullptr));
+        _exit(127);
+    }
+
+    int error = errno;
+    close(stdinPipe[0]);
+    close(stdoutPipe[1]);
+
+    if (pid < 0) {
+        close(stdinPipe[1]);
+        close(stdoutPipe[0]);
+
+        if (inputFile) {
+            fclose(inputFile);
+        }
+
+        errno = error;
+        return false;
+    }
+
+    // Also set the group in the parent, so a kill can't happen before the child did it
+    setpgid(pid, pid);
+
+    // Block SIGPIPE for this thread, a command that doesn't read its input must not kill the server
+    sigset_t pipeSignal;
+    sigset_t oldSignals;
+    sigemptyset(&pipeSignal);
+    sigaddset(&pipeSignal, SIGPIPE);
+    pthread_sigmask(SIG_BLOCK, &pipeSignal, &oldSignals);
+
+    // Writing must never block, otherwise a command which fills its output pipe would deadlock with us
+    fcntl(stdinPipe[1], F_SETFL, fcntl(stdinPipe[1], F_GETFL) | O_NONBLOCK);
+
+    int inputFd = stdinPipe[1];
+    int outputFd = stdoutPipe[0];
+
+    const char* pending = nullptr;
+    size_t pendingLength = 0;
+    std::unique_ptr<char[]> fileBuffer;
+
+    if (this->inputType == INPUT_BUFFER) {
+        pending = this->input.data();
+        pendingLength = this->input.length();
+    } else if (this->inputType == INPUT_FILE) {
+        fileBuffer.reset(new char[EXECUTE_PIPE_BUFFER_SIZE]);
+    }
+
+    KillInfo killInfo;
+    killInfo.pid = pid;
+    killInfo.hasTimeout = this->options && this->options->timeout > 0;
+    killInfo.terminateAt = std::chrono::steady_clock::now() + std::chrono::seconds(killInfo.hasTimeout ? this->options->timeout : 0);
+    killInfo.stage = KILL_NONE;
+
+    char buffer[EXECUTE_PIPE_BUFFER_SIZE];
+    while (outputFd >= 0 || inputFd >= 0) {
+        // Refill the input from the file if everything was written
+        if (inputFd >= 0 && pendingLength == 0 && inputFile) {
+            pendingLength = fread(fileBuffer.get(), 1, EXECUTE_PIPE_BUFFER_SIZE, inputFile);
+            pending = fileBuffer.get();
+        }
+
+        // All input written, send EOF to the command
+        if (inputFd >= 0 && pendingLength == 0) {
+            close(inputFd);
+            inputFd = -1;
+            continue;
+        }
+
+        // A process which left the group may still hold the pipes open, don't wait for it
+        if (this->CheckKill(killInfo)) {
+            break;
+        }
+
+        struct pollfd fds[2];
+        nfds_t count = 0;
+        if (outputFd >= 0) {
+            fds[count].fd = outputFd;
+            fds[count].events = POLLIN;
+            count++;
+        }
+        if (inputFd >= 0) {
+            fds[count].fd = inputFd;
+            fds[count].events = POLLOUT;
+            count++;
+        }
+
+        int ready = poll(fds, count, EXECUTE_POLL_INTERVAL);
+        if (ready < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            break;
+        }
+
+        for (nfds_t i = 0; i < count && ready > 0; i++) {
+            if (!fds[i].revents) {
+                continue;
+            }
+
+            if (fds[i].fd == outputFd) {
+                ssize_t bytes = read(outputFd, buffer, sizeof(buffer));
+                if (bytes > 0) {
+                    output.append(buffer, bytes);
+                } else if (bytes == 0 || (errno != EINTR && errno != EAGAIN)) {
+                    close(outputFd);
+                    outputFd = -1;
+                }
+            } else {
+                ssize_t bytes = write(inputFd, pending, pendingLength);
+                if (bytes > 0) {
+                    pending += bytes;
+                    pendingLength -= bytes;
+                } else if (bytes < 0 && errno != EINTR && errno != EAGAIN) {
+                    // The command closed its input, the rest is not needed anymore
+                    close(inputFd);
+                    inputFd = -1;
+                    pendingLength = 0;
+                }
+            }
+        }
+    }
+
+    if (inputFd >= 0) {
+        close(inputFd);
+    }
+    if (outputFd >= 0) {
+        close(outputFd);
+    }
+    if (inputFile) {
+        fclose(inputFile);
+    }
+
+    // Consume a SIGPIPE raised by a write, before unblocking it again
+    struct timespec noWait = { 0, 0 };
+    while (sigtimedwait(&pipeSignal, nullptr, &noWait) > 0) {}
+    pthread_sigmask(SIG_SETMASK, &oldSignals, nullptr);
+
+    // The pipes can be closed while the command still runs, e.g. when it closed its stdout
+    while (true) {
+        pid_t result = waitpid(pid, &exitStatus, killInfo.stage == KILL_SENT ? 0 : WNOHANG);
+        if (result == pid) {
+            break;
+        }
+
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            return false;
+        }
+
+        this->CheckKill(killInfo);
+        std::this_thread::sleep_for(std::chrono::milliseconds(EXECUTE_POLL_INTERVAL));
+    }
+
+    return true;
+}
+#endif
@@ -27,6 +27,8 @@
 
 #include "extension.h"
 #include "Thread.h"
+#include "ExecuteOptions.h"
+#include "ExecuteStatus.h"
 
 #include <cerrno>
 #include <cstring>
@@ -41,18 +43,78 @@
 #define PosixClose pclose
 #endif
 
+// Size of the chunks streamed to the stdin of a command
+#define EXECUTE_PIPE_BUFFER_SIZE 65536
+
+// Milliseconds between checks for timeouts and termination
+#define EXECUTE_POLL_INTERVAL 100
+
+// Milliseconds to wait for the pipes to close after the command was killed
+#define EXECUTE_KILL_GRACE 1000
+
+#if !defined _WIN32
+#include <chrono>
+#include <sys/types.h>
+
+enum KillStage {
+    KILL_NONE,
+    KILL_TERM_SENT,
+    KILL_SENT
+};
+
+typedef struct {
+    pid_t pid;
+    bool hasTimeout;
+    std::chrono::steady_clock::time_point terminateAt;
+    std::chrono::steady_clock::time_point killAt;
+    KillStage stage;
+} KillInfo;
+#endif
+
+enum ExecuteInput {
+    INPUT_NONE,
+    INPUT_BUFFER,
+    INPUT_FILE
+};
+
 class ExecuteThread : public Thread {
 private:
     std::string command;
     int data;
 
+    ExecuteInput inputType;
+    std::string input;
+    std::shared_ptr<const ExecuteOptions> options;
+    bool timedOut;
+
     std::shared_ptr<CallbackFunction_t> callbackFunction;
 
 public:
     ExecuteThread(std::string command, int data, std::shared_ptr<CallbackFunction_t> callbackFunction);
 
+    // Pipes the given data to the stdin of the command
+    void SetInput(const std::string& input);
+
+    // Streams the content of the file at the given full path to the stdin of the command
+    void SetInputFile(const std::string& path);
+
+    // Sets timeout, resource limits and priorities of the command
+    void SetOptions(const ExecuteOptions& options);
+
 protected:
     void Run();
+    ThreadCategory GetCategory() const;
+
+private:
+    bool RunCommand(std::string& output, int& exitStatus);
+    bool RunPipedCommand(std::string& output, int& exitStatus);
+
+#if !defined _WIN32
+    void SetupChild() const;
+
+    // Escalates SIGTERM to SIGKILL, returns true if waiting for the command should be given up
+    bool CheckKill(KillInfo& killInfo);
+#endif
 };
 
 #endif
\ No newline at end of file
@@ -33,9 +33,10 @@ void FTPRequestThread::Run() {
 
     if (curl) {
         // Apply general request stuff
-        WriteDataInfo writeData = { std::string(), 0, nullptr };
-        if (!this->ApplyRequest(curl, writeData)) {
-            system2Extension.AppendCallback(std::make_shared<FTPResponseCallback>(this->ftpRequest, "Can not open output file"));
+        WriteDataInfo writeData = { std::make_shared<ContentBuffer>(this->ftpRequest->maxMemoryContent), 0, nullptr, curl };
+        std::string error;
+        if (!this->ApplyRequest(curl, writeData, error)) {
+            system2Extension.AppendCallback(std::make_shared<FTPResponseCallback>(this->ftpRequest, error));
             curl_easy_cleanup(curl);
 
             return;
@@ -58,38 +59,34 @@ void FTPRequestThread::Run() {
             curl_easy_setopt(curl, CURLOPT_PASSWORD, this->ftpRequest->password.c_str());
         }
 
-        FILE* inputFile = nullptr;
+        std::unique_ptr<FileReader> inputFile;
         if (!this->ftpRequest->inputFile.empty()) {
             // Get the full path to the file
             char filePath[PLATFORM_MAX_PATH + 1];
             smutils->BuildPath(Path_Game, filePath, sizeof(filePath), this->ftpRequest->inputFile.c_str());
 
             // Open the file readable
-            inputFile = fopen(filePath, "rb");
-            if (!inputFile) {
+            inputFile = std::make_unique<FileReader>();
+            if (!inputFile->Open(filePath)) {
+                // Close output file if opened, the upload already failed
+                CloseOutputFile(writeData);
+
                 // Create error callback and clean up curl
                 system2Extension.AppendCallback(std::make_shared<FTPResponseCallback>(this->ftpRequest, "Can not open file to upload"));
                 curl_easy_cleanup(curl);
 
-                // Close output file if opened
-                if (writeData.file) {
-                    fclose(writeData.file);
-                }
-
                 return;
             }
 
             // Get the size of the file
-            fseek(inputFile, 0L, SEEK_END);
-            curl_off_t fsize = (curl_off_t)ftell(inputFile);
-            fseek(inputFile, 0L, SEEK_SET);
+            curl_off_t fsize = static_cast<curl_off_t>(inputFile->GetSize());
 
             // Set CURL to upload a file
             curl_easy_setopt(curl, CURLOPT_READFUNCTION, RequestThread::ReadFile);
             curl_easy_setopt(curl, CURLOPT_UPLOAD, 1L);
             curl_easy_setopt(curl, CURLOPT_FTP_CREATE_MISSING_DIRS, this->ftpRequest->createMissingDirs ? CURLFTP_CREATE_DIR : CURLFTP_CREATE_DIR_NONE);
             curl_easy_setopt(curl, CURLOPT_APPEND, this->ftpRequest->appendToFile ? 1L : 0L);
-            curl_easy_setopt(curl, CURLOPT_READDATA, inputFile);
+            curl_easy_setopt(curl, CURLOPT_READDATA, inputFile.get());
             curl_easy_setopt(curl, CURLOPT_INFILESIZE_LARGE, fsize);
         } else {
             if (this->ftpRequest->listFilenamesOnly) {
@@ -102,11 +99,23 @@ void FTPRequestThread::Run() {
         {
             std::lock_guard<std::mutex> lock(this->mutex);
 
-            // Perform curl operation and create the callback
-            if (curl_easy_perform(curl) == CURLE_OK) {
-                callback = std::make_shared<FTPResponseCallback>(this->ftpRequest, curl, writeData.content, writeData.contentLength);
+            // Perform curl operation and create the callback, unless waiting for the lock used up the time of the request
+            if (!this->ApplyDeadline(curl, 0.0)) {
+                callback = std::make_shared<FTPResponseCallback>(this->ftpRequest, "Deadline passed before the request could start");
             } else {
-                if (!strlen(errorBuffer)) {
+                CURLcode result = curl_easy_perform(curl);
+
+                // Close the output file first, so it is complete when the callback fires and a failed write is reported
+                bool fileWritten = CloseOutputFile(writeData);
+
+                // Zip archives are only extracted after the transfer, and a failed extraction is also why a transfer was aborted
+                if (writeData.extractor && !writeData.extractor->Finish(result == CURLE_OK) && writeData.extractor->HasError()) {
+                    callback = std::make_shared<FTPResponseCallback>(this->ftpRequest, writeData.extractor->GetError());
+                } else if (!fileWritten) {
+                    callback = std::make_shared<FTPResponseCallback>(this->ftpRequest, "Can not write output file");
+                } else if (result == CURLE_OK) {
+                    callback = std::make_shared<FTPResponseCallback>(this->ftpRequest, curl, writeData.content, writeData.contentLength, std::make_shared<Arena>());
+                } else if (!strlen(errorBuffer)) {
                     // Set readable error if there is no one
                     callback = std::make_shared<FTPResponseCallback>(this->ftpRequest, "Couldn't execute FTP request");
                 } else {
@@ -119,14 +128,10 @@ void FTPRequestThread::Run() {
         curl_easy_cleanup(curl);
 
         // Close input file if opened
-        if (inputFile) {
-            fclose(inputFile);
-        }
+        inputFile.reset();
 
-        // Also close output file if opened
-        if (writeData.file) {
-            fclose(writeData.file);
-        }
+        // The output file is still open if the deadline passed
+        CloseOutputFile(writeData);
 
         // Append callback so it can be fired
         system2Extension.AppendCallback(callback);
@@ -0,0 +1,227 @@
+/**
+ * -----------------------------------------------------
+ * File        FastDLIndex.cpp
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "FastDLIndex.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#if defined _WIN32 || defined _WIN64
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <sys/stat.h>
+#endif
+
+void FastDLIndex::Load(const std::string& path) {
+    this->entries.clear();
+
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file) {
+        return;
+    }
+
+    // Every line is "<md5> <size> <mtime> <file>", the file comes last as it may contain spaces
+    char line[1024];
+    while (fgets(line, sizeof(line), file)) {
+        size_t length = strlen(line);
+        while (length > 0 && (line[length - 1] == '\n' || line[length - 1] == '\r')) {
+            line[--length] = '\0';
+        }
+
+        char* md5End = strchr(line, ' ');
+        if (!md5End || md5End - line != 32) {
+            continue;
+        }
+
+        char* sizeEnd;
+        char* mtimeEnd;
+        unsigned long long size = strtoull(md5End + 1, &sizeEnd, 10);
+        long long mtime = strtoll(sizeEnd, &mtimeEnd, 10);
+        if (sizeEnd == md5End + 1 || mtimeEnd == sizeEnd || *mtimeEnd != ' ' || !mtimeEnd[1]) {
+            continue;
+        }
+
+        FastDLEntry_t entry = { static_cast<uint64_t>(size), static_cast<int64_t>(mtime), std::string(line, 32) };
+        this->entries[mtimeEnd + 1] = entry;
+    }
+
+    fclose(file);
+}
+
+bool FastDLIndex::Save(const std::string& path) const {
+    std::string tempPath = path + ".tmp";
+
+    FILE* file = fopen(tempPath.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+
+    bool success = true;
+    for (auto& entry : this->entries) {
+        if (fprintf(file, "%s %llu %lld %s\n", entry.second.md5.c_str(), static_cast<unsigned long long>(entry.second.size),
+                    static_cast<long long>(entry.second.mtime), entry.first.c_str()) < 0) {
+            success = false;
+            break;
+        }
+    }
+
+    if (fclose(file) != 0 || !success) {
+        remove(tempPath.c_str());
+        return false;
+    }
+
+#if defined _WIN32 || defined _WIN64
+    return MoveFileExA(tempPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+    return rename(tempPath.c_str(), path.c_str()) == 0;
+#endif
+}
+
+const FastDLEntry_t* FastDLIndex::Find(const std::string& file) const {
+    auto entry = this->entries.find(file);
+    if (entry == this->entries.end()) {
+        return nullptr;
+    }
+
+    return &entry->second;
+}
+
+void FastDLIndex::Set(const std::string& file, const FastDLEntry_t& entry) {
+    this->entries[file] = entry;
+}
+
+void FastDLIndex::Remove(const std::string& file) {
+    this->entries.erase(file);
+}
+
+void FastDLIndex::Retain(const std::set<std::string>& files) {
+    for (auto entry = this->entries.begin(); entry != this->entries.end();) {
+        if (files.find(entry->first) == files.end()) {
+            entry = this->entries.erase(entry);
+        } else {
+            ++entry;
+        }
+    }
+}
+
+size_t FastDLIndex::GetSize() const {
+    return this->entries.size();
+}
+
+static void ScanDirectory(const std::string& directory, const std::string& prefix, std::function<void(const std::string&, uint64_t, int64_t)>& found) {
+#if defined _WIN32 || defined _WIN64
+    WIN32_FIND_DATAA data;
+    HANDLE find = FindFirstFileA((directory + "/*").c_str(), &data);
+    if (find == INVALID_HANDLE_VALUE) {
+        return;
+    }
+
+    do {
+        if (!strcmp(data.cFileName, ".") || !strcmp(data.cFileName, "..")) {
+            continue;
+        }
+
+        std::string name = prefix + data.cFileName;
+        if (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+            ScanDirectory(directory + "/" + data.cFileName, name + "/", found);
+        } else {
+            uint64_t size = (static_cast<uint64_t>(data.nFileSizeHigh) << 32) | data.nFileSizeLow;
+            int64_t mtime = static_cast<int64_t>((static_cast<uint64_t>(data.ftLastWriteTime.dwHighDateTime) << 32) | data.ftLastWriteTime.dwLowDateTime);
+
+            found(name, size, mtime);
+        }
+    } while (FindNextFileA(find, &data));
+
+    FindClose(find);
+#else
+    DIR* dir = opendir(directory.c_str());
+    if (!dir) {
+        return;
+    }
+
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != nullptr) {
+        if (!strcmp(entry->d_name, ".") || !strcmp(entry->d_name, "..")) {
+            continue;
+        }
+
+        std::string path = directory + "/" + entry->d_name;
+        std::string name = prefix + entry->d_name;
+
+        struct stat info;
+        if (stat(path.c_str(), &info) != 0) {
+            continue;
+        }
+
+        if (S_ISDIR(info.st_mode)) {
+            ScanDirectory(path, name + "/", found);
+        } else if (S_ISREG(info.st_mode)) {
+            found(name, static_cast<uint64_t>(info.st_size), static_cast<int64_t>(info.st_mtime));
+        }
+    }
+
+    closedir(dir);
+#endif
+}
+
+bool FastDLIndex::Scan(const std::string& directory, std::function<void(const std::string&, uint64_t, int64_t)> found) {
+#if defined _WIN32 || defined _WIN64
+    DWORD attributes = GetFileAttributesA(directory.c_str());
+    if (attributes == INVALID_FILE_ATTRIBUTES || !(attributes & FILE_ATTRIBUTE_DIRECTORY)) {
+        return false;
+    }
+#else
+    struct stat info;
+    if (stat(directory.c_str(), &info) != 0 || !S_ISDIR(info.st_mode)) {
+        return false;
+    }
+#endif
+
+    ScanDirectory(directory, "", found);
+    return true;
+}
+
+bool FastDLIndex::Stat(const std::string& path, uint64_t& size, int64_t& mtime) {
+#if defined _WIN32 || defined _WIN64
+    WIN32_FILE_ATTRIBUTE_DATA data;
+    if (!GetFileAttributesExA(path.c_str(), GetFileExInfoStandard, &data) || (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)) {
+        return false;
+    }
+
+    size = (static_cast<uint64_t>(data.nFileSizeHigh) << 32) | data.nFileSizeLow;
+    mtime = static_cast<int64_t>((static_cast<uint64_t>(data.ftLastWriteTime.dwHighDateTime) << 32) | data.ftLastWriteTime.dwLowDateTime);
+#else
+    struct stat info;
+    if (stat(path.c_str(), &info) != 0 || !S_ISREG(info.st_mode)) {
+        return false;
+    }
+
+    size = static_cast<uint64_t>(info.st_size);
+    mtime = static_cast<int64_t>(info.st_mtime);
+#endif
+
+    return true;
+}
\ No newline at end of file
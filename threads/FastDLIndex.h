@@ -0,0 +1,70 @@
+/**
+ * -----------------------------------------------------
+ * File        FastDLIndex.h
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#ifndef _SYSTEM2_FASTDL_INDEX_H_
+#define _SYSTEM2_FASTDL_INDEX_H_
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <set>
+#include <string>
+
+// Name of the index inside the mirror directory
+#define FASTDL_INDEX_FILE "system2_fastdl.index"
+
+typedef struct {
+    uint64_t size;
+    int64_t mtime;
+    std::string md5;
+} FastDLEntry_t;
+
+class FastDLIndex {
+private:
+    std::map<std::string, FastDLEntry_t> entries;
+
+public:
+    // Loads the index, a missing or broken index is the same as an empty one
+    void Load(const std::string& path);
+
+    // Writes the index to a temporary file first, so a crash never leaves a half written index
+    bool Save(const std::string& path) const;
+
+    const FastDLEntry_t* Find(const std::string& file) const;
+    void Set(const std::string& file, const FastDLEntry_t& entry);
+    void Remove(const std::string& file);
+
+    // Removes the entries of all files which don't exist anymore
+    void Retain(const std::set<std::string>& files);
+
+    size_t GetSize() const;
+
+    // Calls found for every file below the directory with its path relative to the directory
+    static bool Scan(const std::string& directory, std::function<void(const std::string&, uint64_t, int64_t)> found);
+
+    // Returns the size and modification time of a file, false if it doesn't exist
+    static bool Stat(const std::string& path, uint64_t& size, int64_t& mtime);
+};
+
+#endif
\ No newline at end of file
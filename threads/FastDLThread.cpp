@@ -0,0 +1,467 @@
+/**
+ * -----------------------------------------------------
+ * File        FastDLThread.cpp
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "FastDLThread.h"
+#include "FastDLCallback.h"
+#include "FTPRequestThread.h"
+#include "FileIO.h"
+
+#include "md5/md5.h"
+
+#include <algorithm>
+#include <atomic>
+
+#if defined _WIN32 || defined _WIN64
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+// The thread is never run, it only uploads the archives of the FastDL thread with the options of a FTP request
+class FastDLUpload : public FTPRequestThread {
+public:
+    explicit FastDLUpload(FTPRequest* ftpRequest) : FTPRequestThread(ftpRequest) {};
+
+    bool Perform(const std::string& baseUrl, const std::string& file, const std::string& archive, std::string& error) {
+        CURL* curl = curl_easy_init();
+        if (!curl) {
+            error = "Couldn't initialize CURL";
+            return false;
+        }
+
+        // Escape every part of the path, as file names may contain spaces
+        std::string url = baseUrl;
+        for (size_t start = 0;;) {
+            size_t end = file.find('/', start);
+            std::string part = file.substr(start, end == std::string::npos ? std::string::npos : end - start);
+
+            char* escaped = curl_easy_escape(curl, part.c_str(), static_cast<int>(part.length()));
+            if (escaped) {
+                url += escaped;
+                curl_free(escaped);
+            }
+
+            if (end == std::string::npos) {
+                break;
+            }
+
+            url += '/';
+            start = end + 1;
+        }
+
+        this->ftpRequest->url = url + ".bz2";
+        this->ftpRequest->outputFile.clear();
+        this->ftpRequest->extractDirectory.clear();
+
+        WriteDataInfo writeData = { std::make_shared<ContentBuffer>(this->ftpRequest->maxMemoryContent), 0, nullptr, curl };
+        if (!this->ApplyRequest(curl, writeData, error)) {
+            curl_easy_cleanup(curl);
+
+            return false;
+        }
+
+        FileReader inputFile;
+        if (!inputFile.Open(archive.c_str())) {
+            error = "Can not open file to upload";
+            curl_easy_cleanup(curl);
+
+            return false;
+        }
+
+        char errorBuffer[CURL_ERROR_SIZE + 1] = "";
+        curl_easy_setopt(curl, CURLOPT_ERRORBUFFER, errorBuffer);
+        curl_easy_setopt(curl, CURLOPT_DEFAULT_PROTOCOL, "ftp");
+
+        if (!this->ftpRequest->username.empty()) {
+            curl_easy_setopt(curl, CURLOPT_USERNAME, this->ftpRequest->username.c_str());
+        }
+
+        if (!this->ftpRequest->password.empty()) {
+            curl_easy_setopt(curl, CURLOPT_PASSWORD, this->ftpRequest->password.c_str());
+        }
+
+        curl_easy_setopt(curl, CURLOPT_READFUNCTION, RequestThread::ReadFile);
+        curl_easy_setopt(curl, CURLOPT_UPLOAD, 1L);
+        curl_easy_setopt(curl, CURLOPT_FTP_CREATE_MISSING_DIRS, this->ftpRequest->createMissingDirs ? CURLFTP_CREATE_DIR : CURLFTP_CREATE_DIR_NONE);
+        curl_easy_setopt(curl, CURLOPT_READDATA, &inputFile);
+        curl_easy_setopt(curl, CURLOPT_INFILESIZE_LARGE, static_cast<curl_off_t>(inputFile.GetSize()));
+
+        bool success = curl_easy_perform(curl) == CURLE_OK;
+        if (!success) {
+            error = strlen(errorBuffer) ? errorBuffer : "Couldn't execute FTP request";
+        }
+
+        curl_easy_cleanup(curl);
+        return success;
+    }
+};
+
+// Uses forward slashes only and removes a trailing slash, so paths can be compared
+static std::string NormalizePath(std::string path) {
+    std::replace(path.begin(), path.end(), '\\', '/');
+    while (path.length() > 1 && path.back() == '/') {
+        path.pop_back();
+    }
+
+    return path;
+}
+
+static bool ArchiveExists(const std::string& archive) {
+    uint64_t size;
+    int64_t mtime;
+
+    return FastDLIndex::Stat(archive, size, mtime);
+}
+
+FastDLThread::FastDLThread(std::string mirror, std::string directories, std::string binDir, FTPRequest* upload, int threads, int data,
+                           std::shared_ptr<CallbackFunction_t> callbackFunction)
+    : Thread(), mirror(mirror), directories(directories), binDir(binDir), upload(upload), threads(threads), data(data), callbackFunction(callbackFunction) {
+    if (this->threads <= 0) {
+        // Leave one core for the game
+        this->threads = std::max(static_cast<int>(std::thread::hardware_concurrency()) - 1, 1);
+    }
+
+    this->threads = std::min(this->threads, FASTDL_MAX_THREADS);
+}
+
+FastDLThread::~FastDLThread() {
+    delete this->upload;
+}
+
+ThreadCategory FastDLThread::GetCategory() const {
+    return THREAD_COMPRESS;
+}
+
+void FastDLThread::Run() {
+    FastDLSummary_t summary = { 0, 0, 0, 0 };
+
+    // Get the full path to the mirror and the game directory, the mirror keeps the paths relative to the game directory
+    char mirrorPath[PLATFORM_MAX_PATH + 1];
+    g_pSM->BuildPath(Path_Game, mirrorPath, sizeof(mirrorPath), this->mirror.c_str());
+
+    std::string mirrorDir = NormalizePath(mirrorPath);
+    std::string gameDir = NormalizePath(g_pSM->GetGamePath());
+
+    if (!FileIO::MakeDirectories(mirrorDir)) {
+        system2Extension.AppendCallback(std::make_shared<FastDLCallback>(this->callbackFunction, false, "Can not create the mirror directory", this->mirror, summary, this->data));
+        return;
+    }
+
+    FastDLIndex index;
+    index.Load(mirrorDir + "/" FASTDL_INDEX_FILE);
+
+    std::set<std::string> files;
+    std::vector<FastDLJob_t> jobs;
+    std::string error = this->ScanDirectories(index, gameDir, mirrorDir, files, jobs);
+
+    this->CompressJobs(index, gameDir, mirrorDir, jobs);
+    if (this->upload) {
+        this->UploadJobs(mirrorDir, jobs);
+    }
+
+    // Only remember files which are in the mirror, failed files are tried again the next time
+    summary.scanned = static_cast<int>(files.size());
+    for (FastDLJob_t& job : jobs) {
+        FastDLEntry_t entry = { job.size, job.mtime, job.md5 };
+
+        switch (job.state) {
+            case FASTDL_UNCHANGED:
+            {
+                index.Set(job.file, entry);
+                break;
+            }
+            case FASTDL_UPLOADED:
+            {
+                summary.uploaded++;
+                summary.compressed++;
+                index.Set(job.file, entry);
+                break;
+            }
+            case FASTDL_COMPRESSED:
+            {
+                summary.compressed++;
+                if (this->upload) {
+                    // Uploading was stopped, so it has to be compressed and uploaded again
+                    index.Remove(job.file);
+                } else {
+                    index.Set(job.file, entry);
+                }
+                break;
+            }
+            case FASTDL_UPLOAD_FAILED:
+            {
+                summary.compressed++;
+                summary.failed++;
+                index.Remove(job.file);
+                break;
+            }
+            case FASTDL_COMPRESS_FAILED:
+            {
+                summary.failed++;
+                index.Remove(job.file);
+                break;
+            }
+            default:
+            {
+                break;
+            }
+        }
+
+        if (error.empty() && !job.error.empty()) {
+            error = job.error;
+        }
+    }
+
+    index.Retain(files);
+    if (!index.Save(mirrorDir + "/" FASTDL_INDEX_FILE) && error.empty()) {
+        error = "Can not write the index of the mirror";
+    }
+
+    system2Extension.AppendCallback(std::make_shared<FastDLCallback>(this->callbackFunction, error.empty(), error, this->mirror, summary, this->data));
+}
+
+std::string FastDLThread::ScanDirectories(const FastDLIndex& index, const std::string& gameDir, const std::string& mirrorDir,
+                                          std::set<std::string>& files, std::vector<FastDLJob_t>& jobs) {
+    std::string error;
+
+    // Directories are separated by a semicolon
+    for (size_t start = 0; start <= this->directories.length();) {
+        size_t end = this->directories.find(';', start);
+        if (end == std::string::npos) {
+            end = this->directories.length();
+        }
+
+        std::string directory = this->directories.substr(start, end - start);
+        start = end + 1;
+
+        directory.erase(0, directory.find_first_not_of(' '));
+        directory.erase(directory.find_last_not_of(' ') + 1);
+        if (directory.empty()) {
+            continue;
+        }
+
+        char directoryPath[PLATFORM_MAX_PATH + 1];
+        g_pSM->BuildPath(Path_Game, directoryPath, sizeof(directoryPath), directory.c_str());
+
+        std::string fullDirectory = NormalizePath(directoryPath);
+        if (fullDirectory.compare(0, gameDir.length() + 1, gameDir + "/") != 0) {
+            if (error.empty()) {
+                error = "Directory " + directory + " is outside of the game directory";
+            }
+            continue;
+        }
+
+        // Directories which don't exist are skipped, not every game has all of them
+        std::string prefix = fullDirectory.substr(gameDir.length() + 1) + "/";
+        FastDLIndex::Scan(fullDirectory, [&](const std::string& name, uint64_t size, int64_t mtime) -> void {
+            std::string file = prefix + name;
+
+            // Never mirror the mirror itself and files of directories which are given twice
+            if ((gameDir + "/" + file).compare(0, mirrorDir.length() + 1, mirrorDir + "/") == 0 || !files.insert(file).second) {
+                return;
+            }
+
+            // Size and modification time are enough to know a file is unchanged, the hash is only needed if they changed
+            const FastDLEntry_t* entry = index.Find(file);
+            if (entry && entry->size == size && entry->mtime == mtime && ArchiveExists(mirrorDir + "/" + file + ".bz2")) {
+                return;
+            }
+
+            FastDLJob_t job = { file, size, mtime, "", FASTDL_PENDING, "" };
+            jobs.push_back(job);
+        });
+    }
+
+    return error;
+}
+
+void FastDLThread::CompressJobs(const FastDLIndex& index, const std::string& gameDir, const std::string& mirrorDir, std::vector<FastDLJob_t>& jobs) {
+    // Largest files first, so a big map doesn't end up alone at the end
+    std::sort(jobs.begin(), jobs.end(), [](const FastDLJob_t& a, const FastDLJob_t& b) -> bool {
+        return a.size > b.size;
+    });
+
+    std::atomic<size_t> nextJob(0);
+    std::vector<std::thread> workers;
+
+    // Every worker runs its own 7-ZIP process, which compresses with a single thread
+    size_t threads = std::min(static_cast<size_t>(this->threads), jobs.size());
+    for (size_t i = 0; i < threads; i++) {
+        workers.emplace_back([this, &index, &gameDir, &mirrorDir, &jobs, &nextJob]() -> void {
+            threadPolicies.Apply(THREAD_COMPRESS);
+
+            for (size_t job = nextJob++; job < jobs.size() && !this->ShouldTerminate(); job = nextJob++) {
+                // Every 7-ZIP process inherits the affinity, so stay away from the game thread if it moved to another core
+                threadPolicies.Refresh();
+                this->CompressJob(index, gameDir, mirrorDir, jobs[job]);
+            }
+        });
+    }
+
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+void FastDLThread::CompressJob(const FastDLIndex& index, const std::string& gameDir, const std::string& mirrorDir, FastDLJob_t& job) {
+    std::string from = gameDir + "/" + job.file;
+    std::string to = mirrorDir + "/" + job.file + ".bz2";
+
+    MD5 md5 = MD5();
+    if (!FileIO::ReadChunks(from.c_str(), [&md5](const char* data, size_t length) {
+        md5.update(data, length);
+    })) {
+        job.state = FASTDL_COMPRESS_FAILED;
+        job.error = "Can not read " + job.file;
+        return;
+    }
+
+    md5.finalize();
+    job.md5 = md5.hexdigest();
+
+    // A file which was only touched doesn't need to be compressed again
+    const FastDLEntry_t* entry = index.Find(job.file);
+    if (entry && entry->md5 == job.md5 && ArchiveExists(to)) {
+        job.state = FASTDL_UNCHANGED;
+        return;
+    }
+
+    if (!FileIO::MakeDirectories(to.substr(0, to.rfind('/'))) || !this->CompressFile(from, to)) {
+        job.state = FASTDL_COMPRESS_FAILED;
+        job.error = "Couldn't compress " + job.file;
+        return;
+    }
+
+    job.state = FASTDL_COMPRESSED;
+}
+
+bool FastDLThread::RunArchiver(const std::string& binDir, const std::string& archive, const std::string& file) {
+#if defined _WIN32 || defined _WIN64
+    // Windows file names can't contain quotes, so quoting every argument is enough without cmd.exe
+    if (archive.find('"') != std::string::npos || file.find('"') != std::string::npos) {
+        return false;
+    }
+
+    std::string commandLine = "\"" + binDir + "\" a -tbzip2 -mmt1 -mx9 -- \"" + archive + "\" \"" + file + "\"";
+
+    STARTUPINFOA startupInfo;
+    PROCESS_INFORMATION processInfo;
+    ZeroMemory(&startupInfo, sizeof(startupInfo));
+    startupInfo.cb = sizeof(startupInfo);
+
+    if (!CreateProcessA(binDir.c_str(), &commandLine[0], nullptr, nullptr, FALSE, CREATE_NO_WINDOW, nullptr, nullptr, &startupInfo, &processInfo)) {
+        return false;
+    }
+
+    WaitForSingleObject(processInfo.hProcess, INFINITE);
+
+    DWORD exitCode = 1;
+    GetExitCodeProcess(processInfo.hProcess, &exitCode);
+    CloseHandle(processInfo.hThread);
+    CloseHandle(processInfo.hProcess);
+
+    return exitCode == 0;
+#else
+    // "--" ends the switches, so a file name beginning with a dash isn't read as one
+    const char* const argv[] = { binDir.c_str(), "a", "-tbzip2", "-mmt1", "-mx9", "--", archive.c_str(), file.c_str(), nullptr };
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        // Child: Only the exit status is of interest, so the output is discarded
+        int devNull = open("/dev/null", O_WRONLY);
+        if (devNull >= 0) {
+            dup2(devNull, STDOUT_FILENO);
+            dup2(devNull, STDERR_FILENO);
+        }
+
+        execv(argv[0], const_cast<char* const*>(argv));
+        _exit(127);
+    }
+
+    if (pid < 0) {
+        return false;
+    }
+
+    int status;
+    while (waitpid(pid, &status, 0) < 0) {
+        if (errno != EINTR) {
+            return false;
+        }
+    }
+
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+#endif
+}
+
+bool FastDLThread::CompressFile(const std::string& from, const std::string& to) {
+    // 7-ZIP can't replace a bzip2 archive, so it compresses to a new file which then replaces the old archive
+    std::string tempPath = to + ".tmp";
+    remove(tempPath.c_str());
+
+    // The paths are names of files found in the game directories, so 7-ZIP is started without a shell which would interpret them
+    if (!RunArchiver(this->binDir, tempPath, from)) {
+        remove(tempPath.c_str());
+        return false;
+    }
+
+#if defined _WIN32 || defined _WIN64
+    return MoveFileExA(tempPath.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+    return rename(tempPath.c_str(), to.c_str()) == 0;
+#endif
+}
+
+void FastDLThread::UploadJobs(const std::string& mirrorDir, std::vector<FastDLJob_t>& jobs) {
+    std::string baseUrl = this->upload->url;
+    if (baseUrl.empty() || baseUrl.back() != '/') {
+        baseUrl += '/';
+    }
+
+    // Upload one archive after another, as a FTP server allows only few connections
+    for (FastDLJob_t& job : jobs) {
+        if (job.state != FASTDL_COMPRESSED) {
+            continue;
+        }
+
+        if (this->ShouldTerminate()) {
+            break;
+        }
+
+        // Every upload gets its own copy of the request, so the URL can be changed
+        FTPRequest* request = this->upload->Clone();
+
+        std::string error;
+        FastDLUpload transfer(request);
+        if (transfer.Perform(baseUrl, job.file, mirrorDir + "/" + job.file + ".bz2", error)) {
+            job.state = FASTDL_UPLOADED;
+        } else {
+            job.state = FASTDL_UPLOAD_FAILED;
+            job.error = "Couldn't upload " + job.file + ": " + error;
+        }
+
+        delete request;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,90 @@
+/**
+ * -----------------------------------------------------
+ * File        FastDLThread.h
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#ifndef _SYSTEM2_FASTDL_THREAD_H_
+#define _SYSTEM2_FASTDL_THREAD_H_
+
+#include "extension.h"
+#include "Thread.h"
+#include "FTPRequest.h"
+#include "FastDLIndex.h"
+
+#include <vector>
+
+// Max. number of files which are compressed at the same time
+#define FASTDL_MAX_THREADS 16
+
+enum FastDLJobState {
+    FASTDL_PENDING,
+    FASTDL_UNCHANGED,
+    FASTDL_COMPRESSED,
+    FASTDL_UPLOADED,
+    FASTDL_COMPRESS_FAILED,
+    FASTDL_UPLOAD_FAILED
+};
+
+typedef struct {
+    std::string file;
+    uint64_t size;
+    int64_t mtime;
+    std::string md5;
+    FastDLJobState state;
+    std::string error;
+} FastDLJob_t;
+
+class FastDLThread : public Thread {
+private:
+    std::string mirror;
+    std::string directories;
+    std::string binDir;
+    FTPRequest* upload;
+    int threads;
+    int data;
+
+    std::shared_ptr<CallbackFunction_t> callbackFunction;
+
+public:
+    FastDLThread(std::string mirror, std::string directories, std::string binDir, FTPRequest* upload, int threads, int data, std::shared_ptr<CallbackFunction_t> callbackFunction);
+    ~FastDLThread();
+
+protected:
+    void Run();
+    ThreadCategory GetCategory() const;
+
+private:
+    // Collects all files of the directories which are new or changed since the index was written
+    std::string ScanDirectories(const FastDLIndex& index, const std::string& gameDir, const std::string& mirrorDir,
+                                std::set<std::string>& files, std::vector<FastDLJob_t>& jobs);
+
+    void CompressJobs(const FastDLIndex& index, const std::string& gameDir, const std::string& mirrorDir, std::vector<FastDLJob_t>& jobs);
+    void CompressJob(const FastDLIndex& index, const std::string& gameDir, const std::string& mirrorDir, FastDLJob_t& job);
+    bool CompressFile(const std::string& from, const std::string& to);
+
+    // Runs 7-ZIP to compress the file into a bzip2 archive, returns false if it didn't exit successfully
+    static bool RunArchiver(const std::string& binDir, const std::string& archive, const std::string& file);
+
+    void UploadJobs(const std::string& mirrorDir, std::vector<FastDLJob_t>& jobs);
+};
+
+#endif
\ No newline at end of file
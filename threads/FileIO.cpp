@@ -0,0 +1,1063 @@
+/**
+ * -----------------------------------------------------
+ * File        FileIO.cpp
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#if !defined _WIN32 && !defined _WIN64
+// Positioned reads and writes have to reach beyond 2 GB in 32 bit builds
+#define _FILE_OFFSET_BITS 64
+#define FILEIO_POSIX
+#endif
+
+#include "FileIO.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+
+#if defined _WIN32 || defined _WIN64
+#include <direct.h>
+#include <errno.h>
+#include <malloc.h>
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined __linux__ && defined __has_include
+#if __has_include(<linux/io_uring.h>)
+#define FILEIO_HAS_URING
+#endif
+#endif
+
+#ifdef FILEIO_HAS_URING
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+
+// The numbers are the same on every architecture, but older C libraries don't know them
+#ifndef __NR_io_uring_setup
+#define __NR_io_uring_setup 425
+#endif
+#ifndef __NR_io_uring_enter
+#define __NR_io_uring_enter 426
+#endif
+#ifndef __NR_io_uring_register
+#define __NR_io_uring_register 427
+#endif
+#ifndef IORING_FEAT_SINGLE_MMAP
+#define IORING_FEAT_SINGLE_MMAP (1U << 0)
+#endif
+
+// Minimal io_uring with a submission queue of FILEIO_QUEUE_DEPTH entries, one buffer slot per entry
+class IORing {
+private:
+    int fd;
+    unsigned int entries;
+    unsigned int unsubmitted;
+    bool fixed;
+
+    void* sqRing;
+    size_t sqRingSize;
+    void* cqRing;
+    size_t cqRingSize;
+    struct io_uring_sqe* sqes;
+    size_t sqesSize;
+
+    unsigned int* sqHead;
+    unsigned int* sqTail;
+    unsigned int* sqMask;
+    unsigned int* sqArray;
+    unsigned int* cqHead;
+    unsigned int* cqTail;
+    unsigned int* cqMask;
+    struct io_uring_cqe* cqes;
+
+    // Vectors of requests without registered buffers, they have to stay valid until the request completes
+    struct iovec vectors[FILEIO_QUEUE_DEPTH];
+
+public:
+    IORing() : fd(-1), entries(0), unsubmitted(0), fixed(false), sqRing(nullptr), sqRingSize(0), cqRing(nullptr), cqRingSize(0), sqes(nullptr), sqesSize(0),
+        sqHead(nullptr), sqTail(nullptr), sqMask(nullptr), sqArray(nullptr), cqHead(nullptr), cqTail(nullptr), cqMask(nullptr), cqes(nullptr) {}
+
+    ~IORing() {
+        if (this->sqes) {
+            munmap(this->sqes, this->sqesSize);
+        }
+
+        if (this->cqRing && this->cqRing != this->sqRing) {
+            munmap(this->cqRing, this->cqRingSize);
+        }
+
+        if (this->sqRing) {
+            munmap(this->sqRing, this->sqRingSize);
+        }
+
+        if (this->fd >= 0) {
+            close(this->fd);
+        }
+    }
+
+    IORing(const IORing&) = delete;
+    IORing& operator=(const IORing&) = delete;
+
+    bool Init() {
+        struct io_uring_params params;
+        memset(&params, 0, sizeof(params));
+
+        // Fails if the kernel is too old or io_uring is forbidden, e.g. by a seccomp profile of a container
+        this->fd = static_cast<int>(syscall(__NR_io_uring_setup, FILEIO_QUEUE_DEPTH, &params));
+        if (this->fd < 0) {
+            return false;
+        }
+
+        this->entries = params.sq_entries;
+        this->sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned int);
+        this->cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+
+        // Newer kernels map both rings at once
+        bool singleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (singleMap) {
+            this->sqRingSize = std::max(this->sqRingSize, this->cqRingSize);
+            this->cqRingSize = this->sqRingSize;
+        }
+
+        void* map = mmap(nullptr, this->sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, this->fd, IORING_OFF_SQ_RING);
+        if (map == MAP_FAILED) {
+            return false;
+        }
+        this->sqRing = map;
+
+        if (singleMap) {
+            this->cqRing = this->sqRing;
+        } else {
+            map = mmap(nullptr, this->cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, this->fd, IORING_OFF_CQ_RING);
+            if (map == MAP_FAILED) {
+                return false;
+            }
+            this->cqRing = map;
+        }
+
+        this->sqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+        map = mmap(nullptr, this->sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, this->fd, IORING_OFF_SQES);
+        if (map == MAP_FAILED) {
+            return false;
+        }
+        this->sqes = static_cast<struct io_uring_sqe*>(map);
+
+        char* sq = static_cast<char*>(this->sqRing);
+        this->sqHead = reinterpret_cast<unsigned int*>(sq + params.sq_off.head);
+        this->sqTail = reinterpret_cast<unsigned int*>(sq + params.sq_off.tail);
+        this->sqMask = reinterpret_cast<unsigned int*>(sq + params.sq_off.ring_mask);
+        this->sqArray = reinterpret_cast<unsigned int*>(sq + params.sq_off.array);
+
+        char* cq = static_cast<char*>(this->cqRing);
+        this->cqHead = reinterpret_cast<unsigned int*>(cq + params.cq_off.head);
+        this->cqTail = reinterpret_cast<unsigned int*>(cq + params.cq_off.tail);
+        this->cqMask = reinterpret_cast<unsigned int*>(cq + params.cq_off.ring_mask);
+        this->cqes = reinterpret_cast<struct io_uring_cqe*>(cq + params.cq_off.cqes);
+
+        return true;
+    }
+
+    // Registered buffers save mapping the pages for every request, but count against the locked memory limit on older kernels
+    void RegisterBuffers(char* buffers, unsigned int count) {
+        struct iovec buffersVectors[FILEIO_QUEUE_DEPTH];
+        for (unsigned int i = 0; i < count; i++) {
+            buffersVectors[i].iov_base = buffers + i * FILEIO_BUFFER_SIZE;
+            buffersVectors[i].iov_len = FILEIO_BUFFER_SIZE;
+        }
+
+        this->fixed = syscall(__NR_io_uring_register, this->fd, IORING_REGISTER_BUFFERS, buffersVectors, count) == 0;
+    }
+
+    // Queues a read or write of the slot, it's submitted with the next call of Submit or Wait
+    bool Prepare(bool write, int fileFd, int slot, char* buffer, size_t length, uint64_t offset) {
+        unsigned int tail = *this->sqTail;
+        if (tail - __atomic_load_n(this->sqHead, __ATOMIC_ACQUIRE) >= this->entries) {
+            return false;
+        }
+
+        unsigned int index = tail & *this->sqMask;
+        struct io_uring_sqe* sqe = &this->sqes[index];
+        memset(sqe, 0, sizeof(struct io_uring_sqe));
+
+        sqe->fd = fileFd;
+        sqe->off = offset;
+        sqe->user_data = static_cast<uint64_t>(slot);
+
+        if (this->fixed) {
+            sqe->opcode = write ? IORING_OP_WRITE_FIXED : IORING_OP_READ_FIXED;
+            sqe->addr = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(buffer));
+            sqe->len = static_cast<uint32_t>(length);
+            sqe->buf_index = static_cast<uint16_t>(slot);
+        } else {
+            this->vectors[slot].iov_base = buffer;
+            this->vectors[slot].iov_len = length;
+
+            sqe->opcode = write ? IORING_OP_WRITEV : IORING_OP_READV;
+            sqe->addr = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(&this->vectors[slot]));
+            sqe->len = 1;
+        }
+
+        this->sqArray[index] = index;
+        __atomic_store_n(this->sqTail, tail + 1, __ATOMIC_RELEASE);
+        this->unsubmitted++;
+
+        return true;
+    }
+
+    // Submits all queued requests with a single system call
+    bool Submit() {
+        while (this->unsubmitted > 0) {
+            int result = static_cast<int>(syscall(__NR_io_uring_enter, this->fd, this->unsubmitted, 0, 0, nullptr, 0));
+            if (result < 0 && errno == EINTR) {
+                continue;
+            } else if (result <= 0) {
+                return false;
+            }
+
+            this->unsubmitted -= std::min(static_cast<unsigned int>(result), this->unsubmitted);
+        }
+
+        return true;
+    }
+
+    // Waits for the next completed request and returns its slot and result
+    bool Wait(int* slot, int* result) {
+        while (true) {
+            unsigned int head = *this->cqHead;
+            if (head != __atomic_load_n(this->cqTail, __ATOMIC_ACQUIRE)) {
+                struct io_uring_cqe* cqe = &this->cqes[head & *this->cqMask];
+                *slot = static_cast<int>(cqe->user_data);
+                *result = cqe->res;
+
+                __atomic_store_n(this->cqHead, head + 1, __ATOMIC_RELEASE);
+                return true;
+            }
+
+            // Submit what's queued and sleep until something completes
+            int entered = static_cast<int>(syscall(__NR_io_uring_enter, this->fd, this->unsubmitted, 1, IORING_ENTER_GETEVENTS, nullptr, 0));
+            if (entered < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+
+                return false;
+            }
+
+            this->unsubmitted -= std::min(static_cast<unsigned int>(entered), this->unsubmitted);
+        }
+    }
+};
+#else
+// Without io_uring a ring can never be initialized
+class IORing {
+public:
+    bool Init() {
+        return false;
+    }
+
+    void RegisterBuffers(char* buffers, unsigned int count) {}
+
+    bool Prepare(bool write, int fileFd, int slot, char* buffer, size_t length, uint64_t offset) {
+        return false;
+    }
+
+    bool Submit() {
+        return false;
+    }
+
+    bool Wait(int* slot, int* result) {
+        return false;
+    }
+};
+#endif
+
+static std::atomic<int> selectedBackend(-1);
+
+static char* AllocateBuffers(size_t size) {
+#if defined _WIN32 || defined _WIN64
+    return static_cast<char*>(_aligned_malloc(size, FILEIO_ALIGNMENT));
+#else
+    void* buffers = nullptr;
+    if (posix_memalign(&buffers, FILEIO_ALIGNMENT, size) != 0) {
+        return nullptr;
+    }
+
+    return static_cast<char*>(buffers);
+#endif
+}
+
+static void FreeBuffers(char* buffers) {
+#if defined _WIN32 || defined _WIN64
+    _aligned_free(buffers);
+#else
+    free(buffers);
+#endif
+}
+
+static bool ProbeURing() {
+    IORing ring;
+    return ring.Init();
+}
+
+FileReader::FileReader()
+    : backend(FILEIO_STDIO), file(nullptr), fd(-1), ring(nullptr), buffers(nullptr), direct(false), failed(false), size(0), submitChunk(0), readChunk(0),
+    current(-1), inFlight(0), chunk(nullptr), chunkLength(0), chunkPosition(0) {
+    memset(this->completed, 0, sizeof(this->completed));
+    memset(this->results, 0, sizeof(this->results));
+}
+
+FileReader::~FileReader() {
+    this->Close();
+}
+
+bool FileReader::Open(const char* path) {
+    this->Close();
+    this->backend = FileIO::GetBackend();
+
+    if (this->backend == FILEIO_STDIO) {
+        this->file = fopen(path, "rb");
+        if (!this->file) {
+            return false;
+        }
+
+        // Get the size of the file
+#if defined _WIN32 || defined _WIN64
+        _fseeki64(this->file, 0, SEEK_END);
+        int64_t size = _ftelli64(this->file);
+        _fseeki64(this->file, 0, SEEK_SET);
+#else
+        fseeko(this->file, 0, SEEK_END);
+        int64_t size = ftello(this->file);
+        fseeko(this->file, 0, SEEK_SET);
+#endif
+
+        this->buffers = AllocateBuffers(FILEIO_BUFFER_SIZE);
+        if (size < 0 || !this->buffers) {
+            this->Close();
+            return false;
+        }
+
+        this->size = static_cast<uint64_t>(size);
+        return true;
+    }
+
+#ifdef FILEIO_POSIX
+    this->fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (this->fd < 0) {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(this->fd, &info) != 0) {
+        this->Close();
+        return false;
+    }
+    this->size = static_cast<uint64_t>(info.st_size);
+
+    // A ring only pays off if there is more than one chunk to read
+    unsigned int slots = 1;
+    if (this->backend == FILEIO_URING && this->size > FILEIO_BUFFER_SIZE) {
+        this->ring = new IORing();
+        if (this->ring->Init()) {
+            slots = FILEIO_QUEUE_DEPTH;
+        } else {
+            delete this->ring;
+            this->ring = nullptr;
+        }
+    }
+
+    this->buffers = AllocateBuffers(slots * FILEIO_BUFFER_SIZE);
+    if (!this->buffers) {
+        this->Close();
+        return false;
+    }
+
+#ifdef O_DIRECT
+    // Bypass the page cache for large files, not every file system supports this
+    if (this->size >= FILEIO_DIRECT_SIZE) {
+        int flags = fcntl(this->fd, F_GETFL);
+        this->direct = flags >= 0 && fcntl(this->fd, F_SETFL, flags | O_DIRECT) == 0;
+    }
+#endif
+
+#ifdef POSIX_FADV_SEQUENTIAL
+    if (!this->direct) {
+        // Let the kernel read ahead more aggressively
+        posix_fadvise(this->fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    }
+#endif
+
+    if (this->ring) {
+        this->ring->RegisterBuffers(this->buffers, slots);
+
+        // Start reading the first chunks
+        for (int slot = 0; slot < FILEIO_QUEUE_DEPTH && this->submitChunk * FILEIO_BUFFER_SIZE < this->size; slot++) {
+            if (!this->Submit(slot, this->submitChunk)) {
+                break;
+            }
+        }
+
+        this->failed = !this->ring->Submit();
+    }
+
+    return true;
+#else
+    return false;
+#endif
+}
+
+void FileReader::Close() {
+    // Wait for reads in flight, as they still write into the buffers
+    while (this->inFlight > 0 && this->Complete()) {}
+
+    if (this->ring) {
+        delete this->ring;
+        this->ring = nullptr;
+    }
+
+    if (this->file) {
+        fclose(this->file);
+        this->file = nullptr;
+    }
+
+#ifdef FILEIO_POSIX
+    if (this->fd >= 0) {
+        close(this->fd);
+        this->fd = -1;
+    }
+#endif
+
+    // Rather leak the buffers than free them while the kernel may still write into them
+    if (this->buffers && this->inFlight == 0) {
+        FreeBuffers(this->buffers);
+    }
+
+    this->buffers = nullptr;
+    this->direct = false;
+    this->failed = false;
+    this->size = 0;
+    this->submitChunk = 0;
+    this->readChunk = 0;
+    this->current = -1;
+    this->inFlight = 0;
+    this->chunk = nullptr;
+    this->chunkLength = 0;
+    this->chunkPosition = 0;
+}
+
+bool FileReader::Submit(int slot, uint64_t chunk) {
+    if (!this->ring->Prepare(false, this->fd, slot, this->buffers + slot * FILEIO_BUFFER_SIZE, FILEIO_BUFFER_SIZE, chunk * FILEIO_BUFFER_SIZE)) {
+        this->failed = true;
+        return false;
+    }
+
+    this->completed[slot] = false;
+    this->inFlight++;
+    this->submitChunk++;
+
+    return true;
+}
+
+bool FileReader::Complete() {
+    int slot;
+    int result;
+    if (!this->ring->Wait(&slot, &result)) {
+        return false;
+    }
+
+    this->completed[slot] = true;
+    this->results[slot] = result;
+    this->inFlight--;
+
+    return true;
+}
+
+bool FileReader::ReadAt(char* buffer, size_t length, uint64_t offset, size_t* read) {
+    *read = 0;
+
+    if (this->file) {
+        *read = fread(buffer, 1, length, this->file);
+        return !ferror(this->file);
+    }
+
+#ifdef FILEIO_POSIX
+    while (*read < length) {
+        ssize_t result = pread(this->fd, buffer + *read, length - *read, static_cast<off_t>(offset + *read));
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            } else if (errno == EINVAL && this->direct) {
+                // The file system doesn't support direct reads after all
+                this->DisableDirect();
+                continue;
+            }
+
+            return false;
+        } else if (result == 0) {
+            break;
+        }
+
+        *read += result;
+    }
+
+    return true;
+#else
+    return false;
+#endif
+}
+
+void FileReader::DisableDirect() {
+#if defined FILEIO_POSIX && defined O_DIRECT
+    int flags = fcntl(this->fd, F_GETFL);
+    if (flags >= 0) {
+        fcntl(this->fd, F_SETFL, flags & ~O_DIRECT);
+    }
+#endif
+
+    this->direct = false;
+}
+
+size_t FileReader::Next(const char** data) {
+    if (this->failed || !this->buffers) {
+        return 0;
+    }
+
+    // Refill the slot of the previous chunk with the next chunk which isn't requested yet
+    if (this->ring && this->current >= 0 && this->submitChunk * FILEIO_BUFFER_SIZE < this->size) {
+        if (!this->Submit(this->current, this->submitChunk) || !this->ring->Submit()) {
+            this->failed = true;
+            return 0;
+        }
+    }
+
+    uint64_t offset = this->readChunk * FILEIO_BUFFER_SIZE;
+    if (offset >= this->size) {
+        return 0;
+    }
+
+    size_t expected = static_cast<size_t>(std::min<uint64_t>(FILEIO_BUFFER_SIZE, this->size - offset));
+    size_t read = 0;
+    int slot = 0;
+
+    if (this->ring) {
+        slot = static_cast<int>(this->readChunk % FILEIO_QUEUE_DEPTH);
+
+        // Wait until the chunk is read, other chunks may complete first
+        while (!this->completed[slot]) {
+            if (!this->Complete()) {
+                this->failed = true;
+                return 0;
+            }
+        }
+
+        this->completed[slot] = false;
+        if (this->results[slot] < 0 && (this->results[slot] != -EINVAL || !this->direct)) {
+            this->failed = true;
+            return 0;
+        }
+
+        read = static_cast<size_t>(std::max(this->results[slot], 0));
+    }
+
+    char* buffer = this->buffers + slot * FILEIO_BUFFER_SIZE;
+
+    // Read on this thread what's missing, which is the whole chunk without a ring
+    if (read < expected) {
+        if (this->direct && read % FILEIO_ALIGNMENT != 0) {
+            this->DisableDirect();
+        }
+
+        // Direct reads need an aligned length, the end of the file just makes them shorter
+        size_t missing;
+        if (!this->ReadAt(buffer + read, (this->direct ? FILEIO_BUFFER_SIZE : expected) - read, offset + read, &missing)) {
+            this->failed = true;
+            return 0;
+        }
+
+        read += missing;
+        if (read < expected) {
+            // The file was truncated while reading
+            this->failed = true;
+            return 0;
+        }
+    }
+
+    this->current = slot;
+    this->readChunk++;
+
+    *data = buffer;
+    return expected;
+}
+
+size_t FileReader::Read(char* buffer, size_t size) {
+    size_t read = 0;
+
+    while (read < size) {
+        if (this->chunkPosition >= this->chunkLength) {
+            this->chunkLength = this->Next(&this->chunk);
+            this->chunkPosition = 0;
+
+            if (!this->chunkLength) {
+                break;
+            }
+        }
+
+        size_t part = std::min(this->chunkLength - this->chunkPosition, size - read);
+        memcpy(buffer + read, this->chunk + this->chunkPosition, part);
+
+        this->chunkPosition += part;
+        read += part;
+    }
+
+    return read;
+}
+
+uint64_t FileReader::GetSize() const {
+    return this->size;
+}
+
+bool FileReader::HasFailed() const {
+    return this->failed;
+}
+
+FileWriter::FileWriter()
+    : backend(FILEIO_STDIO), file(nullptr), fd(-1), ring(nullptr), buffers(nullptr), direct(false), preallocated(false), failed(false), current(0), fill(0),
+    offset(0), inFlight(0) {
+    memset(this->busy, 0, sizeof(this->busy));
+    memset(this->offsets, 0, sizeof(this->offsets));
+}
+
+FileWriter::~FileWriter() {
+    this->Close();
+}
+
+bool FileWriter::Open(const char* path) {
+    this->Close();
+    this->backend = FileIO::GetBackend();
+
+    if (this->backend == FILEIO_STDIO) {
+        this->file = fopen(path, "wb");
+        return this->file != nullptr;
+    }
+
+#ifdef FILEIO_POSIX
+    this->fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+    if (this->fd < 0) {
+        return false;
+    }
+
+    // The buffers for a ring are only allocated once there is more than one buffer to write
+    this->buffers = AllocateBuffers(FILEIO_BUFFER_SIZE);
+    if (!this->buffers) {
+        this->Close();
+        return false;
+    }
+
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool FileWriter::Close() {
+    if (this->file) {
+        if (fclose(this->file) != 0) {
+            this->failed = true;
+        }
+
+        this->file = nullptr;
+    }
+
+#ifdef FILEIO_POSIX
+    if (this->fd >= 0) {
+        // Write the last part and wait for the writes in flight
+        if (!this->failed && this->fill > 0) {
+            this->Flush();
+        }
+
+        while (this->inFlight > 0 && this->Complete()) {}
+
+        // Release the reserved space which wasn't used, e.g. if the transfer was aborted
+        if (this->preallocated && this->inFlight == 0 && ftruncate(this->fd, static_cast<off_t>(this->offset)) != 0) {
+            this->failed = true;
+        }
+
+        if (close(this->fd) != 0) {
+            this->failed = true;
+        }
+
+        this->fd = -1;
+    }
+#endif
+
+    if (this->ring) {
+        delete this->ring;
+        this->ring = nullptr;
+    }
+
+    // Rather leak the buffers than free them while the kernel may still read from them
+    if (this->buffers && this->inFlight == 0) {
+        FreeBuffers(this->buffers);
+    }
+
+    bool success = !this->failed && this->inFlight == 0;
+
+    this->buffers = nullptr;
+    this->direct = false;
+    this->preallocated = false;
+    this->failed = false;
+    this->current = 0;
+    this->fill = 0;
+    this->offset = 0;
+    this->inFlight = 0;
+    memset(this->busy, 0, sizeof(this->busy));
+
+    return success;
+}
+
+void FileWriter::Expect(uint64_t size) {
+#if defined __linux__ && defined FALLOC_FL_KEEP_SIZE
+    // Reserve the space up front, so the file isn't fragmented while it grows
+    if (this->fd >= 0 && !this->preallocated && this->offset == 0 && this->fill == 0 && size > 0) {
+        this->preallocated = fallocate(this->fd, FALLOC_FL_KEEP_SIZE, 0, static_cast<off_t>(size)) == 0;
+    }
+#endif
+
+#if defined FILEIO_POSIX && defined O_DIRECT
+    // Bypass the page cache for large files, not every file system supports this
+    if (this->fd >= 0 && !this->direct && this->offset == 0 && this->fill == 0 && size >= FILEIO_DIRECT_SIZE) {
+        int flags = fcntl(this->fd, F_GETFL);
+        this->direct = flags >= 0 && fcntl(this->fd, F_SETFL, flags | O_DIRECT) == 0;
+    }
+#endif
+}
+
+bool FileWriter::Write(const char* data, size_t size) {
+    if (this->failed) {
+        return false;
+    }
+
+    if (this->file) {
+        if (fwrite(data, 1, size, this->file) != size) {
+            this->failed = true;
+        }
+
+        return !this->failed;
+    }
+
+    if (!this->buffers) {
+        return false;
+    }
+
+    // Collect the data in the current buffer and write it once it's full
+    while (size > 0) {
+        size_t part = std::min(FILEIO_BUFFER_SIZE - this->fill, size);
+        memcpy(this->buffers + this->current * FILEIO_BUFFER_SIZE + this->fill, data, part);
+
+        this->fill += part;
+        data += part;
+        size -= part;
+
+        if (this->fill == FILEIO_BUFFER_SIZE && !this->Flush()) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool FileWriter::Flush() {
+    if (this->fill == FILEIO_BUFFER_SIZE && this->StartRing()) {
+        char* buffer = this->buffers + this->current * FILEIO_BUFFER_SIZE;
+        if (!this->ring->Prepare(true, this->fd, this->current, buffer, FILEIO_BUFFER_SIZE, this->offset) || !this->ring->Submit()) {
+            this->failed = true;
+            return false;
+        }
+
+        this->busy[this->current] = true;
+        this->offsets[this->current] = this->offset;
+        this->inFlight++;
+
+        this->offset += FILEIO_BUFFER_SIZE;
+        this->fill = 0;
+        this->current = (this->current + 1) % FILEIO_QUEUE_DEPTH;
+
+        // The next buffer may still be written
+        while (this->busy[this->current]) {
+            if (!this->Complete()) {
+                this->failed = true;
+                return false;
+            }
+        }
+
+        return !this->failed;
+    }
+
+    // Write on this thread, a last part which isn't aligned can't be written directly
+    if (this->direct && this->fill % FILEIO_ALIGNMENT != 0) {
+        this->DisableDirect();
+    }
+
+    if (!this->WriteAt(this->buffers + this->current * FILEIO_BUFFER_SIZE, this->fill, this->offset)) {
+        this->failed = true;
+        return false;
+    }
+
+    this->offset += this->fill;
+    this->fill = 0;
+
+    return true;
+}
+
+bool FileWriter::Complete() {
+    int slot;
+    int result;
+    if (!this->ring->Wait(&slot, &result)) {
+        return false;
+    }
+
+    this->busy[slot] = false;
+    this->inFlight--;
+
+    if (result < 0) {
+        // The file system doesn't support direct writes after all
+        if (result != -EINVAL || !this->direct) {
+            this->failed = true;
+            return true;
+        }
+
+        this->DisableDirect();
+        result = 0;
+    }
+
+    // Write the rest of a short write on this thread
+    if (result < FILEIO_BUFFER_SIZE) {
+        if (this->direct && result % FILEIO_ALIGNMENT != 0) {
+            this->DisableDirect();
+        }
+
+        if (!this->WriteAt(this->buffers + slot * FILEIO_BUFFER_SIZE + result, FILEIO_BUFFER_SIZE - result, this->offsets[slot] + result)) {
+            this->failed = true;
+        }
+    }
+
+    return true;
+}
+
+bool FileWriter::WriteAt(const char* buffer, size_t length, uint64_t offset) {
+#ifdef FILEIO_POSIX
+    size_t written = 0;
+
+    while (written < length) {
+        ssize_t result = pwrite(this->fd, buffer + written, length - written, static_cast<off_t>(offset + written));
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            } else if (errno == EINVAL && this->direct) {
+                this->DisableDirect();
+                continue;
+            }
+
+            return false;
+        }
+
+        written += result;
+    }
+
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool FileWriter::StartRing() {
+    if (this->ring) {
+        return true;
+    } else if (this->backend != FILEIO_URING) {
+        return false;
+    }
+
+    IORing* ring = new IORing();
+    char* buffers = AllocateBuffers(FILEIO_QUEUE_DEPTH * FILEIO_BUFFER_SIZE);
+    if (!buffers || !ring->Init()) {
+        // Write on this thread from now on
+        if (buffers) {
+            FreeBuffers(buffers);
+        }
+
+        delete ring;
+        this->backend = FILEIO_PREAD;
+        return false;
+    }
+
+    // Move the full buffer into the first slot of the ring
+    memcpy(buffers, this->buffers, this->fill);
+    FreeBuffers(this->buffers);
+
+    this->buffers = buffers;
+    this->current = 0;
+    this->ring = ring;
+    this->ring->RegisterBuffers(this->buffers, FILEIO_QUEUE_DEPTH);
+
+    return true;
+}
+
+void FileWriter::DisableDirect() {
+#if defined FILEIO_POSIX && defined O_DIRECT
+    int flags = fcntl(this->fd, F_GETFL);
+    if (flags >= 0) {
+        fcntl(this->fd, F_SETFL, flags & ~O_DIRECT);
+    }
+#endif
+
+    this->direct = false;
+}
+
+FileIOBackend FileIO::GetBackend() {
+    int backend = selectedBackend.load();
+    if (backend < 0) {
+        // Use the best backend which is supported
+        if (FileIO::IsSupported(FILEIO_URING)) {
+            backend = FILEIO_URING;
+        } else if (FileIO::IsSupported(FILEIO_PREAD)) {
+            backend = FILEIO_PREAD;
+        } else {
+            backend = FILEIO_STDIO;
+        }
+
+        selectedBackend = backend;
+    }
+
+    return static_cast<FileIOBackend>(backend);
+}
+
+bool FileIO::SetBackend(FileIOBackend backend) {
+    if (!FileIO::IsSupported(backend)) {
+        return false;
+    }
+
+    selectedBackend = backend;
+    return true;
+}
+
+bool FileIO::IsSupported(FileIOBackend backend) {
+    switch (backend) {
+        case FILEIO_STDIO:
+            return true;
+        case FILEIO_PREAD:
+#ifdef FILEIO_POSIX
+            return true;
+#else
+            return false;
+#endif
+        case FILEIO_URING: {
+            // Only probe once whether the kernel allows io_uring
+            static const bool supported = ProbeURing();
+            return supported;
+        }
+    }
+
+    return false;
+}
+
+const char* FileIO::GetBackendName(FileIOBackend backend) {
+    switch (backend) {
+        case FILEIO_PREAD:
+            return "pread";
+        case FILEIO_URING:
+            return "io_uring";
+        default:
+            return "stdio";
+    }
+}
+
+bool FileIO::Copy(const char* from, const char* to) {
+    FileReader reader;
+    if (!reader.Open(from)) {
+        return false;
+    }
+
+    FileWriter writer;
+    if (!writer.Open(to)) {
+        return false;
+    }
+
+    writer.Expect(reader.GetSize());
+
+    // Copy chunk by chunk, with io_uring the next chunks are read while the current one is written
+    const char* data;
+    size_t length;
+    while ((length = reader.Next(&data)) > 0) {
+        if (!writer.Write(data, length)) {
+            return false;
+        }
+    }
+
+    return !reader.HasFailed() && writer.Close();
+}
+
+bool FileIO::ReadChunks(const char* path, std::function<void(const char*, size_t)> consumer) {
+    FileReader reader;
+    if (!reader.Open(path)) {
+        return false;
+    }
+
+    const char* data;
+    size_t length;
+    while ((length = reader.Next(&data)) > 0) {
+        consumer(data, length);
+    }
+
+    return !reader.HasFailed();
+}
+
+bool FileIO::MakeDirectories(const std::string& directory) {
+    for (size_t end = directory.find('/', 1);; end = directory.find('/', end + 1)) {
+        std::string part = directory.substr(0, end);
+
+#if defined _WIN32 || defined _WIN64
+        // Skip the drive letter
+        if (part.length() == 2 && part[1] == ':') {
+            continue;
+        }
+
+        if (_mkdir(part.c_str()) != 0 && errno != EEXIST) {
+            return false;
+        }
+#else
+        if (mkdir(part.c_str(), 0755) != 0 && errno != EEXIST) {
+            return false;
+        }
+#endif
+
+        if (end == std::string::npos) {
+            return true;
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,170 @@
+/**
+ * -----------------------------------------------------
+ * File        FileIO.h
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#ifndef _SYSTEM2_FILE_IO_H_
+#define _SYSTEM2_FILE_IO_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <functional>
+#include <string>
+
+// Size of a single read or write, a multiple of the block size so it can be used with direct I/O
+#define FILEIO_BUFFER_SIZE 262144
+
+// Number of reads or writes which are in flight at once with io_uring
+#define FILEIO_QUEUE_DEPTH 4
+
+// Files of at least this size bypass the page cache, so copying a large demo doesn't evict the server's working set
+#define FILEIO_DIRECT_SIZE 67108864
+
+// Alignment of buffers, offsets and lengths which direct I/O needs
+#define FILEIO_ALIGNMENT 4096
+
+enum FileIOBackend {
+    // Buffered stdio, the only backend on Windows
+    FILEIO_STDIO,
+    // Positioned reads and writes on the calling thread
+    FILEIO_PREAD,
+    // Batched asynchronous reads and writes through io_uring
+    FILEIO_URING
+};
+
+class IORing;
+
+// Reads a file sequentially in chunks of FILEIO_BUFFER_SIZE, with io_uring the following chunks are already read while the current one is used
+class FileReader {
+private:
+    FileIOBackend backend;
+    FILE* file;
+    int fd;
+    IORing* ring;
+    char* buffers;
+    bool direct;
+    bool failed;
+    uint64_t size;
+
+    // Next chunk which is submitted and next chunk which is returned
+    uint64_t submitChunk;
+    uint64_t readChunk;
+
+    // Slot of the returned chunk, which can be reused with the next call
+    int current;
+    bool completed[FILEIO_QUEUE_DEPTH];
+    int results[FILEIO_QUEUE_DEPTH];
+    unsigned int inFlight;
+
+    // Part of the returned chunk which isn't consumed by Read yet
+    const char* chunk;
+    size_t chunkLength;
+    size_t chunkPosition;
+
+    bool Submit(int slot, uint64_t chunk);
+    bool Complete();
+    bool ReadAt(char* buffer, size_t length, uint64_t offset, size_t* read);
+    void DisableDirect();
+
+public:
+    FileReader();
+    ~FileReader();
+
+    FileReader(const FileReader&) = delete;
+    FileReader& operator=(const FileReader&) = delete;
+
+    bool Open(const char* path);
+    void Close();
+
+    // Returns the next chunk of the file, the chunk is valid until the next call
+    // Returns 0 at the end of the file or if reading failed
+    size_t Next(const char** data);
+
+    // Copies at most size bytes into the buffer and returns the number of copied bytes
+    size_t Read(char* buffer, size_t size);
+
+    uint64_t GetSize() const;
+    bool HasFailed() const;
+};
+
+// Writes a file sequentially, with io_uring full buffers are written while the next ones are filled
+class FileWriter {
+private:
+    FileIOBackend backend;
+    FILE* file;
+    int fd;
+    IORing* ring;
+    char* buffers;
+    bool direct;
+    bool preallocated;
+    bool failed;
+
+    // Slot which is filled and its offset in the file
+    int current;
+    size_t fill;
+    uint64_t offset;
+
+    bool busy[FILEIO_QUEUE_DEPTH];
+    uint64_t offsets[FILEIO_QUEUE_DEPTH];
+    unsigned int inFlight;
+
+    bool Flush();
+    bool Complete();
+    bool WriteAt(const char* buffer, size_t length, uint64_t offset);
+    bool StartRing();
+    void DisableDirect();
+
+public:
+    FileWriter();
+    ~FileWriter();
+
+    FileWriter(const FileWriter&) = delete;
+    FileWriter& operator=(const FileWriter&) = delete;
+
+    bool Open(const char* path);
+
+    // Writes all pending data and closes the file, returns false if any write failed
+    bool Close();
+
+    // Tells the writer the expected size of the file before the first write, so it can reserve the space
+    void Expect(uint64_t size);
+
+    bool Write(const char* data, size_t size);
+};
+
+class FileIO {
+public:
+    static FileIOBackend GetBackend();
+    static bool SetBackend(FileIOBackend backend);
+    static bool IsSupported(FileIOBackend backend);
+    static const char* GetBackendName(FileIOBackend backend);
+
+    static bool Copy(const char* from, const char* to);
+
+    // Passes every chunk of the file to the consumer, returns false if the file couldn't be read
+    static bool ReadChunks(const char* path, std::function<void(const char*, size_t)> consumer);
+
+    // Creates the directory and all missing parents, the path has to use forward slashes
+    static bool MakeDirectories(const std::string& directory);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,52 @@
+/**
+ * -----------------------------------------------------
+ * File        GzipThread.cpp
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "GzipThread.h"
+#include "GzipCallback.h"
+#include "ParallelGzip.h"
+
+GzipThread::GzipThread(std::string from, std::string to, int level, int threads, int data, std::shared_ptr<CallbackFunction_t> callbackFunction)
+    : Thread(), from(from), to(to), level(level), threads(threads), data(data), callbackFunction(callbackFunction) {}
+
+ThreadCategory GzipThread::GetCategory() const {
+    return THREAD_COMPRESS;
+}
+
+void GzipThread::Run() {
+    char filePath[PLATFORM_MAX_PATH + 1];
+    char archivePath[PLATFORM_MAX_PATH + 1];
+
+    // Get the full paths to the files
+    g_pSM->BuildPath(Path_Game, filePath, sizeof(filePath), this->from.c_str());
+    g_pSM->BuildPath(Path_Game, archivePath, sizeof(archivePath), this->to.c_str());
+
+    // Compress the file with the workers, stops if the extension is unloaded
+    ParallelGzip gzip(this->level, this->threads);
+    bool success = gzip.Compress(filePath, archivePath, [this]() -> bool {
+        return this->ShouldTerminate();
+    });
+
+    // Add callback to queue
+    system2Extension.AppendCallback(std::make_shared<GzipCallback>(this->callbackFunction, success, gzip.GetError(), this->from, this->to, this->data));
+}
\ No newline at end of file
@@ -25,6 +25,11 @@
 #include "HTTPRequestThread.h"
 #include "HTTPResponseCallback.h"
 #include "HTTPRequestMethod.h"
+#include "EventCallback.h"
+#include "HostLimiter.h"
+
+#include <algorithm>
+#include <chrono>
 
 HTTPRequestThread::HTTPRequestThread(HTTPRequest* httpRequest, HTTPRequestMethod requestMethod)
     : RequestThread(httpRequest), requestMethod(requestMethod), httpRequest(httpRequest) {};
@@ -35,10 +40,11 @@ void HTTPRequestThread::Run() {
 
     if (curl) {
         // Apply general request stuff
-        WriteDataInfo writeData = { std::string(), 0, nullptr };
-        if (!this->ApplyRequest(curl, writeData)) {
+        WriteDataInfo writeData = { std::make_shared<ContentBuffer>(this->httpRequest->maxMemoryContent), 0, nullptr, curl };
+        std::string error;
+        if (!this->ApplyRequest(curl, writeData, error)) {
             // Create error callback and clean up curl
-            system2Extension.AppendCallback(std::make_shared<HTTPResponseCallback>(this->httpRequest, "Can not open output file", this->requestMethod));
+            system2Extension.AppendCallback(std::make_shared<HTTPResponseCallback>(this->httpRequest, error, this->requestMethod));
             curl_easy_cleanup(curl);
 
             return;
@@ -46,112 +52,44 @@ void HTTPRequestThread::Run() {
 
         // Collect error information
         char errorBuffer[CURL_ERROR_SIZE + 1];
+        errorBuffer[0] = '\0';
         curl_easy_setopt(curl, CURLOPT_ERRORBUFFER, errorBuffer);
 
-        // Use HTTP if no scheme is given
-        curl_easy_setopt(curl, CURLOPT_DEFAULT_PROTOCOL, "http");
-
-        // Set the http user agent
-        if (!this->httpRequest->userAgent.empty()) {
-            curl_easy_setopt(curl, CURLOPT_USERAGENT, this->httpRequest->userAgent.c_str());
-        }
-
-        // Set the http username
-        if (!this->httpRequest->username.empty()) {
-            curl_easy_setopt(curl, CURLOPT_USERNAME, this->httpRequest->username.c_str());
-        }
-
-        // Set the http password
-        if (!this->httpRequest->password.empty()) {
-            curl_easy_setopt(curl, CURLOPT_PASSWORD, this->httpRequest->password.c_str());
-        }
+        // Apply the HTTP options and headers
+        struct curl_slist* headers = this->ApplyHTTPOptions(curl);
 
-        // Set the follow redirect property
-        if (this->httpRequest->followRedirects) {
-            curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
-        }
-
-        // Set data to send
+        // Set data to send, the size is given as the data may contain NUL bytes
+        this->httpRequest->EncodeBody();
         if (!this->httpRequest->bodyData.empty()) {
+            curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, static_cast<long>(this->httpRequest->bodyData.size()));
             curl_easy_setopt(curl, CURLOPT_POSTFIELDS, this->httpRequest->bodyData.c_str());
         }
 
-        // Set headers
-        struct curl_slist* headers = nullptr;
-        if (!this->httpRequest->headers.empty()) {
-            std::string header;
-            for (auto it = this->httpRequest->headers.begin(); it != this->httpRequest->headers.end(); ++it) {
-                if (!it->first.empty()) {
-                    header = it->first + ":";
-                }
-                header = header + it->second;
-                headers = curl_slist_append(headers, header.c_str());
-
-                // Also use accept encoding of CURL
-                if (this->EqualsIgnoreCase(it->first, "Accept-Encoding")) {
-                    curl_easy_setopt(curl, CURLOPT_ACCEPT_ENCODING, it->second.c_str());
-                }
-            }
-
-            curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
-        }
-
-        // Get response headers
-        HeaderInfo headerData = { curl, std::map<std::string, std::string>(), -1L };
+        // Get response headers, they are stored in the arena of the response
+        std::shared_ptr<Arena> arena = std::make_shared<Arena>();
+        HeaderInfo headerData = { curl, ArenaStringMap(ArenaAllocator<char>(arena.get())), -1L };
         curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, HTTPRequestThread::ReadHeader);
         curl_easy_setopt(curl, CURLOPT_HEADERDATA, &headerData);
 
         // Set http method
-        switch (this->requestMethod) {
-            case METHOD_GET:
-                curl_easy_setopt(curl, CURLOPT_HTTPGET, 1L);
-                break;
-            case METHOD_POST:
-                curl_easy_setopt(curl, CURLOPT_POST, 1L);
-                if (this->httpRequest->bodyData.empty()) {
-                    curl_easy_setopt(curl, CURLOPT_POSTFIELDS, "");
-                    curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, 0L);
-                }
-
-                break;
-            case METHOD_PUT:
-                curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "PUT");
-                break;
-            case METHOD_PATCH:
-                curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "PATCH");
-                break;
-            case METHOD_DELETE:
-                curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "DELETE");
-                break;
-            case METHOD_HEAD:
-                curl_easy_setopt(curl, CURLOPT_NOBODY, 1L);
-                break;
-        }
-
-        // Perform curl operation and create the callback
-        std::shared_ptr<HTTPResponseCallback> callback;
-        if (curl_easy_perform(curl) == CURLE_OK) {
-            callback = std::make_shared<HTTPResponseCallback>(this->httpRequest, curl, writeData.content, writeData.contentLength, this->requestMethod, headerData.headers);
+        this->ApplyMethod(curl);
+
+        // Perform curl operation and create the callback, event streams stay connected so they don't take a slot of the host
+        CURLcode result;
+        if (this->httpRequest->eventStreamFormat != STREAM_NONE && this->httpRequest->eventCallbackFunction) {
+            result = this->PerformEventStream(curl, &headers, writeData);
         } else {
-            if (!strlen(errorBuffer)) {
-                // Set readable error if there is no one
-                callback = std::make_shared<HTTPResponseCallback>(this->httpRequest, "Couldn't execute HTTP request", this->requestMethod);
-            } else {
-                callback = std::make_shared<HTTPResponseCallback>(this->httpRequest, errorBuffer, this->requestMethod);
-            }
+            result = this->PerformLimited(curl, errorBuffer);
         }
 
+        std::shared_ptr<HTTPResponseCallback> callback = this->CreateCallback(curl, result, errorBuffer, writeData, arena, headerData);
+
         // Clean up curl
         curl_easy_cleanup(curl);
         if (headers) {
             curl_slist_free_all(headers);
         }
 
-        // Also close output file if opened
-        if (writeData.file) {
-            fclose(writeData.file);
-        }
-
         // Append callback so it can be fired
         system2Extension.AppendCallback(callback);
     } else {
@@ -159,6 +97,377 @@ void HTTPRequestThread::Run() {
     }
 }
 
+struct curl_slist* HTTPRequestThread::ApplyHTTPOptions(CURL* curl) {
+    // Use HTTP if no scheme is given
+    curl_easy_setopt(curl, CURLOPT_DEFAULT_PROTOCOL, "http");
+
+    // Set the http user agent
+    if (!this->httpRequest->userAgent.empty()) {
+        curl_easy_setopt(curl, CURLOPT_USERAGENT, this->httpRequest->userAgent.c_str());
+    }
+
+    // Set the http username
+    if (!this->httpRequest->username.empty()) {
+        curl_easy_setopt(curl, CURLOPT_USERNAME, this->httpRequest->username.c_str());
+    }
+
+    // Set the http password
+    if (!this->httpRequest->password.empty()) {
+        curl_easy_setopt(curl, CURLOPT_PASSWORD, this->httpRequest->password.c_str());
+    }
+
+    // Set the follow redirect property
+    if (this->httpRequest->followRedirects) {
+        curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
+    }
+
+    // Set headers
+    return this->CreateHeaders(curl, std::string());
+}
+
+void HTTPRequestThread::ApplyMethod(CURL* curl) {
+    switch (this->requestMethod) {
+        case METHOD_GET:
+            curl_easy_setopt(curl, CURLOPT_HTTPGET, 1L);
+            break;
+        case METHOD_POST:
+            curl_easy_setopt(curl, CURLOPT_POST, 1L);
+            if (this->httpRequest->bodyData.empty()) {
+                curl_easy_setopt(curl, CURLOPT_POSTFIELDS, "");
+                curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, 0L);
+            }
+
+            break;
+        case METHOD_PUT:
+            curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "PUT");
+            break;
+        case METHOD_PATCH:
+            curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "PATCH");
+            break;
+        case METHOD_DELETE:
+            curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "DELETE");
+            break;
+        case METHOD_HEAD:
+            curl_easy_setopt(curl, CURLOPT_NOBODY, 1L);
+            break;
+    }
+}
+
+CURLcode HTTPRequestThread::PerformLimited(CURL* curl, char* errorBuffer) {
+    // Only requests which opted in share the limit of their host
+    if (!this->httpRequest->hostLimit) {
+        if (!this->ApplyDeadline(curl, 0.0)) {
+            snprintf(errorBuffer, CURL_ERROR_SIZE, "Deadline passed before the request could start");
+            return CURLE_ABORTED_BY_CALLBACK;
+        }
+
+        CURLcode result = curl_easy_perform(curl);
+        if (this->CheckDeadlineTimeout(result)) {
+            snprintf(errorBuffer, CURL_ERROR_SIZE, "Deadline passed during the request");
+        }
+
+        return result;
+    }
+
+    std::string host = HostLimiter::GetHostKey(this->httpRequest->url, this->httpRequest->port);
+
+    // Don't wait longer for a slot than the request itself may take
+    int maxWait = this->httpRequest->timeout > 0 ? this->httpRequest->timeout * 1000 : HOST_DEFAULT_WAIT;
+    if (this->httpRequest->hasDeadline) {
+        maxWait = std::min(maxWait, this->httpRequest->GetRemainingTime());
+    }
+
+    HostPermit permit = hostLimiter.Acquire(host, maxWait, [this]() -> bool {
+        return this->ShouldTerminate();
+    });
+
+    if (permit != PERMIT_GRANTED) {
+        // The request never reaches the network
+        if (permit == PERMIT_CIRCUIT_OPEN) {
+            this->httpRequest->error = REQUEST_ERROR_CIRCUIT_OPEN;
+            snprintf(errorBuffer, CURL_ERROR_SIZE, "Circuit breaker is open for %s", host.c_str());
+        } else if (permit == PERMIT_TIMEOUT && this->httpRequest->HasExpired()) {
+            this->httpRequest->error = REQUEST_ERROR_DEADLINE;
+            snprintf(errorBuffer, CURL_ERROR_SIZE, "Deadline passed while waiting for a free connection to %s", host.c_str());
+        } else if (permit == PERMIT_TIMEOUT) {
+            this->httpRequest->error = REQUEST_ERROR_HOST_BUSY;
+            snprintf(errorBuffer, CURL_ERROR_SIZE, "Timed out waiting for a free connection to %s", host.c_str());
+        } else {
+            snprintf(errorBuffer, CURL_ERROR_SIZE, "Request to %s was aborted", host.c_str());
+        }
+
+        return CURLE_ABORTED_BY_CALLBACK;
+    }
+
+    // The host usually needs its average latency, so skip requests which can't make it anymore
+    if (!this->ApplyDeadline(curl, hostLimiter.GetAverageLatency(host))) {
+        hostLimiter.Release(host, OUTCOME_IGNORED, 0.0);
+        snprintf(errorBuffer, CURL_ERROR_SIZE, "Deadline doesn't leave enough time for a request to %s", host.c_str());
+
+        return CURLE_ABORTED_BY_CALLBACK;
+    }
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    CURLcode result = curl_easy_perform(curl);
+    std::chrono::duration<double, std::milli> latency = std::chrono::steady_clock::now() - start;
+
+    // A timeout shortened by the deadline of the plugin says nothing about the host
+    if (this->CheckDeadlineTimeout(result)) {
+        hostLimiter.Release(host, OUTCOME_IGNORED, 0.0);
+        snprintf(errorBuffer, CURL_ERROR_SIZE, "Deadline passed during the request to %s", host.c_str());
+
+        return result;
+    }
+
+    long statusCode = 0;
+    if (result == CURLE_OK) {
+        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &statusCode);
+    }
+
+    hostLimiter.Release(host, HostLimiter::GetOutcome(result, statusCode), latency.count());
+    return result;
+}
+
+std::shared_ptr<HTTPResponseCallback> HTTPRequestThread::CreateCallback(CURL* curl, CURLcode result, const char* errorBuffer, WriteDataInfo& writeData,
+                                                                        std::shared_ptr<Arena> arena, HeaderInfo& headerData) {
+    // Close the output file first, so it is complete when the callback fires and a failed write is reported
+    bool fileWritten = CloseOutputFile(writeData);
+
+    // Zip archives are only extracted after the transfer, and a failed extraction is also why a transfer was aborted
+    if (writeData.extractor && !writeData.extractor->Finish(result == CURLE_OK) && writeData.extractor->HasError()) {
+        return std::make_shared<HTTPResponseCallback>(this->httpRequest, writeData.extractor->GetError(), this->requestMethod);
+    }
+
+    if (!fileWritten) {
+        return std::make_shared<HTTPResponseCallback>(this->httpRequest, "Can not write output file", this->requestMethod);
+    }
+
+    if (result == CURLE_OK) {
+        return std::make_shared<HTTPResponseCallback>(this->httpRequest, curl, writeData.content, writeData.contentLength, arena,
+                                                      this->requestMethod, std::move(headerData.headers));
+    }
+
+    if (!strlen(errorBuffer)) {
+        // Set readable error if there is no one
+        return std::make_shared<HTTPResponseCallback>(this->httpRequest, "Couldn't execute HTTP request", this->requestMethod);
+    }
+
+    return std::make_shared<HTTPResponseCallback>(this->httpRequest, errorBuffer, this->requestMethod);
+}
+
+struct curl_slist* HTTPRequestThread::CreateHeaders(CURL* curl, const std::string& lastEventId) {
+    struct curl_slist* headers = nullptr;
+    bool hasAccept = false;
+    bool hasExpect = false;
+
+    std::string header;
+    for (auto it = this->httpRequest->headers.begin(); it != this->httpRequest->headers.end(); ++it) {
+        header.clear();
+        if (!it->first.empty()) {
+            header = it->first + ":";
+        }
+        header = header + it->second;
+        headers = curl_slist_append(headers, header.c_str());
+
+        // Also use accept encoding of CURL
+        if (this->EqualsIgnoreCase(it->first.c_str(), "Accept-Encoding")) {
+            curl_easy_setopt(curl, CURLOPT_ACCEPT_ENCODING, it->second.c_str());
+        } else if (this->EqualsIgnoreCase(it->first.c_str(), "Accept")) {
+            hasAccept = true;
+        } else if (this->EqualsIgnoreCase(it->first.c_str(), "Expect")) {
+            hasExpect = true;
+        }
+    }
+
+    if (this->httpRequest->eventStreamFormat == STREAM_SSE) {
+        // Announce that we want an event stream
+        if (!hasAccept) {
+            headers = curl_slist_append(headers, "Accept: text/event-stream");
+        }
+
+        // Resume after the last received event when reconnecting
+        if (!lastEventId.empty()) {
+            headers = curl_slist_append(headers, ("Last-Event-ID: " + lastEventId).c_str());
+        }
+    }
+
+    // An empty Expect header stops curl from waiting for a 100-continue before sending the body
+    if (!hasExpect && this->httpRequest->tuningProfile && !this->httpRequest->tuningProfile->expectContinue) {
+        headers = curl_slist_append(headers, "Expect:");
+    }
+
+    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+    return headers;
+}
+
+CURLcode HTTPRequestThread::PerformEventStream(CURL* curl, struct curl_slist** headers, WriteDataInfo& writeData) {
+    EventStreamParser parser(this->httpRequest->eventStreamFormat, MAX_EVENT_SIZE);
+    EventStreamInfo streamInfo = { this, &parser, std::make_shared<EventStream>(this->httpRequest->eventBacklog, MAX_EVENT_BACKLOG_SIZE), 0, &writeData, false, false };
+
+    // Events are parsed while receiving and not collected as content
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, HTTPRequestThread::WriteEventStream);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &streamInfo);
+
+    // The progress function is used to notice a closed stream also while no data arrives
+    curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 0L);
+    curl_easy_setopt(curl, CURLOPT_XFERINFOFUNCTION, HTTPRequestThread::EventStreamProgress);
+    curl_easy_setopt(curl, CURLOPT_XFERINFODATA, &streamInfo);
+
+    // A stream never ends, so the timeout only applies to connecting
+    // A stream may also be idle for a long time, so the low speed limit of a tuning profile is ignored
+    curl_easy_setopt(curl, CURLOPT_TIMEOUT, 0L);
+    curl_easy_setopt(curl, CURLOPT_LOW_SPEED_LIMIT, 0L);
+    curl_easy_setopt(curl, CURLOPT_LOW_SPEED_TIME, 0L);
+    if (this->httpRequest->timeout > 0) {
+        curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, this->httpRequest->timeout);
+    }
+
+    int failedReconnects = 0;
+    while (true) {
+        streamInfo.contentLength = 0;
+        streamInfo.checked = false;
+        CURLcode code = curl_easy_perform(curl);
+        writeData.contentLength += streamInfo.contentLength;
+
+        if (streamInfo.stream->IsClosed() || this->ShouldTerminate()) {
+            // Stream was closed by the plugin or we are shutting down
+            return CURLE_OK;
+        }
+
+        if (streamInfo.rejected) {
+            // The response wasn't an event stream, it is delivered to the response callback as it is
+            return code;
+        }
+
+        long responseCode = 0;
+        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &responseCode);
+        if (code == CURLE_OK && (responseCode < 200 || responseCode >= 300 || responseCode == 204)) {
+            // Server doesn't want us to (re)connect
+            return CURLE_OK;
+        }
+
+        if (!this->ShouldReconnect(code)) {
+            return code;
+        }
+
+        // Only count reconnects which didn't receive any data
+        if (streamInfo.contentLength > 0) {
+            failedReconnects = 0;
+        } else {
+            failedReconnects++;
+        }
+
+        if (this->httpRequest->eventReconnects >= 0 && failedReconnects > this->httpRequest->eventReconnects) {
+            return code;
+        }
+
+        // Wait before reconnecting, the server may set the delay, otherwise back off on failures
+        long delay = parser.GetRetry() >= 0 ? parser.GetRetry() : EVENT_RECONNECT_DELAY;
+        for (int i = 1; i < failedReconnects && delay < 60000; i++) {
+            delay *= 2;
+        }
+
+        for (long waited = 0; waited < delay; waited += 100) {
+            if (streamInfo.stream->IsClosed() || this->ShouldTerminate()) {
+                return CURLE_OK;
+            }
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+
+        // Reconnect with the last event id
+        parser.Reset();
+        if (*headers) {
+            curl_slist_free_all(*headers);
+        }
+        *headers = this->CreateHeaders(curl, parser.GetLastEventId());
+    }
+}
+
+bool HTTPRequestThread::ShouldReconnect(CURLcode code) {
+    switch (code) {
+        case CURLE_OK:
+        case CURLE_COULDNT_RESOLVE_HOST:
+        case CURLE_COULDNT_CONNECT:
+        case CURLE_OPERATION_TIMEDOUT:
+        case CURLE_PARTIAL_FILE:
+        case CURLE_GOT_NOTHING:
+        case CURLE_SEND_ERROR:
+        case CURLE_RECV_ERROR:
+        case CURLE_HTTP2:
+        case CURLE_HTTP2_STREAM:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool HTTPRequestThread::IsEventStream(CURL* curl, EventStreamFormat format) {
+    // Error pages and redirects are never event streams
+    long responseCode = 0;
+    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &responseCode);
+    if (responseCode < 200 || responseCode >= 300) {
+        return false;
+    }
+
+    char* contentType = nullptr;
+    if (curl_easy_getinfo(curl, CURLINFO_CONTENT_TYPE, &contentType) != CURLE_OK || !contentType) {
+        return format != STREAM_SSE;
+    }
+
+    // Only compare the media type without parameters like the charset
+    const char* begin = contentType;
+    const char* end = contentType + strcspn(contentType, ";");
+    Trim(begin, end);
+    std::string mediaType(begin, end - begin);
+
+    // Server-sent events must be announced as such, newline delimited JSON has no single content type, but is never HTML
+    if (format == STREAM_SSE) {
+        return HTTPRequestThread::EqualsIgnoreCase(mediaType.c_str(), "text/event-stream");
+    }
+
+    return !HTTPRequestThread::EqualsIgnoreCase(mediaType.c_str(), "text/html");
+}
+
+size_t HTTPRequestThread::WriteEventStream(char* ptr, size_t size, size_t nmemb, void* userdata) {
+    EventStreamInfo* streamInfo = (EventStreamInfo*)userdata;
+
+    size_t realsize = size * nmemb;
+    if (streamInfo->stream->IsClosed() || streamInfo->thread->ShouldTerminate()) {
+        // Abort the transfer
+        return 0;
+    }
+
+    // Check the response once the headers arrived, other responses are collected as normal content
+    if (!streamInfo->checked) {
+        streamInfo->checked = true;
+        streamInfo->rejected = !HTTPRequestThread::IsEventStream(streamInfo->writeData->curl, streamInfo->thread->httpRequest->eventStreamFormat);
+    }
+
+    if (streamInfo->rejected) {
+        return RequestThread::WriteData(ptr, size, nmemb, streamInfo->writeData);
+    }
+
+    streamInfo->contentLength += realsize;
+
+    std::vector<StreamEvent_t> events;
+    streamInfo->parser->Feed(ptr, realsize, events);
+
+    // Queue a callback which delivers all events collected until the next frame
+    if (!events.empty() && streamInfo->stream->Push(events)) {
+        system2Extension.AppendCallback(std::make_shared<EventCallback>(streamInfo->thread->httpRequest->Clone(), streamInfo->stream));
+    }
+
+    return realsize;
+}
+
+int HTTPRequestThread::EventStreamProgress(void* clientp, curl_off_t dltotal, curl_off_t dlnow, curl_off_t ultotal, curl_off_t ulnow) {
+    EventStreamInfo* streamInfo = (EventStreamInfo*)clientp;
+
+    // Abort the transfer if the stream was closed
+    return (streamInfo->stream->IsClosed() || streamInfo->thread->ShouldTerminate()) ? 1 : 0;
+}
+
 size_t HTTPRequestThread::ReadHeader(char* buffer, size_t size, size_t nitems, void* userdata) {
     // Get the header info
     HeaderInfo* headerInfo = (HeaderInfo*)userdata;
@@ -174,70 +483,43 @@ size_t HTTPRequestThread::ReadHeader(char* buffer, size_t size, size_t nitems, v
 
     size_t realsize = size * nitems;
     if (realsize > 0) {
-        std::string name;
-        std::string value;
+        // Get the name and the value of the header without copying it
+        const char* name = buffer;
+        const char* end = buffer + realsize;
+        const char* semi = static_cast<const char*>(memchr(buffer, ':', realsize));
 
-        // Get the header as string
-        std::string header = std::string(buffer, realsize);
+        const char* nameEnd = semi ? semi : end;
+        const char* value = semi ? semi + 1 : end;
 
-        // Get the name and the value of the header
-        size_t semi = header.find(':');
-        if (semi == std::string::npos) {
-            name = header;
-        } else {
-            name = header.substr(0, semi);
-            value = header.substr(semi + 1);
-        }
-
-        Trim(name);
-        Trim(value);
+        Trim(name, nameEnd);
+        Trim(value, end);
 
         // Only append if one of the two values is set
-        if (name.length() > 0 || value.length() > 0) {
-            headerInfo->headers[name] = value;
+        if (nameEnd > name || end > value) {
+            ArenaString key(name, nameEnd - name, headerInfo->headers.get_allocator());
+            headerInfo->headers[key].assign(value, end - value);
         }
     }
 
     return realsize;
 }
 
-bool HTTPRequestThread::EqualsIgnoreCase(const std::string& str1, const std::string& str2) {
-    size_t str1Len = str1.size();
-    if (str2.size() != str1Len) {
-        return false;
-    }
-
-    for (size_t i = 0; i < str1Len; ++i) {
-        if (tolower(str1[i]) != tolower(str2[i])) {
+bool HTTPRequestThread::EqualsIgnoreCase(const char* str1, const char* str2) {
+    for (; *str1 && *str2; ++str1, ++str2) {
+        if (tolower(*str1) != tolower(*str2)) {
             return false;
         }
     }
 
-    return true;
+    return *str1 == *str2;
 }
 
-inline std::string& HTTPRequestThread::LeftTrim(std::string& str) {
-    std::size_t found = str.find_first_not_of(" \t\f\v\n\r");
-    if (found != std::string::npos) {
-        str.erase(0, found);
-    } else {
-        str.clear();
+inline void HTTPRequestThread::Trim(const char*& begin, const char*& end) {
+    while (begin < end && strchr(" \t\f\v\n\r", *begin)) {
+        begin++;
     }
 
-    return str;
-}
-
-inline std::string& HTTPRequestThread::RightTrim(std::string& str) {
-    std::size_t found = str.find_last_not_of(" \t\f\v\n\r");
-    if (found != std::string::npos) {
-        str.erase(found + 1);
-    } else {
-        str.clear();
+    while (end > begin && strchr(" \t\f\v\n\r", *(end - 1))) {
+        end--;
     }
-
-    return str;
-}
-
-inline std::string& HTTPRequestThread::Trim(std::string& str) {
-    return LeftTrim(RightTrim(str));
 }
\ No newline at end of file
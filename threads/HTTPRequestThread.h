@@ -27,9 +27,22 @@
 
 #include "RequestThread.h"
 #include "HTTPRequest.h"
+#include "EventStream.h"
+#include "Arena.h"
+
+// Max size of a single event of an event stream
+#define MAX_EVENT_SIZE (1024 * 1024)
+
+// Max size of all events which are held back while the event callback is busy
+#define MAX_EVENT_BACKLOG_SIZE (16 * 1024 * 1024)
+
+// Default delay before reconnecting an event stream in milliseconds
+#define EVENT_RECONNECT_DELAY 3000
+
+class HTTPResponseCallback;
 
 class HTTPRequestThread : public RequestThread {
-private:
+protected:
     HTTPRequestMethod requestMethod;
 
 public:
@@ -37,22 +50,47 @@ public:
 
     typedef struct {
         CURL* curl;
-        std::map<std::string, std::string> headers;
+        ArenaStringMap headers;
         long lastResponseCode;
     } HeaderInfo;
 
+    typedef struct {
+        HTTPRequestThread* thread;
+        EventStreamParser* parser;
+        std::shared_ptr<EventStream> stream;
+        size_t contentLength;
+        WriteDataInfo* writeData;
+        bool checked;
+        bool rejected;
+    } EventStreamInfo;
+
     HTTPRequestThread(HTTPRequest* httpRequest, HTTPRequestMethod requestMethod);
 
     static size_t ReadHeader(char* buffer, size_t size, size_t nitems, void* userdata);
-    static bool EqualsIgnoreCase(const std::string& str1, const std::string& str2);
+    static size_t WriteEventStream(char* ptr, size_t size, size_t nmemb, void* userdata);
+    static int EventStreamProgress(void* clientp, curl_off_t dltotal, curl_off_t dlnow, curl_off_t ultotal, curl_off_t ulnow);
+    static bool EqualsIgnoreCase(const char* str1, const char* str2);
 
 private:
-    static inline std::string& LeftTrim(std::string& str);
-    static inline std::string& RightTrim(std::string& str);
-    static inline std::string& Trim(std::string& str);
+    static inline void Trim(const char*& begin, const char*& end);
+
+    struct curl_slist* CreateHeaders(CURL* curl, const std::string& lastEventId);
+    CURLcode PerformEventStream(CURL* curl, struct curl_slist** headers, WriteDataInfo& writeData);
+    static bool ShouldReconnect(CURLcode code);
+    static bool IsEventStream(CURL* curl, EventStreamFormat format);
 
 protected:
     virtual void Run();
+
+    // Options which are the same for every transfer, the returned headers have to be freed after the last transfer
+    struct curl_slist* ApplyHTTPOptions(CURL* curl);
+    void ApplyMethod(CURL* curl);
+
+    // Performs the transfer, with HostLimit within the concurrency limit of the host which fails fast if the host is down
+    CURLcode PerformLimited(CURL* curl, char* errorBuffer);
+
+    std::shared_ptr<HTTPResponseCallback> CreateCallback(CURL* curl, CURLcode result, const char* errorBuffer, WriteDataInfo& writeData,
+                                                         std::shared_ptr<Arena> arena, HeaderInfo& headerData);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,281 @@
+/**
+ * -----------------------------------------------------
+ * File        HostLimiter.cpp
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "HostLimiter.h"
+#include "extension.h"
+
+#include <algorithm>
+#include <cctype>
+
+HostLimiter hostLimiter;
+
+HostLimiter::HostLimiter() : enabled(true) {};
+
+std::string HostLimiter::GetHostKey(const std::string& url, int port) {
+    std::string key = url;
+
+    CURLU* handle = curl_url();
+    if (!handle) {
+        return key;
+    }
+
+    // Requests to the same scheme, host and port share a limit
+    if (curl_url_set(handle, CURLUPART_URL, url.c_str(), CURLU_DEFAULT_SCHEME) == CURLUE_OK) {
+        char* scheme = nullptr;
+        char* host = nullptr;
+        char* defaultPort = nullptr;
+
+        if (curl_url_get(handle, CURLUPART_SCHEME, &scheme, 0) == CURLUE_OK &&
+            curl_url_get(handle, CURLUPART_HOST, &host, 0) == CURLUE_OK &&
+            curl_url_get(handle, CURLUPART_PORT, &defaultPort, CURLU_DEFAULT_PORT) == CURLUE_OK) {
+            std::string hostName = host;
+            std::transform(hostName.begin(), hostName.end(), hostName.begin(), ::tolower);
+
+            key = std::string(scheme) + "://" + hostName + ":" + (port >= 0 ? std::to_string(port) : std::string(defaultPort));
+        }
+
+        curl_free(scheme);
+        curl_free(host);
+        curl_free(defaultPort);
+    }
+
+    curl_url_cleanup(handle);
+    return key;
+}
+
+HostOutcome HostLimiter::GetOutcome(int result, long statusCode) {
+    switch (result) {
+        case CURLE_OK:
+            // Too many requests means the host is overloaded as well
+            return (statusCode >= 500 || statusCode == 429) ? OUTCOME_FAILURE : OUTCOME_SUCCESS;
+        case CURLE_COULDNT_RESOLVE_HOST:
+        case CURLE_COULDNT_CONNECT:
+        case CURLE_OPERATION_TIMEDOUT:
+        case CURLE_SSL_CONNECT_ERROR:
+        case CURLE_GOT_NOTHING:
+        case CURLE_SEND_ERROR:
+        case CURLE_RECV_ERROR:
+            return OUTCOME_FAILURE;
+        default:
+            return OUTCOME_IGNORED;
+    }
+}
+
+HostPermit HostLimiter::Acquire(const std::string& host, int maxWait, const std::function<bool()>& shouldAbort) {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    HostState_t& state = this->GetState(host);
+
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(maxWait);
+    HostPermit permit = PERMIT_TIMEOUT;
+
+    state.waiting++;
+    while (true) {
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        if (this->TryAcquire(state, now, permit) || permit == PERMIT_CIRCUIT_OPEN) {
+            break;
+        }
+
+        if (shouldAbort()) {
+            permit = PERMIT_ABORTED;
+            break;
+        }
+
+        if (now >= deadline) {
+            permit = PERMIT_TIMEOUT;
+            break;
+        }
+
+        this->condition.wait_until(lock, std::min(deadline, now + std::chrono::milliseconds(HOST_POLL_INTERVAL)));
+    }
+    state.waiting--;
+
+    if (permit == PERMIT_CIRCUIT_OPEN || permit == PERMIT_TIMEOUT) {
+        state.rejected++;
+    }
+
+    return permit;
+}
+
+bool HostLimiter::TryAcquire(HostState_t& state, std::chrono::steady_clock::time_point now, HostPermit& permit) {
+    // Still count the requests, so enabling the limiter again doesn't mix up the numbers
+    if (!this->enabled) {
+        state.inFlight++;
+        permit = PERMIT_GRANTED;
+        return true;
+    }
+
+    if (state.circuit == CIRCUIT_OPEN) {
+        if (now < state.openUntil) {
+            permit = PERMIT_CIRCUIT_OPEN;
+            return false;
+        }
+
+        state.circuit = CIRCUIT_HALF_OPEN;
+        state.probing = false;
+    }
+
+    // Only a single probe is made while the circuit is half open, all others fail fast
+    if (state.circuit == CIRCUIT_HALF_OPEN) {
+        if (state.probing) {
+            permit = PERMIT_CIRCUIT_OPEN;
+            return false;
+        }
+
+        state.probing = true;
+        state.inFlight++;
+        permit = PERMIT_GRANTED;
+        return true;
+    }
+
+    if (state.inFlight < static_cast<int>(state.limit)) {
+        state.inFlight++;
+        permit = PERMIT_GRANTED;
+        return true;
+    }
+
+    permit = PERMIT_TIMEOUT;
+    return false;
+}
+
+void HostLimiter::Release(const std::string& host, HostOutcome outcome, double latency) {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    HostState_t& state = this->GetState(host);
+
+    bool wasLimited = state.inFlight >= static_cast<int>(state.limit);
+    state.inFlight = std::max(0, state.inFlight - 1);
+
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    if (outcome == OUTCOME_SUCCESS) {
+        state.succeeded++;
+        state.consecutiveFailures = 0;
+
+        bool healthy = state.averageLatency <= 0.0 || latency <= state.averageLatency * HOST_LATENCY_TOLERANCE;
+        state.averageLatency = state.averageLatency <= 0.0 ? latency : state.averageLatency * 0.9 + latency * 0.1;
+
+        if (state.circuit == CIRCUIT_HALF_OPEN) {
+            // The host is back
+            state.circuit = CIRCUIT_CLOSED;
+            state.probing = false;
+            state.openTime = HOST_BREAKER_OPEN_TIME;
+        } else if (healthy && wasLimited) {
+            // Grow by about one per limit requests, but only if the limit was actually reached
+            state.limit = std::min(static_cast<double>(HOST_LIMIT_MAX), state.limit + 1.0 / state.limit);
+        }
+    } else if (outcome == OUTCOME_FAILURE) {
+        state.failed++;
+        state.consecutiveFailures++;
+
+        if (now - state.lastDecrease >= std::chrono::milliseconds(HOST_DECREASE_INTERVAL)) {
+            state.limit = std::max(static_cast<double>(HOST_LIMIT_MIN), state.limit / 2.0);
+            state.lastDecrease = now;
+        }
+
+        if (state.circuit == CIRCUIT_HALF_OPEN) {
+            // The probe failed, so wait longer before the next one
+            state.openTime = std::min(HOST_BREAKER_MAX_OPEN_TIME, state.openTime * 2);
+            state.circuit = CIRCUIT_OPEN;
+            state.openUntil = now + std::chrono::milliseconds(state.openTime);
+        } else if (state.circuit == CIRCUIT_CLOSED && state.consecutiveFailures >= HOST_BREAKER_FAILURES) {
+            state.circuit = CIRCUIT_OPEN;
+            state.openUntil = now + std::chrono::milliseconds(state.openTime);
+
+            smutils->LogError(myself, "Circuit for host %s opened after %d failures", host.c_str(), state.consecutiveFailures);
+        }
+    } else if (state.circuit == CIRCUIT_HALF_OPEN) {
+        // The probe said nothing about the host, let the next request probe
+        state.probing = false;
+    }
+
+    // Waiting requests fail fast if the circuit opened
+    this->condition.notify_all();
+}
+
+HostLimiter::HostState_t& HostLimiter::GetState(const std::string& host) {
+    auto it = this->hosts.find(host);
+    if (it != this->hosts.end()) {
+        return it->second;
+    }
+
+    HostState_t& state = this->hosts[host];
+    state.limit = HOST_LIMIT_INITIAL;
+    state.inFlight = 0;
+    state.waiting = 0;
+    state.circuit = CIRCUIT_CLOSED;
+    state.probing = false;
+    state.consecutiveFailures = 0;
+    state.openTime = HOST_BREAKER_OPEN_TIME;
+    state.openUntil = std::chrono::steady_clock::time_point();
+    state.lastDecrease = std::chrono::steady_clock::time_point();
+    state.averageLatency = 0.0;
+    state.succeeded = 0;
+    state.failed = 0;
+    state.rejected = 0;
+
+    return state;
+}
+
+double HostLimiter::GetAverageLatency(const std::string& host) {
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    auto it = this->hosts.find(host);
+    return it != this->hosts.end() ? it->second.averageLatency : 0.0;
+}
+
+void HostLimiter::SetEnabled(bool enabled) {
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->enabled = enabled;
+    }
+
+    this->condition.notify_all();
+}
+
+bool HostLimiter::IsEnabled() {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->enabled;
+}
+
+std::vector<HostStats_t> HostLimiter::GetStats() {
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    std::vector<HostStats_t> stats;
+    for (auto it = this->hosts.begin(); it != this->hosts.end(); ++it) {
+        const HostState_t& state = it->second;
+        stats.push_back({ it->first, state.limit, state.inFlight, state.waiting, state.circuit, state.consecutiveFailures,
+                          state.averageLatency, state.succeeded, state.failed, state.rejected });
+    }
+
+    return stats;
+}
+
+const char* HostLimiter::GetCircuitName(HostCircuit circuit) {
+    switch (circuit) {
+        case CIRCUIT_OPEN:
+            return "open";
+        case CIRCUIT_HALF_OPEN:
+            return "half open";
+        default:
+            return "closed";
+    }
+}
\ No newline at end of file
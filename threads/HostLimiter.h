@@ -0,0 +1,157 @@
+/**
+ * -----------------------------------------------------
+ * File        HostLimiter.h
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#ifndef _SYSTEM2_HOST_LIMITER_H_
+#define _SYSTEM2_HOST_LIMITER_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Bounds of the allowed concurrent requests per host
+#define HOST_LIMIT_INITIAL 8
+#define HOST_LIMIT_MIN 1
+#define HOST_LIMIT_MAX 64
+
+// The limit is only cut once per this interval in milliseconds, as concurrent requests usually fail together
+#define HOST_DECREASE_INTERVAL 1000
+
+// A request is slow if it takes longer than this factor of the average latency of the host
+#define HOST_LATENCY_TOLERANCE 2.0
+
+// Consecutive failures which open the circuit of a host
+#define HOST_BREAKER_FAILURES 5
+
+// Time in milliseconds the circuit stays open, it is doubled up to the max whenever a probe fails
+#define HOST_BREAKER_OPEN_TIME 5000
+#define HOST_BREAKER_MAX_OPEN_TIME 60000
+
+// Max time in milliseconds to wait for a free slot if the request has no own timeout
+#define HOST_DEFAULT_WAIT 30000
+
+// Waiting requests check for termination at least this often in milliseconds
+#define HOST_POLL_INTERVAL 100
+
+enum HostCircuit {
+    CIRCUIT_CLOSED,
+    CIRCUIT_OPEN,
+    CIRCUIT_HALF_OPEN
+};
+
+enum HostPermit {
+    PERMIT_GRANTED,
+    PERMIT_CIRCUIT_OPEN,
+    PERMIT_TIMEOUT,
+    PERMIT_ABORTED
+};
+
+enum HostOutcome {
+    // The host answered in time
+    OUTCOME_SUCCESS,
+    // Timeout, connection problem or a 5xx status
+    OUTCOME_FAILURE,
+    // The request failed for a reason which says nothing about the host
+    OUTCOME_IGNORED
+};
+
+typedef struct {
+    std::string host;
+    double limit;
+    int inFlight;
+    int waiting;
+    HostCircuit circuit;
+    int consecutiveFailures;
+    double averageLatency;
+    uint64_t succeeded;
+    uint64_t failed;
+    uint64_t rejected;
+} HostStats_t;
+
+/**
+ * Adaptive limit of concurrent requests per host.
+ * The limit grows additively while the host answers fast and is halved on failures (AIMD).
+ * After too many consecutive failures the circuit opens and requests fail fast, until a single probe succeeds.
+ */
+class HostLimiter {
+private:
+    typedef struct {
+        double limit;
+        int inFlight;
+        int waiting;
+        HostCircuit circuit;
+        bool probing;
+        int consecutiveFailures;
+        int openTime;
+        std::chrono::steady_clock::time_point openUntil;
+        std::chrono::steady_clock::time_point lastDecrease;
+        double averageLatency;
+        uint64_t succeeded;
+        uint64_t failed;
+        uint64_t rejected;
+    } HostState_t;
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::map<std::string, HostState_t> hosts;
+    bool enabled;
+
+    HostState_t& GetState(const std::string& host);
+
+    // Returns whether a request may start now, must be called with the lock
+    bool TryAcquire(HostState_t& state, std::chrono::steady_clock::time_point now, HostPermit& permit);
+
+public:
+    HostLimiter();
+
+    // Returns the key of the host of an URL, e.g. https://example.com:443
+    static std::string GetHostKey(const std::string& url, int port);
+
+    // Classifies the result of a transfer, the status code is only used if the transfer succeeded
+    static HostOutcome GetOutcome(int result, long statusCode);
+
+    // Waits for a free slot of the host, the abort function is checked while waiting
+    HostPermit Acquire(const std::string& host, int maxWait, const std::function<bool()>& shouldAbort);
+
+    // Releases the slot of a granted request, the latency is in milliseconds
+    void Release(const std::string& host, HostOutcome outcome, double latency);
+
+    // Returns the average latency of the host in milliseconds, 0 if unknown
+    double GetAverageLatency(const std::string& host);
+
+    void SetEnabled(bool enabled);
+    bool IsEnabled();
+
+    std::vector<HostStats_t> GetStats();
+
+    static const char* GetCircuitName(HostCircuit circuit);
+};
+
+extern HostLimiter hostLimiter;
+
+#endif
\ No newline at end of file
@@ -0,0 +1,593 @@
+/**
+ * -----------------------------------------------------
+ * File        Outbox.cpp
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "Outbox.h"
+#include "OutboxThread.h"
+#include "HTTPRequestThread.h"
+
+#include "crc/crc.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+
+#if defined _WIN32 || defined _WIN64
+#include <direct.h>
+#include <io.h>
+#else
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+Outbox outbox;
+
+// The thread is never run, it only performs the transfers of the outbox thread
+class OutboxTransfer : public HTTPRequestThread {
+public:
+    OutboxTransfer(HTTPRequest* httpRequest, HTTPRequestMethod requestMethod) : HTTPRequestThread(httpRequest, requestMethod) {};
+
+    CURLcode Perform(CURL* curl, OutboxThread* thread, char* errorBuffer) {
+        curl_easy_reset(curl);
+
+        this->ApplyOptions(curl);
+        struct curl_slist* headers = this->ApplyHTTPOptions(curl);
+
+        curl_easy_setopt(curl, CURLOPT_ERRORBUFFER, errorBuffer);
+
+        this->httpRequest->EncodeBody();
+        curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, static_cast<long>(this->httpRequest->bodyData.size()));
+        curl_easy_setopt(curl, CURLOPT_POSTFIELDS, this->httpRequest->bodyData.c_str());
+        this->ApplyMethod(curl);
+
+        // Nobody is interested in the response content
+        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, OutboxTransfer::DiscardData);
+
+        // Abort the transfer when the extension is unloaded, the request stays in the journal
+        curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 0L);
+        curl_easy_setopt(curl, CURLOPT_XFERINFOFUNCTION, OutboxTransfer::CheckTerminate);
+        curl_easy_setopt(curl, CURLOPT_XFERINFODATA, thread);
+
+        CURLcode result = curl_easy_perform(curl);
+
+        curl_easy_setopt(curl, CURLOPT_HTTPHEADER, nullptr);
+        if (headers) {
+            curl_slist_free_all(headers);
+        }
+
+        return result;
+    }
+
+protected:
+    virtual void Run() {};
+
+private:
+    static size_t DiscardData(char* ptr, size_t size, size_t nmemb, void* userdata) {
+        return size * nmemb;
+    }
+
+    static int CheckTerminate(void* clientp, curl_off_t dltotal, curl_off_t dlnow, curl_off_t ultotal, curl_off_t ulnow) {
+        return static_cast<OutboxThread*>(clientp)->IsTerminating() ? 1 : 0;
+    }
+};
+
+
+static void WriteInt(std::string& data, uint64_t value, int bytes) {
+    for (int i = 0; i < bytes; i++) {
+        data.push_back(static_cast<char>((value >> (i * 8)) & 0xff));
+    }
+}
+
+static bool ReadInt(const std::string& data, size_t& position, uint64_t& value, int bytes) {
+    if (data.size() - position < static_cast<size_t>(bytes)) {
+        return false;
+    }
+
+    value = 0;
+    for (int i = 0; i < bytes; i++) {
+        value |= static_cast<uint64_t>(static_cast<uint8_t>(data[position++])) << (i * 8);
+    }
+
+    return true;
+}
+
+static void WriteString(std::string& data, const std::string& value) {
+    WriteInt(data, value.size(), 4);
+    data.append(value);
+}
+
+static bool ReadString(const std::string& data, size_t& position, std::string& value) {
+    uint64_t length;
+    if (!ReadInt(data, position, length, 4) || data.size() - position < length) {
+        return false;
+    }
+
+    value.assign(data, position, static_cast<size_t>(length));
+    position += static_cast<size_t>(length);
+
+    return true;
+}
+
+static bool SyncFile(FILE* file) {
+    if (fflush(file) != 0) {
+        return false;
+    }
+
+#if defined _WIN32 || defined _WIN64
+    return _commit(_fileno(file)) == 0;
+#elif defined __linux__
+    return fdatasync(fileno(file)) == 0;
+#else
+    return fsync(fileno(file)) == 0;
+#endif
+}
+
+static bool MakeDirectory(const std::string& directory) {
+#if defined _WIN32 || defined _WIN64
+    return _mkdir(directory.c_str()) == 0 || errno == EEXIST;
+#else
+    return mkdir(directory.c_str(), 0755) == 0 || errno == EEXIST;
+#endif
+}
+
+static bool MoveJournal(const std::string& from, const std::string& to) {
+#if defined _WIN32 || defined _WIN64
+    return MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    return rename(from.c_str(), to.c_str()) == 0;
+#endif
+}
+
+
+Outbox::Outbox() : journal(nullptr), journalSize(0), removedSize(0), nextId(1), curl(nullptr) {
+    this->stats = OutboxStats_t();
+}
+
+void Outbox::Start(const std::string& directory) {
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->stats = OutboxStats_t();
+        this->stats.running = true;
+    }
+
+    this->directory = directory;
+    this->path = directory + "/journal.dat";
+
+    OutboxThread* outboxThread = new OutboxThread();
+    outboxThread->RunThread();
+}
+
+bool Outbox::Enqueue(const HTTPRequest* request, HTTPRequestMethod method) {
+    std::string data = Outbox::Serialize(request, method);
+
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (!this->stats.running || this->stats.bytes + data.size() > MAX_OUTBOX_SIZE) {
+        return false;
+    }
+
+    this->stats.entries++;
+    this->stats.bytes += data.size();
+    this->appending.push_back(std::move(data));
+    this->condition.notify_one();
+
+    return true;
+}
+
+OutboxStats_t Outbox::GetStats() {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->stats;
+}
+
+void Outbox::Open() {
+    this->curl = curl_easy_init();
+
+    // Requests of the last run which weren't delivered are sent first
+    this->Replay();
+    if (!this->pending.empty() || this->journalSize > 0) {
+        this->Compact();
+    }
+}
+
+void Outbox::Close() {
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->stats.running = false;
+    }
+
+    // Everything not yet delivered is in the journal afterwards
+    this->FlushAppending();
+    if (this->journal) {
+        fclose(this->journal);
+        this->journal = nullptr;
+    }
+
+    if (this->curl) {
+        curl_easy_cleanup(this->curl);
+        this->curl = nullptr;
+    }
+
+    this->pending.clear();
+    this->journalSize = 0;
+    this->removedSize = 0;
+
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->stats.entries = 0;
+    this->stats.bytes = 0;
+}
+
+void Outbox::FlushAppending() {
+    std::deque<std::string> requests;
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        requests.swap(this->appending);
+    }
+
+    if (requests.empty()) {
+        return;
+    }
+
+    // All requests of a batch share a single sync
+    bool written = this->OpenJournal();
+    for (std::string& request : requests) {
+        uint64_t id = this->nextId++;
+
+        long recordSize = 0;
+        if (written && !this->WriteRecord(this->journal, OUTBOX_RECORD_REQUEST, id, request, recordSize)) {
+            written = false;
+        }
+
+        this->journalSize += recordSize;
+        this->pending.push_back({ id, std::move(request) });
+    }
+
+    if (!written || !SyncFile(this->journal)) {
+        // The requests are still sent, but would be lost on a restart
+        this->SetError("Couldn't write outbox journal " + this->path, false);
+        smutils->LogError(myself, "Couldn't write outbox journal %s", this->path.c_str());
+    }
+
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->stats.journalSize = this->journalSize;
+}
+
+bool Outbox::HasPending() {
+    return !this->pending.empty();
+}
+
+void Outbox::WaitForAppending(int milliseconds) {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    if (this->appending.empty()) {
+        this->condition.wait_for(lock, std::chrono::milliseconds(milliseconds));
+    }
+}
+
+bool Outbox::SendNext(OutboxThread* thread) {
+    OutboxEntry_t& entry = this->pending.front();
+
+    HTTPRequestMethod method;
+    std::unique_ptr<HTTPRequest> request(Outbox::Deserialize(entry.request, method));
+    if (!request) {
+        smutils->LogError(myself, "Dropping invalid outbox request %llu", static_cast<unsigned long long>(entry.id));
+        this->Remove(false);
+
+        return true;
+    }
+
+    // Never let a hanging service block the outbox forever
+    if (request->timeout <= 0) {
+        request->timeout = OUTBOX_DEFAULT_TIMEOUT;
+    }
+
+    char errorBuffer[CURL_ERROR_SIZE + 1];
+    errorBuffer[0] = '\0';
+
+    OutboxTransfer transfer(request.get(), method);
+    CURLcode result = transfer.Perform(this->curl, thread, errorBuffer);
+    if (result != CURLE_OK) {
+        if (result != CURLE_ABORTED_BY_CALLBACK) {
+            this->SetError(strlen(errorBuffer) ? errorBuffer : curl_easy_strerror(result), true);
+        }
+
+        return false;
+    }
+
+    long statusCode = 0;
+    curl_easy_getinfo(this->curl, CURLINFO_RESPONSE_CODE, &statusCode);
+    if (statusCode >= 200 && statusCode < 300) {
+        this->Remove(true);
+        return true;
+    }
+
+    // The service may be overloaded or temporarily unavailable, so try again
+    char error[64];
+    snprintf(error, sizeof(error), "HTTP status %ld", statusCode);
+    if (statusCode == 408 || statusCode == 429 || statusCode >= 500) {
+        this->SetError(error, true);
+        return false;
+    }
+
+    // Every other status will not change by sending the same request again
+    smutils->LogError(myself, "Dropping outbox request to %s: %s", request->url.c_str(), error);
+    this->SetError(error, false);
+    this->Remove(false);
+
+    return true;
+}
+
+bool Outbox::OpenJournal() {
+    if (this->journal) {
+        return true;
+    }
+
+    // The directory is only created when the outbox is used
+    MakeDirectory(this->directory.substr(0, this->directory.find_last_of("/\\")));
+    MakeDirectory(this->directory);
+
+    this->journal = fopen(this->path.c_str(), "ab");
+    return this->journal != nullptr;
+}
+
+bool Outbox::WriteRecord(FILE* file, OutboxRecordType type, uint64_t id, const std::string& request, long& written) {
+    std::string payload;
+    payload.reserve(request.size() + 9);
+    WriteInt(payload, type, 1);
+    WriteInt(payload, id, 8);
+    payload.append(request);
+
+    // Every record has a checksum, so a record which was only partly written before a crash can be detected
+    std::string header;
+    WriteInt(header, payload.size(), 4);
+    WriteInt(header, crc32buf(&payload[0], payload.size()), 4);
+
+    written = static_cast<long>(header.size() + payload.size());
+    return fwrite(header.data(), 1, header.size(), file) == header.size() &&
+        fwrite(payload.data(), 1, payload.size(), file) == payload.size();
+}
+
+void Outbox::Replay() {
+    FILE* file = fopen(this->path.c_str(), "rb");
+    if (!file) {
+        return;
+    }
+
+    std::string data;
+    char buffer[65536];
+    size_t read;
+    while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        data.append(buffer, read);
+    }
+    fclose(file);
+
+    this->journalSize = static_cast<long>(data.size());
+
+    size_t position = 0;
+    while (position < data.size()) {
+        uint64_t length;
+        uint64_t crc;
+        if (!ReadInt(data, position, length, 4) || !ReadInt(data, position, crc, 4) || length < 9 || data.size() - position < length) {
+            break;
+        }
+
+        std::string payload = data.substr(position, static_cast<size_t>(length));
+        if (crc32buf(&payload[0], payload.size()) != crc) {
+            break;
+        }
+        position += static_cast<size_t>(length);
+
+        size_t payloadPosition = 0;
+        uint64_t type;
+        uint64_t id;
+        ReadInt(payload, payloadPosition, type, 1);
+        ReadInt(payload, payloadPosition, id, 8);
+
+        this->nextId = std::max(this->nextId, id + 1);
+        if (type == OUTBOX_RECORD_REQUEST) {
+            this->pending.push_back({ id, payload.substr(payloadPosition) });
+        } else if (type == OUTBOX_RECORD_DONE) {
+            auto it = std::find_if(this->pending.begin(), this->pending.end(), [id](const OutboxEntry_t& entry) {
+                return entry.id == id;
+            });
+
+            if (it != this->pending.end()) {
+                this->pending.erase(it);
+            }
+        }
+    }
+
+    if (position < data.size()) {
+        // Only the end of the journal can be broken, if the server crashed while writing it
+        smutils->LogError(myself, "Ignoring %u broken bytes at the end of outbox journal %s",
+                          static_cast<unsigned int>(data.size() - position), this->path.c_str());
+    }
+
+    std::lock_guard<std::mutex> lock(this->mutex);
+    for (const OutboxEntry_t& entry : this->pending) {
+        this->stats.entries++;
+        this->stats.bytes += entry.request.size();
+    }
+}
+
+bool Outbox::Compact() {
+    if (this->journal) {
+        fclose(this->journal);
+        this->journal = nullptr;
+    }
+
+    // Write the pending requests to a new journal, which then replaces the old one at once
+    std::string tempPath = this->path + ".tmp";
+    FILE* file = fopen(tempPath.c_str(), "wb");
+    if (!file) {
+        smutils->LogError(myself, "Couldn't compact outbox journal %s", this->path.c_str());
+        return this->OpenJournal();
+    }
+
+    bool written = true;
+    long journalSize = 0;
+    for (const OutboxEntry_t& entry : this->pending) {
+        long recordSize;
+        if (!this->WriteRecord(file, OUTBOX_RECORD_REQUEST, entry.id, entry.request, recordSize)) {
+            written = false;
+            break;
+        }
+
+        journalSize += recordSize;
+    }
+
+    written = SyncFile(file) && written;
+    fclose(file);
+
+    if (!written || !MoveJournal(tempPath, this->path)) {
+        smutils->LogError(myself, "Couldn't compact outbox journal %s", this->path.c_str());
+        remove(tempPath.c_str());
+
+        return this->OpenJournal();
+    }
+
+    this->journalSize = journalSize;
+    this->removedSize = 0;
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->stats.journalSize = journalSize;
+    }
+
+    return this->OpenJournal();
+}
+
+void Outbox::Remove(bool delivered) {
+    OutboxEntry_t& entry = this->pending.front();
+
+    // The removal is synced with the next batch, a lost removal only sends the request again
+    long recordSize = 0;
+    if (this->OpenJournal() && this->WriteRecord(this->journal, OUTBOX_RECORD_DONE, entry.id, std::string(), recordSize)) {
+        fflush(this->journal);
+    }
+
+    this->journalSize += recordSize;
+    this->removedSize += recordSize + static_cast<long>(entry.request.size()) + 17;
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->stats.entries--;
+        this->stats.bytes -= entry.request.size();
+        this->stats.journalSize = this->journalSize;
+
+        if (delivered) {
+            this->stats.sent++;
+        } else {
+            this->stats.dropped++;
+        }
+    }
+
+    this->pending.pop_front();
+
+    // Rewrite the journal if it mostly consists of removed requests
+    if (this->removedSize > OUTBOX_COMPACT_SIZE && this->removedSize > this->journalSize / 2) {
+        this->Compact();
+    }
+}
+
+void Outbox::SetError(const std::string& error, bool retry) {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->stats.lastError = error;
+
+    if (retry) {
+        this->stats.retries++;
+    }
+}
+
+std::string Outbox::Serialize(const HTTPRequest* request, HTTPRequestMethod method) {
+    std::string data;
+    data.reserve(request->url.size() + request->bodyData.size() + 64);
+
+    WriteInt(data, method, 1);
+    WriteInt(data, static_cast<uint32_t>(request->port), 4);
+    WriteInt(data, static_cast<uint32_t>(request->timeout), 4);
+    WriteInt(data, request->verifySSL, 1);
+    WriteInt(data, request->followRedirects, 1);
+    WriteInt(data, request->unixSocketAbstract, 1);
+    WriteInt(data, request->bodyEncoding, 1);
+
+    WriteString(data, request->url);
+    WriteString(data, request->unixSocketPath);
+    WriteString(data, request->userAgent);
+    WriteString(data, request->username);
+    WriteString(data, request->password);
+    WriteString(data, request->bodyData);
+
+    WriteInt(data, request->headers.size(), 4);
+    for (auto it = request->headers.begin(); it != request->headers.end(); ++it) {
+        WriteString(data, it->first);
+        WriteString(data, it->second);
+    }
+
+    return data;
+}
+
+HTTPRequest* Outbox::Deserialize(const std::string& data, HTTPRequestMethod& method) {
+    size_t position = 0;
+    uint64_t values[7];
+    for (int i = 0; i < 7; i++) {
+        if (!ReadInt(data, position, values[i], i == 1 || i == 2 ? 4 : 1)) {
+            return nullptr;
+        }
+    }
+
+    if (values[0] > METHOD_HEAD || values[6] > BODY_ENCODING_HEX) {
+        return nullptr;
+    }
+
+    std::string url;
+    if (!ReadString(data, position, url)) {
+        return nullptr;
+    }
+
+    std::unique_ptr<HTTPRequest> request(new HTTPRequest(url, nullptr));
+    request->maxSendSpeed = 0;
+    request->maxRecvSpeed = 0;
+
+    method = static_cast<HTTPRequestMethod>(values[0]);
+    request->port = static_cast<int32_t>(values[1]);
+    request->timeout = static_cast<int32_t>(values[2]);
+    request->verifySSL = values[3] != 0;
+    request->followRedirects = values[4] != 0;
+    request->unixSocketAbstract = values[5] != 0;
+    request->bodyEncoding = static_cast<BodyEncoding>(values[6]);
+
+    uint64_t headers;
+    if (!ReadString(data, position, request->unixSocketPath) || !ReadString(data, position, request->userAgent) ||
+        !ReadString(data, position, request->username) || !ReadString(data, position, request->password) ||
+        !ReadString(data, position, request->bodyData) || !ReadInt(data, position, headers, 4)) {
+        return nullptr;
+    }
+
+    for (uint64_t i = 0; i < headers; i++) {
+        std::string name;
+        std::string value;
+        if (!ReadString(data, position, name) || !ReadString(data, position, value)) {
+            return nullptr;
+        }
+
+        request->headers[name] = value;
+    }
+
+    return request.release();
+}
\ No newline at end of file
@@ -0,0 +1,132 @@
+/**
+ * -----------------------------------------------------
+ * File        Outbox.h
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#ifndef _SYSTEM2_OUTBOX_H_
+#define _SYSTEM2_OUTBOX_H_
+
+#include "HTTPRequest.h"
+
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+
+// Pending requests above this size are rejected until the outbox drained
+#define MAX_OUTBOX_SIZE (64 * 1024 * 1024)
+
+// The outbox thread checks for new requests, due retries and termination at least this often in milliseconds
+#define OUTBOX_POLL_INTERVAL 100
+
+// The journal is rewritten when sent requests take more than this size of it
+#define OUTBOX_COMPACT_SIZE (4 * 1024 * 1024)
+
+// Delay before retrying a failed request in milliseconds, it is doubled up to the max on every failure
+#define OUTBOX_RETRY_DELAY 1000
+#define OUTBOX_MAX_RETRY_DELAY 60000
+
+// Timeout in seconds for requests of the outbox without an own timeout
+#define OUTBOX_DEFAULT_TIMEOUT 30
+
+enum OutboxRecordType {
+    OUTBOX_RECORD_REQUEST = 1,
+    OUTBOX_RECORD_DONE = 2
+};
+
+typedef struct {
+    uint64_t id;
+    std::string request;
+} OutboxEntry_t;
+
+typedef struct {
+    size_t entries;
+    size_t bytes;
+    uint64_t sent;
+    uint64_t dropped;
+    uint64_t retries;
+    long journalSize;
+    std::string lastError;
+    bool running;
+} OutboxStats_t;
+
+class OutboxThread;
+
+/**
+ * Durable queue for fire-and-forget requests.
+ * Requests are appended to a journal by the outbox thread and removed again once they were delivered,
+ * so they survive outages of the receiving service and restarts of the server.
+ */
+class Outbox {
+private:
+    std::mutex mutex;
+    std::condition_variable condition;
+
+    // Guarded by the mutex
+    std::deque<std::string> appending;
+    OutboxStats_t stats;
+
+    // Only used by the outbox thread
+    std::string directory;
+    std::string path;
+    FILE* journal;
+    long journalSize;
+    long removedSize;
+    uint64_t nextId;
+    std::deque<OutboxEntry_t> pending;
+    CURL* curl;
+
+    bool OpenJournal();
+    bool WriteRecord(FILE* file, OutboxRecordType type, uint64_t id, const std::string& request, long& written);
+    void Replay();
+    bool Compact();
+    void Remove(bool delivered);
+    void SetError(const std::string& error, bool retry);
+
+public:
+    Outbox();
+
+    // Starts the outbox thread with the journal in the directory, must be called from the game thread
+    void Start(const std::string& directory);
+
+    // Adds a copy of the request, returns false if the outbox isn't running or is full
+    bool Enqueue(const HTTPRequest* request, HTTPRequestMethod method);
+
+    OutboxStats_t GetStats();
+
+    // Called by the outbox thread
+    void Open();
+    void Close();
+    void FlushAppending();
+    bool HasPending();
+    void WaitForAppending(int milliseconds);
+
+    // Sends the oldest pending request, returns false if it should be retried later
+    bool SendNext(OutboxThread* thread);
+
+    static std::string Serialize(const HTTPRequest* request, HTTPRequestMethod method);
+    static HTTPRequest* Deserialize(const std::string& data, HTTPRequestMethod& method);
+};
+
+extern Outbox outbox;
+
+#endif
\ No newline at end of file
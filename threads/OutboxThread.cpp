@@ -0,0 +1,62 @@
+/**
+ * -----------------------------------------------------
+ * File        OutboxThread.cpp
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "OutboxThread.h"
+#include "Outbox.h"
+
+#include <algorithm>
+#include <chrono>
+
+OutboxThread::OutboxThread() : Thread() {};
+
+bool OutboxThread::IsTerminating() {
+    return this->ShouldTerminate();
+}
+
+void OutboxThread::Run() {
+    outbox.Open();
+
+    int retryDelay = OUTBOX_RETRY_DELAY;
+    std::chrono::steady_clock::time_point nextAttempt = std::chrono::steady_clock::now();
+
+    while (!this->ShouldTerminate()) {
+        // Requests which arrived while the last one was sent are written with a single sync
+        outbox.FlushAppending();
+
+        if (outbox.HasPending() && std::chrono::steady_clock::now() >= nextAttempt) {
+            if (outbox.SendNext(this)) {
+                retryDelay = OUTBOX_RETRY_DELAY;
+                continue;
+            }
+
+            // Requests are sent in order, so wait until the service is available again
+            nextAttempt = std::chrono::steady_clock::now() + std::chrono::milliseconds(retryDelay);
+            retryDelay = std::min(retryDelay * 2, OUTBOX_MAX_RETRY_DELAY);
+        }
+
+        outbox.WaitForAppending(OUTBOX_POLL_INTERVAL);
+    }
+
+    outbox.Close();
+}
\ No newline at end of file
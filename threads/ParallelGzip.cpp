@@ -0,0 +1,357 @@
+/**
+ * -----------------------------------------------------
+ * File        ParallelGzip.cpp
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "ParallelGzip.h"
+#include "ThreadPolicy.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+ParallelGzip::ParallelGzip(int level, int threads) : level(level), threads(threads), stopping(false) {
+    if (this->threads <= 0) {
+        this->threads = ParallelGzip::GetDefaultThreads();
+    }
+
+    this->threads = std::min(this->threads, GZIP_MAX_THREADS);
+    this->level = std::max(1, std::min(this->level, 9));
+}
+
+ParallelGzip::~ParallelGzip() {
+    this->StopWorkers();
+}
+
+bool ParallelGzip::Compress(const char* from, const char* to, std::function<bool()> shouldAbort) {
+    FileReader reader;
+    if (!reader.Open(from)) {
+        this->error = "Couldn't open file";
+        return false;
+    }
+
+    FileWriter writer;
+    if (!writer.Open(to)) {
+        this->error = "Couldn't create archive";
+        return false;
+    }
+
+    bool success = this->WriteHeader(writer, from) && this->CompressBlocks(reader, writer, shouldAbort);
+    if (!writer.Close() && success) {
+        this->error = "Couldn't write archive";
+        success = false;
+    }
+
+    // Never leave a broken archive behind
+    if (!success) {
+        remove(to);
+    }
+
+    return success;
+}
+
+const std::string& ParallelGzip::GetError() const {
+    return this->error;
+}
+
+int ParallelGzip::GetThreads() const {
+    return this->threads;
+}
+
+int ParallelGzip::GetDefaultThreads() {
+    // Leave one core for the game
+    int cores = static_cast<int>(std::thread::hardware_concurrency());
+    return std::max(1, std::min(cores - 1, GZIP_MAX_THREADS));
+}
+
+bool ParallelGzip::WriteHeader(FileWriter& writer, const char* from) {
+    // Keep the name of the file like gzip does, so it's restored when extracting
+    const char* name = from;
+    for (const char* c = from; *c; c++) {
+        if (*c == '/' || *c == '\\') {
+            name = c + 1;
+        }
+    }
+
+    // Magic, deflate, the name flag, no modification time, the extra flags of the level and the OS
+    unsigned char header[10] = { 0x1f, 0x8b, 8, 8, 0, 0, 0, 0, 0, 0 };
+    header[8] = this->level == 9 ? 2 : (this->level == 1 ? 4 : 0);
+#if defined _WIN32 || defined _WIN64
+    header[9] = 0;
+#else
+    header[9] = 3;
+#endif
+
+    if (!writer.Write(reinterpret_cast<const char*>(header), sizeof(header)) || !writer.Write(name, strlen(name) + 1)) {
+        this->error = "Couldn't write archive";
+        return false;
+    }
+
+    return true;
+}
+
+bool ParallelGzip::CompressBlocks(FileReader& reader, FileWriter& writer, std::function<bool()> shouldAbort) {
+    this->StartWorkers();
+
+    // Blocks which are compressed or wait to be written, in the order of the file
+    std::deque<std::shared_ptr<GzipBlock_t>> pending;
+    size_t maxPending = static_cast<size_t>(this->threads * GZIP_BLOCKS_PER_THREAD);
+
+    uint32_t crc = crc32(0L, Z_NULL, 0);
+    uint64_t length = 0;
+    bool success = true;
+
+    std::shared_ptr<GzipBlock_t> block = std::make_shared<GzipBlock_t>();
+    block->input.reserve(GZIP_BLOCK_SIZE);
+
+    const char* data;
+    size_t size = 0;
+    bool finished = false;
+
+    while (success && !finished) {
+        if (shouldAbort()) {
+            this->error = "Compressing was aborted";
+            success = false;
+            break;
+        }
+
+        // Fill the block from the chunks of the file
+        while (block->input.size() < GZIP_BLOCK_SIZE) {
+            if (size == 0) {
+                size = reader.Next(&data);
+                if (size == 0) {
+                    finished = true;
+                    break;
+                }
+            }
+
+            size_t part = std::min(GZIP_BLOCK_SIZE - block->input.size(), size);
+            block->input.append(data, part);
+            data += part;
+            size -= part;
+        }
+
+        if (reader.HasFailed()) {
+            this->error = "Couldn't read file";
+            success = false;
+            break;
+        }
+
+        // The last block may be empty, it only finishes the stream then
+        block->last = finished;
+        block->done = false;
+        block->failed = false;
+
+        // Wait for the oldest block before reading further, so the memory stays bounded
+        while (success && pending.size() >= maxPending) {
+            success = this->WriteBlock(writer, pending.front(), &crc, &length);
+            pending.pop_front();
+        }
+
+        if (!success) {
+            break;
+        }
+
+        std::shared_ptr<GzipBlock_t> next;
+        if (!finished) {
+            next = std::make_shared<GzipBlock_t>();
+            next->input.reserve(GZIP_BLOCK_SIZE);
+
+            size_t dictionarySize = std::min<size_t>(GZIP_DICTIONARY_SIZE, block->input.size());
+            next->dictionary.assign(block->input, block->input.size() - dictionarySize, dictionarySize);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->jobs.push_back(block);
+        }
+
+        this->queued.notify_one();
+        pending.push_back(block);
+
+        block = next;
+    }
+
+    // Write the remaining blocks in order
+    while (success && !pending.empty()) {
+        success = this->WriteBlock(writer, pending.front(), &crc, &length);
+        pending.pop_front();
+    }
+
+    this->StopWorkers();
+
+    if (!success) {
+        return false;
+    }
+
+    // CRC32 and the length modulo 2^32, both little endian
+    unsigned char trailer[8];
+    for (int i = 0; i < 4; i++) {
+        trailer[i] = static_cast<unsigned char>((crc >> (i * 8)) & 0xff);
+        trailer[i + 4] = static_cast<unsigned char>((length >> (i * 8)) & 0xff);
+    }
+
+    if (!writer.Write(reinterpret_cast<const char*>(trailer), sizeof(trailer))) {
+        this->error = "Couldn't write archive";
+        return false;
+    }
+
+    return true;
+}
+
+bool ParallelGzip::WriteBlock(FileWriter& writer, std::shared_ptr<GzipBlock_t> block, uint32_t* crc, uint64_t* length) {
+    {
+        std::unique_lock<std::mutex> lock(this->mutex);
+        this->compressed.wait(lock, [&block]() -> bool {
+            return block->done;
+        });
+    }
+
+    if (block->failed) {
+        this->error = "Couldn't compress file";
+        return false;
+    }
+
+    if (!writer.Write(block->output.data(), block->output.size())) {
+        this->error = "Couldn't write archive";
+        return false;
+    }
+
+    // The CRC of the file is combined from the CRCs of the blocks
+    *crc = crc32_combine(*crc, block->crc, static_cast<z_off_t>(block->input.size()));
+    *length += block->input.size();
+
+    return true;
+}
+
+void ParallelGzip::StartWorkers() {
+    this->stopping = false;
+
+    for (int i = 0; i < this->threads; i++) {
+        this->workers.emplace_back(&ParallelGzip::Work, this);
+    }
+}
+
+void ParallelGzip::StopWorkers() {
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->stopping = true;
+        this->jobs.clear();
+    }
+
+    this->queued.notify_all();
+    for (auto it = this->workers.begin(); it != this->workers.end(); ++it) {
+        it->join();
+    }
+
+    this->workers.clear();
+}
+
+void ParallelGzip::Work() {
+    threadPolicies.Apply(THREAD_COMPRESS);
+
+    // Every worker reuses its own stream for all of its blocks
+    z_stream stream;
+    memset(&stream, 0, sizeof(stream));
+    bool initialized = deflateInit2(&stream, this->level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) == Z_OK;
+
+    while (true) {
+        std::shared_ptr<GzipBlock_t> block;
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->queued.wait(lock, [this]() -> bool {
+                return this->stopping || !this->jobs.empty();
+            });
+
+            if (this->stopping) {
+                break;
+            }
+
+            block = this->jobs.front();
+            this->jobs.pop_front();
+        }
+
+        // Stay away from the game thread if it moved to another core
+        threadPolicies.Refresh();
+
+        bool success = initialized && ParallelGzip::CompressBlock(&stream, block.get());
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            block->failed = !success;
+            block->done = true;
+        }
+
+        this->compressed.notify_all();
+    }
+
+    if (initialized) {
+        deflateEnd(&stream);
+    }
+}
+
+bool ParallelGzip::CompressBlock(z_stream* stream, GzipBlock_t* block) {
+    if (deflateReset(stream) != Z_OK) {
+        return false;
+    }
+
+    if (!block->dictionary.empty() &&
+        deflateSetDictionary(stream, reinterpret_cast<const Bytef*>(block->dictionary.data()), static_cast<uInt>(block->dictionary.size())) != Z_OK) {
+        return false;
+    }
+
+    // Room for the flush marker besides the bound
+    block->output.resize(deflateBound(stream, static_cast<uLong>(block->input.size())) + 16);
+
+    stream->next_in = reinterpret_cast<Bytef*>(&block->input[0]);
+    stream->avail_in = static_cast<uInt>(block->input.size());
+    stream->next_out = reinterpret_cast<Bytef*>(&block->output[0]);
+    stream->avail_out = static_cast<uInt>(block->output.size());
+
+    // Only the last block finishes the stream, the others end on a byte boundary with a sync flush
+    int flush = block->last ? Z_FINISH : Z_SYNC_FLUSH;
+    while (true) {
+        int result = deflate(stream, flush);
+        if (result == Z_STREAM_ERROR) {
+            return false;
+        }
+
+        if (block->last ? result == Z_STREAM_END : (stream->avail_in == 0 && stream->avail_out > 0)) {
+            break;
+        }
+
+        // Grow the output, which should never be needed with the bound
+        size_t used = block->output.size() - stream->avail_out;
+        block->output.resize(block->output.size() * 2);
+
+        stream->next_out = reinterpret_cast<Bytef*>(&block->output[used]);
+        stream->avail_out = static_cast<uInt>(block->output.size() - used);
+    }
+
+    block->output.resize(block->output.size() - stream->avail_out);
+    block->crc = crc32(0L, reinterpret_cast<const Bytef*>(block->input.data()), static_cast<uInt>(block->input.size()));
+
+    // The dictionary isn't needed anymore
+    block->dictionary.clear();
+    block->dictionary.shrink_to_fit();
+
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,100 @@
+/**
+ * -----------------------------------------------------
+ * File        ParallelGzip.h
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#ifndef _SYSTEM2_PARALLEL_GZIP_H_
+#define _SYSTEM2_PARALLEL_GZIP_H_
+
+#include "FileIO.h"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <zlib.h>
+
+// Size of the blocks which are compressed independently
+#define GZIP_BLOCK_SIZE 1048576
+
+// Every block is primed with the end of the previous one, so the ratio is almost the one of a single stream
+#define GZIP_DICTIONARY_SIZE 32768
+
+#define GZIP_MAX_THREADS 32
+
+// Blocks per thread which may be read ahead or wait to be written
+#define GZIP_BLOCKS_PER_THREAD 2
+
+typedef struct {
+    std::string input;
+    std::string dictionary;
+    std::string output;
+    uint32_t crc;
+    bool last;
+    bool done;
+    bool failed;
+} GzipBlock_t;
+
+// Compresses a file into a standard gzip file with a pool of threads, like pigz.
+// Each block ends on a byte boundary, so the compressed blocks just have to be written in order.
+class ParallelGzip {
+private:
+    int level;
+    int threads;
+    std::string error;
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable queued;
+    std::condition_variable compressed;
+    std::deque<std::shared_ptr<GzipBlock_t>> jobs;
+    bool stopping;
+
+    bool WriteHeader(FileWriter& writer, const char* from);
+    bool CompressBlocks(FileReader& reader, FileWriter& writer, std::function<bool()> shouldAbort);
+    bool WriteBlock(FileWriter& writer, std::shared_ptr<GzipBlock_t> block, uint32_t* crc, uint64_t* length);
+
+    void StartWorkers();
+    void StopWorkers();
+    void Work();
+
+    static bool CompressBlock(z_stream* stream, GzipBlock_t* block);
+
+public:
+    // Level from 1 to 9, 0 threads uses all cores except one for the game
+    ParallelGzip(int level, int threads);
+    ~ParallelGzip();
+
+    bool Compress(const char* from, const char* to, std::function<bool()> shouldAbort);
+
+    const std::string& GetError() const;
+    int GetThreads() const;
+
+    static int GetDefaultThreads();
+};
+
+#endif
\ No newline at end of file
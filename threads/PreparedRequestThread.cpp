@@ -0,0 +1,89 @@
+/**
+ * -----------------------------------------------------
+ * File        PreparedRequestThread.cpp
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "PreparedRequestThread.h"
+#include "HTTPResponseCallback.h"
+
+PreparedRequestThread::PreparedRequestThread(HTTPRequest* httpRequest, HTTPRequestMethod requestMethod, std::shared_ptr<CurlHandlePool> pool)
+    : HTTPRequestThread(httpRequest, requestMethod), pool(pool) {};
+
+std::shared_ptr<CurlHandlePool> PreparedRequestThread::Prepare(HTTPRequest* httpRequest, HTTPRequestMethod requestMethod) {
+    CURL* curl = curl_easy_init();
+    if (!curl) {
+        return nullptr;
+    }
+
+    // The thread is never run, it is only used to apply the options
+    PreparedRequestThread builder(httpRequest, requestMethod, nullptr);
+    builder.ApplyOptions(curl);
+
+    struct curl_slist* headers = builder.ApplyHTTPOptions(curl);
+    return std::make_shared<CurlHandlePool>(curl, headers);
+}
+
+void PreparedRequestThread::Run() {
+    CURL* curl = this->pool->Acquire();
+    if (!curl) {
+        system2Extension.AppendCallback(std::make_shared<HTTPResponseCallback>(this->httpRequest, "Couldn't initialize CURL", this->requestMethod));
+        return;
+    }
+
+    // Only apply what belongs to this transfer, everything else is already set on the handle
+    WriteDataInfo writeData = { std::make_shared<ContentBuffer>(this->httpRequest->maxMemoryContent), 0, nullptr, curl };
+    std::string error;
+    if (!this->ApplyTransfer(curl, writeData, error)) {
+        system2Extension.AppendCallback(std::make_shared<HTTPResponseCallback>(this->httpRequest, error, this->requestMethod));
+        this->pool->Release(curl);
+
+        return;
+    }
+
+    // Collect error information
+    char errorBuffer[CURL_ERROR_SIZE + 1];
+    errorBuffer[0] = '\0';
+    curl_easy_setopt(curl, CURLOPT_ERRORBUFFER, errorBuffer);
+
+    // Always replace the body, as a reused handle still points to the body of the previous transfer
+    this->httpRequest->EncodeBody();
+    curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, static_cast<long>(this->httpRequest->bodyData.size()));
+    curl_easy_setopt(curl, CURLOPT_POSTFIELDS, this->httpRequest->bodyData.c_str());
+    this->ApplyMethod(curl);
+
+    // Get response headers, they are stored in the arena of the response
+    std::shared_ptr<Arena> arena = std::make_shared<Arena>();
+    HeaderInfo headerData = { curl, ArenaStringMap(ArenaAllocator<char>(arena.get())), -1L };
+    curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, HTTPRequestThread::ReadHeader);
+    curl_easy_setopt(curl, CURLOPT_HEADERDATA, &headerData);
+
+    CURLcode result = this->PerformLimited(curl, errorBuffer);
+    std::shared_ptr<HTTPResponseCallback> callback = this->CreateCallback(curl, result, errorBuffer, writeData, arena, headerData);
+
+    // The handle keeps its connection for the next transfer
+    curl_easy_setopt(curl, CURLOPT_ERRORBUFFER, nullptr);
+    curl_easy_setopt(curl, CURLOPT_HEADERDATA, nullptr);
+    this->pool->Release(curl);
+
+    // Append callback so it can be fired
+    system2Extension.AppendCallback(callback);
+}
\ No newline at end of file
@@ -0,0 +1,45 @@
+/**
+ * -----------------------------------------------------
+ * File        PreparedRequestThread.h
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#ifndef _SYSTEM2_PREPARED_REQUEST_THREAD_H_
+#define _SYSTEM2_PREPARED_REQUEST_THREAD_H_
+
+#include "HTTPRequestThread.h"
+#include "CurlHandlePool.h"
+
+class PreparedRequestThread : public HTTPRequestThread {
+private:
+    std::shared_ptr<CurlHandlePool> pool;
+
+public:
+    PreparedRequestThread(HTTPRequest* httpRequest, HTTPRequestMethod requestMethod, std::shared_ptr<CurlHandlePool> pool);
+
+    // Builds a template handle with all options and headers of the request which don't change between transfers
+    static std::shared_ptr<CurlHandlePool> Prepare(HTTPRequest* httpRequest, HTTPRequestMethod requestMethod);
+
+protected:
+    virtual void Run();
+};
+
+#endif
\ No newline at end of file
@@ -28,9 +28,14 @@
 // Set initial last progress frame
 uint32_t RequestThread::lastProgressFrame = 0;
 
-RequestThread::RequestThread(Request* request) : Thread(), request(request) {};
+RequestThread::RequestThread(Request* request) : Thread(), request(request), timeoutByDeadline(false) {};
 
-bool RequestThread::ApplyRequest(CURL* curl, WriteDataInfo& writeData) {
+bool RequestThread::ApplyRequest(CURL* curl, WriteDataInfo& writeData, std::string& error) {
+    this->ApplyOptions(curl);
+    return this->ApplyTransfer(curl, writeData, error);
+}
+
+void RequestThread::ApplyOptions(CURL* curl) {
     // Set URL and port
     curl_easy_setopt(curl, CURLOPT_URL, this->request->url.c_str());
     if (this->request->port >= 0) {
@@ -80,6 +85,65 @@ bool RequestThread::ApplyRequest(CURL* curl, WriteDataInfo& writeData) {
         }
     }
 
+    // Apply socket and transfer tuning
+    if (this->request->tuningProfile) {
+        this->request->tuningProfile->Apply(curl);
+    }
+
+    // Connect through an unix domain socket instead of TCP
+    if (!this->request->unixSocketPath.empty()) {
+        if (this->request->unixSocketAbstract) {
+            curl_easy_setopt(curl, CURLOPT_ABSTRACT_UNIX_SOCKET, this->request->unixSocketPath.c_str());
+        } else {
+            curl_easy_setopt(curl, CURLOPT_UNIX_SOCKET_PATH, this->request->unixSocketPath.c_str());
+        }
+    }
+
+    // Set timeout
+    if (this->request->timeout >= 0) {
+        curl_easy_setopt(curl, CURLOPT_TIMEOUT, this->request->timeout);
+    } else {
+        // Set connect timeout to a better default value
+        curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, 60);
+    }
+
+    // Prevent signals to interrupt our thread
+    curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+}
+
+bool RequestThread::ApplyDeadline(CURL* curl, double expectedTime) {
+    long timeout = this->request->timeout > 0 ? this->request->timeout * 1000L : 0L;
+    this->timeoutByDeadline = false;
+
+    if (this->request->hasDeadline) {
+        // Don't start a transfer which would only be thrown away
+        int remaining = this->request->GetRemainingTime();
+        if (remaining <= 0 || remaining < expectedTime) {
+            this->request->error = REQUEST_ERROR_DEADLINE;
+            return false;
+        }
+
+        if (timeout == 0 || remaining < timeout) {
+            timeout = remaining;
+            this->timeoutByDeadline = true;
+        }
+    }
+
+    // Always set, as a reused handle may still have the limit of a previous transfer
+    curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, timeout);
+    return true;
+}
+
+bool RequestThread::CheckDeadlineTimeout(CURLcode result) {
+    if (result != CURLE_OPERATION_TIMEDOUT || !this->timeoutByDeadline) {
+        return false;
+    }
+
+    this->request->error = REQUEST_ERROR_DEADLINE;
+    return true;
+}
+
+bool RequestThread::ApplyTransfer(CURL* curl, WriteDataInfo& writeData, std::string& error) {
     // Check if also write to an output file
     if (!this->request->outputFile.empty()) {
         // Get the full path to the file
@@ -87,8 +151,24 @@ bool RequestThread::ApplyRequest(CURL* curl, WriteDataInfo& writeData) {
         smutils->BuildPath(Path_Game, filePath, sizeof(filePath), this->request->outputFile.c_str());
 
         // Open the file writeable
-        writeData.file = fopen(filePath, "wb");
-        if (!writeData.file) {
+        writeData.file = std::make_unique<WriteBehind>();
+        if (!writeData.file->Open(filePath, static_cast<size_t>(this->request->writeBehind))) {
+            writeData.file.reset();
+            error = "Can not open output file";
+            return false;
+        }
+    }
+
+    // Check if the response should be extracted while it arrives
+    if (!this->request->extractDirectory.empty()) {
+        char extractPath[PLATFORM_MAX_PATH + 1];
+        smutils->BuildPath(Path_Game, extractPath, sizeof(extractPath), this->request->extractDirectory.c_str());
+
+        writeData.extractor = std::make_unique<StreamExtractor>();
+        if (!writeData.extractor->Open(extractPath)) {
+            error = writeData.extractor->HasError() ? writeData.extractor->GetError() : "Can not open extract directory";
+            writeData.extractor.reset();
+            writeData.file.reset();
             return false;
         }
     }
@@ -104,17 +184,6 @@ bool RequestThread::ApplyRequest(CURL* curl, WriteDataInfo& writeData) {
         curl_easy_setopt(curl, CURLOPT_XFERINFODATA, this);
     }
 
-    // Set timeout
-    if (this->request->timeout >= 0) {
-        curl_easy_setopt(curl, CURLOPT_TIMEOUT, this->request->timeout);
-    } else {
-        // Set connect timeout to a better default value
-        curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, 60);
-    }
-
-    // Prevent signals to interrupt our thread
-    curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
-
     return true;
 }
 
@@ -123,14 +192,46 @@ size_t RequestThread::WriteData(char* ptr, size_t size, size_t nmemb, void* user
     RequestThread::WriteDataInfo* dataInfo = (RequestThread::WriteDataInfo*)userdata;
 
     size_t realsize = size * nmemb;
+
+    if (dataInfo->contentLength == 0) {
+        // Error pages and redirects aren't archives, so they are kept as content
+        long statusCode;
+        if (dataInfo->extractor && curl_easy_getinfo(dataInfo->curl, CURLINFO_RESPONSE_CODE, &statusCode) == CURLE_OK && statusCode >= 300) {
+            dataInfo->extractor.reset();
+        }
+
+        // Prepare the content or the file for the expected length with the first data
+        curl_off_t expectedLength;
+        if (curl_easy_getinfo(dataInfo->curl, CURLINFO_CONTENT_LENGTH_DOWNLOAD_T, &expectedLength) == CURLE_OK && expectedLength > 0) {
+            if (dataInfo->file) {
+                dataInfo->file->Expect(static_cast<uint64_t>(expectedLength));
+            } else if (!dataInfo->extractor) {
+                dataInfo->content->Reserve(static_cast<uint64_t>(expectedLength));
+            }
+        }
+    }
+
     dataInfo->contentLength += realsize;
 
-    if (dataInfo->file) {
+    if (dataInfo->extractor) {
+        // Extract the archive, the output file still gets a copy of it
+        if (!dataInfo->extractor->Write(ptr, realsize)) {
+            return 0;
+        }
+
+        if (dataInfo->file && !dataInfo->file->Write(ptr, realsize)) {
+            return 0;
+        }
+    } else if (dataInfo->file) {
         // Write to the file if any file is opened
-        return fwrite(ptr, size, nmemb, dataInfo->file);
+        if (!dataInfo->file->Write(ptr, realsize)) {
+            return 0;
+        }
     } else {
-        // Otherwise add data to content
-        dataInfo->content.append(ptr, realsize);
+        // Otherwise add data to content, which may be moved to a temporary file
+        if (!dataInfo->content->Append(ptr, realsize)) {
+            return 0;
+        }
     }
 
     return realsize;
@@ -138,7 +239,14 @@ size_t RequestThread::WriteData(char* ptr, size_t size, size_t nmemb, void* user
 
 size_t RequestThread::ReadFile(char* buffer, size_t size, size_t nitems, void* instream) {
     // Just read the content from the file
-    return fread(buffer, size, nitems, (FILE*)instream);
+    FileReader* reader = static_cast<FileReader*>(instream);
+
+    size_t read = reader->Read(buffer, size * nitems);
+    if (read == 0 && reader->HasFailed()) {
+        return CURL_READFUNC_ABORT;
+    }
+
+    return read;
 }
 
 size_t RequestThread::ProgressUpdated(void* clientp, curl_off_t dltotal, curl_off_t dlnow, curl_off_t ultotal, curl_off_t ulnow) {
@@ -158,4 +266,15 @@ size_t RequestThread::ProgressUpdated(void* clientp, curl_off_t dltotal, curl_of
     requestThread->lastProgressFrame = system2Extension.GetFrames();
 
     return 0;
+}
+
+bool RequestThread::CloseOutputFile(WriteDataInfo& writeData) {
+    if (!writeData.file) {
+        return true;
+    }
+
+    bool success = writeData.file->Close();
+    writeData.file.reset();
+
+    return success;
 }
\ No newline at end of file
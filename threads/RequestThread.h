@@ -28,18 +28,27 @@
 #include "extension.h"
 #include "Request.h"
 #include "Thread.h"
+#include "ContentBuffer.h"
+#include "WriteBehind.h"
+#include "StreamExtractor.h"
 #include <map>
+#include <memory>
 
 class RequestThread : public Thread {
 private:
     static uint32_t lastProgressFrame;
     Request* request;
 
+    // Whether the last ApplyDeadline shortened the timeout to the deadline
+    bool timeoutByDeadline;
+
 public:
     typedef struct {
-        std::string content;
-        size_t contentLength;
-        FILE* file;
+        std::shared_ptr<ContentBuffer> content;
+        uint64_t contentLength;
+        std::unique_ptr<WriteBehind> file;
+        CURL* curl;
+        std::unique_ptr<StreamExtractor> extractor;
     } WriteDataInfo;
 
     explicit RequestThread(Request* request);
@@ -49,7 +58,22 @@ public:
     static size_t ProgressUpdated(void* clientp, curl_off_t dltotal, curl_off_t dlnow, curl_off_t ultotal, curl_off_t ulnow);
 
 protected:
-    bool ApplyRequest(CURL* curl, WriteDataInfo& writeData);
+    bool ApplyRequest(CURL* curl, WriteDataInfo& writeData, std::string& error);
+
+    // Options which are the same for every transfer of the request
+    void ApplyOptions(CURL* curl);
+
+    // Options which belong to a single transfer, returns false with the error if a file or directory can't be opened
+    bool ApplyTransfer(CURL* curl, WriteDataInfo& writeData, std::string& error);
+
+    // Limits the transfer to the time left until the deadline, returns false if it can't finish in time
+    bool ApplyDeadline(CURL* curl, double expectedTime);
+
+    // Returns true if the transfer timed out because of the deadline and not because of the host, and marks the error
+    bool CheckDeadlineTimeout(CURLcode result);
+
+    // Closes the output file if opened, returns false if not all data could be written to it
+    static bool CloseOutputFile(WriteDataInfo& writeData);
 };
 
 #endif
\ No newline at end of file
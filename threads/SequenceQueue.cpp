@@ -0,0 +1,103 @@
+/**
+ * -----------------------------------------------------
+ * File        SequenceQueue.cpp
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "SequenceQueue.h"
+
+SequenceQueue::SequenceQueue()
+    : pending(0), maxInFlight(SEQUENCE_DEFAULT_IN_FLIGHT), maxRetries(SEQUENCE_DEFAULT_RETRIES), closed(false) {};
+
+SequenceQueue::~SequenceQueue() {
+    // Requests which were never taken by the thread
+    for (auto it = this->items.begin(); it != this->items.end(); ++it) {
+        delete it->request;
+    }
+}
+
+void SequenceQueue::Add(HTTPRequest* request, HTTPRequestMethod method) {
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->items.push_back({ request, method });
+        this->pending++;
+    }
+
+    this->condition.notify_one();
+}
+
+void SequenceQueue::Close() {
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->closed = true;
+    }
+
+    this->condition.notify_one();
+}
+
+void SequenceQueue::Take(std::deque<SequenceItem_t>& items, int milliseconds) {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    if (this->items.empty() && !this->closed && milliseconds > 0) {
+        this->condition.wait_for(lock, std::chrono::milliseconds(milliseconds));
+    }
+
+    while (!this->items.empty()) {
+        items.push_back(this->items.front());
+        this->items.pop_front();
+    }
+}
+
+void SequenceQueue::Delivered() {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (this->pending > 0) {
+        this->pending--;
+    }
+}
+
+bool SequenceQueue::IsFinished() {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->closed && this->pending == 0;
+}
+
+size_t SequenceQueue::GetPending() {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->pending;
+}
+
+int SequenceQueue::GetMaxInFlight() {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->maxInFlight;
+}
+
+void SequenceQueue::SetMaxInFlight(int maxInFlight) {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->maxInFlight = maxInFlight;
+}
+
+int SequenceQueue::GetMaxRetries() {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->maxRetries;
+}
+
+void SequenceQueue::SetMaxRetries(int maxRetries) {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->maxRetries = maxRetries;
+}
\ No newline at end of file
@@ -0,0 +1,85 @@
+/**
+ * -----------------------------------------------------
+ * File        SequenceQueue.h
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#ifndef _SYSTEM2_SEQUENCE_QUEUE_H_
+#define _SYSTEM2_SEQUENCE_QUEUE_H_
+
+#include "HTTPRequest.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+// Default number of requests of a sequence which may be in flight at the same time
+#define SEQUENCE_DEFAULT_IN_FLIGHT 8
+#define SEQUENCE_MAX_IN_FLIGHT 100
+
+// Default number of retries of a failed request before its failure is delivered
+#define SEQUENCE_DEFAULT_RETRIES 5
+
+typedef struct {
+    HTTPRequest* request;
+    HTTPRequestMethod method;
+} SequenceItem_t;
+
+/**
+ * Requests of a sequence channel which are shared between the game thread and the sequence thread.
+ */
+class SequenceQueue {
+private:
+    std::mutex mutex;
+    std::condition_variable condition;
+
+    std::deque<SequenceItem_t> items;
+    size_t pending;
+    int maxInFlight;
+    int maxRetries;
+    bool closed;
+
+public:
+    SequenceQueue();
+    ~SequenceQueue();
+
+    // Takes ownership of the request
+    void Add(HTTPRequest* request, HTTPRequestMethod method);
+    void Close();
+
+    // Moves the new requests to the end of the given ones, waits if there are none
+    void Take(std::deque<SequenceItem_t>& items, int milliseconds);
+
+    // Called by the sequence thread when the callback of a request was delivered
+    void Delivered();
+
+    // Whether the channel was deleted and all requests were delivered
+    bool IsFinished();
+
+    size_t GetPending();
+    int GetMaxInFlight();
+    void SetMaxInFlight(int maxInFlight);
+    int GetMaxRetries();
+    void SetMaxRetries(int maxRetries);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,299 @@
+/**
+ * -----------------------------------------------------
+ * File        SequenceThread.cpp
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "SequenceThread.h"
+#include "HTTPRequestThread.h"
+#include "HTTPResponseCallback.h"
+#include "HostLimiter.h"
+
+#include <algorithm>
+
+// A single request of a sequence, the thread is never run, it only prepares the transfer for the multi handle
+class SequenceTransfer : public HTTPRequestThread {
+private:
+    CURL* curl;
+    struct curl_slist* headers;
+    WriteDataInfo writeData;
+    std::shared_ptr<Arena> arena;
+    std::unique_ptr<HeaderInfo> headerData;
+    char errorBuffer[CURL_ERROR_SIZE + 1];
+    CURLcode result;
+    bool started;
+    bool done;
+    bool delivered;
+
+public:
+    SequenceTransfer(HTTPRequest* httpRequest, HTTPRequestMethod requestMethod)
+        : HTTPRequestThread(httpRequest, requestMethod), curl(nullptr), headers(nullptr), writeData({ nullptr, 0, nullptr, nullptr }),
+        result(CURLE_OK), started(false), done(false), delivered(false) {
+        this->errorBuffer[0] = '\0';
+    }
+
+    ~SequenceTransfer() {
+        this->Reset(nullptr);
+
+        // The request belongs to the callback once it was delivered
+        if (!this->delivered) {
+            delete this->httpRequest;
+        }
+    }
+
+    bool IsStarted() const {
+        return this->started;
+    }
+
+    bool IsDone() const {
+        return this->done;
+    }
+
+    void Start(CURLM* multi) {
+        this->started = true;
+
+        this->curl = curl_easy_init();
+        if (!this->curl) {
+            this->Fail("Couldn't initialize CURL");
+            return;
+        }
+
+        this->writeData = { std::make_shared<ContentBuffer>(this->httpRequest->maxMemoryContent), 0, nullptr, this->curl };
+        std::string error;
+        if (!this->ApplyRequest(this->curl, this->writeData, error)) {
+            this->Fail(error.c_str());
+            return;
+        }
+
+        if (!this->ApplyDeadline(this->curl, 0.0)) {
+            this->Fail("Deadline passed before the request could start");
+            return;
+        }
+
+        this->errorBuffer[0] = '\0';
+        curl_easy_setopt(this->curl, CURLOPT_ERRORBUFFER, this->errorBuffer);
+        this->headers = this->ApplyHTTPOptions(this->curl);
+
+        // Set data to send, the size is given as the data may contain NUL bytes
+        this->httpRequest->EncodeBody();
+        if (!this->httpRequest->bodyData.empty()) {
+            curl_easy_setopt(this->curl, CURLOPT_POSTFIELDSIZE, static_cast<long>(this->httpRequest->bodyData.size()));
+            curl_easy_setopt(this->curl, CURLOPT_POSTFIELDS, this->httpRequest->bodyData.c_str());
+        }
+
+        // Get response headers, they are stored in the arena of the response
+        this->arena = std::make_shared<Arena>();
+        this->headerData.reset(new HeaderInfo({ this->curl, ArenaStringMap(ArenaAllocator<char>(this->arena.get())), -1L }));
+        curl_easy_setopt(this->curl, CURLOPT_HEADERFUNCTION, HTTPRequestThread::ReadHeader);
+        curl_easy_setopt(this->curl, CURLOPT_HEADERDATA, this->headerData.get());
+
+        this->ApplyMethod(this->curl);
+
+        // Wait for the connection of the previous requests instead of opening a new one
+        curl_easy_setopt(this->curl, CURLOPT_PIPEWAIT, 1L);
+        curl_easy_setopt(this->curl, CURLOPT_PRIVATE, this);
+
+        if (curl_multi_add_handle(multi, this->curl) != CURLM_OK) {
+            this->Fail("Couldn't execute HTTP request");
+        }
+    }
+
+    void Finish(CURLcode result) {
+        this->result = result;
+        this->done = true;
+    }
+
+    HostOutcome GetOutcome() {
+        // Retrying a request which timed out because of its deadline can't succeed
+        if (this->CheckDeadlineTimeout(this->result)) {
+            return OUTCOME_IGNORED;
+        }
+
+        long statusCode = 0;
+        if (this->result == CURLE_OK) {
+            curl_easy_getinfo(this->curl, CURLINFO_RESPONSE_CODE, &statusCode);
+        }
+
+        return HostLimiter::GetOutcome(this->result, statusCode);
+    }
+
+    std::shared_ptr<HTTPResponseCallback> Deliver(CURLM* multi) {
+        std::shared_ptr<HTTPResponseCallback> callback;
+        if (this->curl && this->headerData) {
+            callback = this->CreateCallback(this->curl, this->result, this->errorBuffer, this->writeData, this->arena, *this->headerData);
+        } else {
+            callback = std::make_shared<HTTPResponseCallback>(this->httpRequest, this->errorBuffer, this->requestMethod);
+        }
+
+        // The callback already copied everything it needs from the handle
+        this->Reset(multi);
+        this->delivered = true;
+
+        return callback;
+    }
+
+    // Stops the transfer, so it can be started again
+    void Reset(CURLM* multi) {
+        if (this->curl) {
+            if (multi) {
+                curl_multi_remove_handle(multi, this->curl);
+            }
+
+            curl_easy_cleanup(this->curl);
+            this->curl = nullptr;
+        }
+
+        if (this->headers) {
+            curl_slist_free_all(this->headers);
+            this->headers = nullptr;
+        }
+
+        // Also closes the output file if opened
+        this->writeData = { nullptr, 0, nullptr, nullptr };
+        this->headerData.reset();
+        this->arena = nullptr;
+        this->started = false;
+        this->done = false;
+    }
+
+protected:
+    virtual void Run() {};
+
+private:
+    void Fail(const char* error) {
+        // Failures which happen before sending are never retried
+        snprintf(this->errorBuffer, sizeof(this->errorBuffer), "%s", error);
+        this->result = CURLE_FAILED_INIT;
+        this->done = true;
+
+        if (this->curl) {
+            curl_easy_cleanup(this->curl);
+            this->curl = nullptr;
+        }
+    }
+};
+
+
+SequenceThread::SequenceThread(std::shared_ptr<SequenceQueue> queue) : queue(queue) {};
+
+SequenceThread::~SequenceThread() {
+    // The thread uses the queue until it is finished
+    this->TerminateThread();
+}
+
+void SequenceThread::Run() {
+    CURLM* multi = curl_multi_init();
+    if (!multi) {
+        return;
+    }
+
+    // One connection per host keeps the order on the wire, with HTTP/2 the requests overlap as streams on it
+    curl_multi_setopt(multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+    curl_multi_setopt(multi, CURLMOPT_MAX_HOST_CONNECTIONS, 1L);
+
+    // Requests which aren't delivered yet in the order they were added
+    std::deque<std::unique_ptr<SequenceTransfer>> transfers;
+    std::deque<SequenceItem_t> items;
+
+    int retries = 0;
+    int retryDelay = SEQUENCE_RETRY_DELAY;
+    std::chrono::steady_clock::time_point retryAt;
+
+    while (!this->ShouldTerminate()) {
+        // Only block for new requests if there is nothing else to do
+        this->queue->Take(items, transfers.empty() ? SEQUENCE_POLL_INTERVAL : 0);
+        for (auto it = items.begin(); it != items.end(); ++it) {
+            transfers.push_back(std::unique_ptr<SequenceTransfer>(new SequenceTransfer(it->request, it->method)));
+        }
+        items.clear();
+
+        if (transfers.empty()) {
+            if (this->queue->IsFinished()) {
+                break;
+            }
+
+            continue;
+        }
+
+        // Start the next requests in order, the window also holds finished requests waiting for an earlier one
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        if (now >= retryAt) {
+            size_t window = std::min(transfers.size(), static_cast<size_t>(this->queue->GetMaxInFlight()));
+            for (size_t i = 0; i < window; i++) {
+                if (!transfers[i]->IsStarted()) {
+                    transfers[i]->Start(multi);
+                }
+            }
+        }
+
+        int running = 0;
+        curl_multi_perform(multi, &running);
+
+        CURLMsg* message;
+        int messagesLeft;
+        while ((message = curl_multi_info_read(multi, &messagesLeft))) {
+            if (message->msg == CURLMSG_DONE) {
+                SequenceTransfer* transfer = nullptr;
+                curl_easy_getinfo(message->easy_handle, CURLINFO_PRIVATE, &transfer);
+                if (transfer) {
+                    transfer->Finish(message->data.result);
+                }
+            }
+        }
+
+        // Deliver the callbacks in the order the requests were added
+        while (!transfers.empty() && transfers.front()->IsDone()) {
+            if (transfers.front()->GetOutcome() == OUTCOME_FAILURE && retries < this->queue->GetMaxRetries()) {
+                // Send the sequence again from the failed request, later ones may have been sent already
+                for (auto it = transfers.begin(); it != transfers.end(); ++it) {
+                    (*it)->Reset(multi);
+                }
+
+                retries++;
+                retryAt = std::chrono::steady_clock::now() + std::chrono::milliseconds(retryDelay);
+                retryDelay = std::min(retryDelay * 2, SEQUENCE_MAX_RETRY_DELAY);
+                break;
+            }
+
+            system2Extension.AppendCallback(transfers.front()->Deliver(multi));
+            transfers.pop_front();
+            this->queue->Delivered();
+
+            retries = 0;
+            retryDelay = SEQUENCE_RETRY_DELAY;
+        }
+
+        if (running > 0) {
+            curl_multi_wait(multi, nullptr, 0, SEQUENCE_POLL_INTERVAL, nullptr);
+        } else if (!transfers.empty() && std::chrono::steady_clock::now() < retryAt) {
+            std::this_thread::sleep_for(std::min(std::chrono::steady_clock::duration(retryAt - std::chrono::steady_clock::now()),
+                                                 std::chrono::steady_clock::duration(std::chrono::milliseconds(SEQUENCE_POLL_INTERVAL))));
+        }
+    }
+
+    // Requests which are still pending when the extension unloads are dropped
+    for (auto it = transfers.begin(); it != transfers.end(); ++it) {
+        (*it)->Reset(multi);
+    }
+    transfers.clear();
+
+    curl_multi_cleanup(multi);
+}
\ No newline at end of file
@@ -0,0 +1,51 @@
+/**
+ * -----------------------------------------------------
+ * File        SequenceThread.h
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#ifndef _SYSTEM2_SEQUENCE_THREAD_H_
+#define _SYSTEM2_SEQUENCE_THREAD_H_
+
+#include "Thread.h"
+#include "SequenceQueue.h"
+
+// The sequence thread checks for new requests and termination at least this often in milliseconds
+#define SEQUENCE_POLL_INTERVAL 100
+
+// Delay before sending the sequence again from a failed request in milliseconds, it is doubled up to the max on every failure
+#define SEQUENCE_RETRY_DELAY 1000
+#define SEQUENCE_MAX_RETRY_DELAY 30000
+
+// Sends the requests of a sequence channel overlapping, but delivers their callbacks in order
+class SequenceThread : public Thread {
+private:
+    std::shared_ptr<SequenceQueue> queue;
+
+public:
+    explicit SequenceThread(std::shared_ptr<SequenceQueue> queue);
+    ~SequenceThread();
+
+protected:
+    virtual void Run();
+};
+
+#endif
\ No newline at end of file
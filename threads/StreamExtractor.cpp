@@ -0,0 +1,805 @@
+/**
+ * -----------------------------------------------------
+ * File        StreamExtractor.cpp
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#if !defined _WIN32 && !defined _WIN64
+// Zip archives may be bigger than 2 GB also in 32 bit builds
+#define _FILE_OFFSET_BITS 64
+#endif
+
+#include "StreamExtractor.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+// Size of the end of central directory record of zip archives, it may be followed by a comment of up to 65535 bytes
+#define ZIP_END_SIZE 22
+#define ZIP_MAX_COMMENT 65535
+
+// Compression methods of zip entries which can be extracted
+#define ZIP_STORED 0
+#define ZIP_DEFLATED 8
+
+static uint64_t ReadLittleEndian(const unsigned char* data, int bytes) {
+    uint64_t value = 0;
+    for (int i = bytes - 1; i >= 0; i--) {
+        value = (value << 8) | data[i];
+    }
+
+    return value;
+}
+
+// Numbers in tar headers are octal, GNU tar stores big numbers binary with the highest bit set
+static uint64_t ReadTarNumber(const char* field, size_t length) {
+    uint64_t value = 0;
+
+    if (static_cast<unsigned char>(field[0]) & 0x80) {
+        for (size_t i = 1; i < length; i++) {
+            value = (value << 8) | static_cast<unsigned char>(field[i]);
+        }
+
+        return value;
+    }
+
+    size_t i = 0;
+    while (i < length && field[i] == ' ') {
+        i++;
+    }
+
+    for (; i < length && field[i] >= '0' && field[i] <= '7'; i++) {
+        value = (value << 3) | static_cast<uint64_t>(field[i] - '0');
+    }
+
+    return value;
+}
+
+static bool SeekSpill(FILE* file, uint64_t offset) {
+#if defined _WIN32 || defined _WIN64
+    return _fseeki64(file, static_cast<__int64>(offset), SEEK_SET) == 0;
+#else
+    return fseeko(file, static_cast<off_t>(offset), SEEK_SET) == 0;
+#endif
+}
+
+static bool GetSpillSize(FILE* file, uint64_t& size) {
+#if defined _WIN32 || defined _WIN64
+    if (_fseeki64(file, 0, SEEK_END) != 0) {
+        return false;
+    }
+
+    __int64 position = _ftelli64(file);
+#else
+    if (fseeko(file, 0, SEEK_END) != 0) {
+        return false;
+    }
+
+    off_t position = ftello(file);
+#endif
+
+    if (position < 0) {
+        return false;
+    }
+
+    size = static_cast<uint64_t>(position);
+    return true;
+}
+
+StreamExtractor::StreamExtractor()
+    : format(EXTRACT_DETECT), inflating(false), streamEnded(false), tarState(TAR_HEADER), tarEntry(TAR_ENTRY_SKIP),
+    remaining(0), padding(0), spill(nullptr) {
+    memset(&this->stream, 0, sizeof(this->stream));
+}
+
+StreamExtractor::~StreamExtractor() {
+    if (this->inflating) {
+        inflateEnd(&this->stream);
+    }
+
+    if (this->file) {
+        this->file->Close();
+    }
+
+    // The temporary file is removed automatically when it's closed
+    if (this->spill) {
+        fclose(this->spill);
+    }
+}
+
+bool StreamExtractor::Open(const std::string& directory) {
+    this->directory = directory;
+    std::replace(this->directory.begin(), this->directory.end(), '\\', '/');
+    while (this->directory.length() > 1 && this->directory.back() == '/') {
+        this->directory.pop_back();
+    }
+
+    if (!FileIO::MakeDirectories(this->directory)) {
+        return this->Fail("Can not create the directory to extract to");
+    }
+
+    return true;
+}
+
+bool StreamExtractor::Write(const char* data, size_t length) {
+    if (!this->error.empty()) {
+        return false;
+    }
+
+    if (this->format != EXTRACT_DETECT) {
+        return this->Process(data, length);
+    }
+
+    // Collect the beginning of the archive until the format is known
+    this->pending.append(data, length);
+    if (!this->Detect()) {
+        return this->error.empty();
+    }
+
+    std::string pending;
+    pending.swap(this->pending);
+
+    return this->Process(pending.data(), pending.length());
+}
+
+bool StreamExtractor::Finish(bool complete) {
+    // Files which were extracted already are kept
+    if (this->file) {
+        this->file->Close();
+        this->file.reset();
+    }
+
+    if (!complete || !this->error.empty()) {
+        return false;
+    }
+
+    switch (this->format) {
+        case EXTRACT_DETECT:
+        {
+            return this->Fail("Unknown archive format");
+        }
+        case EXTRACT_ZIP:
+        {
+            return this->ExtractZip();
+        }
+        default:
+        {
+            // The end blocks of tar archives are optional, but the last entry has to be complete
+            if ((this->format == EXTRACT_GZIP_TAR && !this->streamEnded) || this->tarState == TAR_DATA || !this->header.empty()) {
+                return this->Fail("Archive is truncated");
+            }
+
+            return true;
+        }
+    }
+}
+
+bool StreamExtractor::HasError() const {
+    return !this->error.empty();
+}
+
+const std::string& StreamExtractor::GetError() const {
+    return this->error;
+}
+
+bool StreamExtractor::GetSafePath(const std::string& directory, const std::string& name, std::string& path) {
+    std::string normalized = name;
+    std::replace(normalized.begin(), normalized.end(), '\\', '/');
+
+    if (normalized.empty() || normalized[0] == '/') {
+        return false;
+    }
+
+    path = directory;
+    for (size_t start = 0; start <= normalized.length();) {
+        size_t end = normalized.find('/', start);
+        if (end == std::string::npos) {
+            end = normalized.length();
+        }
+
+        std::string part = normalized.substr(start, end - start);
+        start = end + 1;
+
+        if (part.empty() || part == ".") {
+            continue;
+        }
+
+        // Parent directories, drive letters and alternate streams could leave the directory
+        if (part == ".." || part.find(':') != std::string::npos) {
+            return false;
+        }
+
+        path += "/" + part;
+    }
+
+    return true;
+}
+
+bool StreamExtractor::Fail(const std::string& error) {
+    if (this->error.empty()) {
+        this->error = error;
+    }
+
+    return false;
+}
+
+bool StreamExtractor::Detect() {
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(this->pending.data());
+    size_t length = this->pending.length();
+
+    if (length < 4) {
+        return false;
+    }
+
+    if (bytes[0] == 0x1f && bytes[1] == 0x8b) {
+        // Also accept concatenated gzip members
+        if (inflateInit2(&this->stream, 15 + 16) != Z_OK) {
+            return this->Fail("Couldn't initialize zlib");
+        }
+
+        this->inflating = true;
+        this->format = EXTRACT_GZIP_TAR;
+    } else if (!memcmp(bytes, "PK\x03\x04", 4)) {
+        this->spill = tmpfile();
+        if (!this->spill) {
+            return this->Fail("Can not create a temporary file for the zip archive");
+        }
+
+        this->format = EXTRACT_ZIP;
+    } else if (bytes[0] == 0x28 && bytes[1] == 0xb5 && bytes[2] == 0x2f && bytes[3] == 0xfd) {
+        return this->Fail("Zstandard archives are not supported");
+    } else if (length < 262) {
+        // The magic of tar archives is in the header of the first entry
+        return false;
+    } else if (!memcmp(bytes + 257, "ustar", 5)) {
+        this->format = EXTRACT_TAR;
+    } else {
+        return this->Fail("Unknown archive format");
+    }
+
+    return true;
+}
+
+bool StreamExtractor::Process(const char* data, size_t length) {
+    switch (this->format) {
+        case EXTRACT_GZIP_TAR:
+        {
+            return this->WriteGzip(data, length);
+        }
+        case EXTRACT_TAR:
+        {
+            return this->WriteTar(data, length);
+        }
+        case EXTRACT_ZIP:
+        {
+            if (fwrite(data, 1, length, this->spill) != length) {
+                return this->Fail("Can not write the temporary file of the zip archive");
+            }
+
+            return true;
+        }
+        default:
+        {
+            return false;
+        }
+    }
+}
+
+bool StreamExtractor::WriteGzip(const char* data, size_t length) {
+    char buffer[EXTRACT_BUFFER_SIZE];
+
+    this->stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+    this->stream.avail_in = static_cast<uInt>(length);
+
+    do {
+        if (this->streamEnded) {
+            // Anything after the end of the tar archive isn't needed
+            if (this->stream.avail_in == 0 || this->tarState == TAR_END) {
+                return true;
+            }
+
+            // Another gzip member follows
+            if (inflateReset(&this->stream) != Z_OK) {
+                return this->Fail("Archive is corrupt");
+            }
+
+            this->streamEnded = false;
+        }
+
+        this->stream.next_out = reinterpret_cast<Bytef*>(buffer);
+        this->stream.avail_out = sizeof(buffer);
+
+        int result = inflate(&this->stream, Z_NO_FLUSH);
+        if (result != Z_OK && result != Z_STREAM_END && result != Z_BUF_ERROR) {
+            return this->Fail("Archive is corrupt");
+        }
+
+        size_t inflated = sizeof(buffer) - this->stream.avail_out;
+        if (inflated > 0 && !this->WriteTar(buffer, inflated)) {
+            return false;
+        }
+
+        if (result == Z_STREAM_END) {
+            this->streamEnded = true;
+        }
+    } while (this->stream.avail_in > 0 || this->stream.avail_out == 0);
+
+    return true;
+}
+
+bool StreamExtractor::WriteTar(const char* data, size_t length) {
+    while (length > 0) {
+        switch (this->tarState) {
+            case TAR_HEADER:
+            {
+                size_t needed = std::min(TAR_BLOCK_SIZE - this->header.length(), length);
+                this->header.append(data, needed);
+                data += needed;
+                length -= needed;
+
+                if (this->header.length() == TAR_BLOCK_SIZE) {
+                    if (!this->StartTarEntry()) {
+                        return false;
+                    }
+
+                    this->header.clear();
+                }
+
+                break;
+            }
+            case TAR_DATA:
+            {
+                size_t chunk = static_cast<size_t>(std::min(this->remaining, static_cast<uint64_t>(length)));
+
+                if (this->tarEntry == TAR_ENTRY_FILE) {
+                    if (!this->file->Write(data, chunk)) {
+                        return this->Fail("Can not write an extracted file");
+                    }
+                } else if (this->tarEntry != TAR_ENTRY_SKIP) {
+                    this->extended.append(data, chunk);
+                }
+
+                data += chunk;
+                length -= chunk;
+                this->remaining -= chunk;
+
+                if (this->remaining == 0 && !this->FinishTarEntry()) {
+                    return false;
+                }
+
+                break;
+            }
+            case TAR_PADDING:
+            {
+                size_t chunk = std::min(this->padding, length);
+                data += chunk;
+                length -= chunk;
+                this->padding -= chunk;
+
+                if (this->padding == 0) {
+                    this->tarState = TAR_HEADER;
+                }
+
+                break;
+            }
+            case TAR_END:
+            {
+                return true;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool StreamExtractor::StartTarEntry() {
+    const char* block = this->header.data();
+
+    // An empty block marks the end of the archive
+    if (std::all_of(this->header.begin(), this->header.end(), [](char c) -> bool { return c == '\0'; })) {
+        this->tarState = TAR_END;
+        return true;
+    }
+
+    // The checksum is calculated with spaces instead of the checksum itself
+    uint64_t checksum = 0;
+    for (size_t i = 0; i < TAR_BLOCK_SIZE; i++) {
+        checksum += (i >= 148 && i < 156) ? ' ' : static_cast<unsigned char>(block[i]);
+    }
+
+    if (checksum != ReadTarNumber(block + 148, 8)) {
+        return this->Fail("Archive is corrupt");
+    }
+
+    uint64_t size = ReadTarNumber(block + 124, 12);
+    char type = block[156];
+
+    // A long name of a previous entry replaces the name of the header
+    std::string name;
+    if (!this->longName.empty()) {
+        name.swap(this->longName);
+    } else {
+        name.assign(block, strnlen(block, 100));
+
+        if (!memcmp(block + 257, "ustar", 5) && block[345] != '\0') {
+            name = std::string(block + 345, strnlen(block + 345, 155)) + "/" + name;
+        }
+    }
+
+    this->remaining = size;
+    this->padding = static_cast<size_t>((TAR_BLOCK_SIZE - size % TAR_BLOCK_SIZE) % TAR_BLOCK_SIZE);
+    this->tarEntry = TAR_ENTRY_SKIP;
+
+    switch (type) {
+        case '0':
+        case '7':
+        case '\0':
+        {
+            if (!this->OpenFile(name, size)) {
+                return false;
+            }
+
+            this->tarEntry = TAR_ENTRY_FILE;
+            break;
+        }
+        case '5':
+        {
+            std::string path;
+            if (!StreamExtractor::GetSafePath(this->directory, name, path)) {
+                return this->Fail("Archive contains an unsafe path: " + name);
+            }
+
+            if (!FileIO::MakeDirectories(path)) {
+                return this->Fail("Can not create directory " + name);
+            }
+
+            break;
+        }
+        case 'L':
+        case 'x':
+        {
+            if (size > TAR_MAX_EXTENDED_SIZE) {
+                return this->Fail("Archive is corrupt");
+            }
+
+            this->tarEntry = type == 'L' ? TAR_ENTRY_LONG_NAME : TAR_ENTRY_EXTENDED;
+            break;
+        }
+        default:
+        {
+            // Links and special files are skipped, so nothing can point outside of the directory
+            break;
+        }
+    }
+
+    if (this->remaining == 0) {
+        return this->FinishTarEntry();
+    }
+
+    this->tarState = TAR_DATA;
+    return true;
+}
+
+bool StreamExtractor::FinishTarEntry() {
+    switch (this->tarEntry) {
+        case TAR_ENTRY_FILE:
+        {
+            bool closed = this->file->Close();
+            this->file.reset();
+
+            if (!closed) {
+                return this->Fail("Can not write an extracted file");
+            }
+
+            break;
+        }
+        case TAR_ENTRY_LONG_NAME:
+        {
+            this->longName = this->extended.c_str();
+            break;
+        }
+        case TAR_ENTRY_EXTENDED:
+        {
+            // Records are "<length> <key>=<value>\n", only the path is of interest
+            for (size_t position = 0; position < this->extended.length();) {
+                size_t recordLength = static_cast<size_t>(strtoul(this->extended.c_str() + position, nullptr, 10));
+                size_t key = this->extended.find(' ', position);
+                if (recordLength == 0 || key == std::string::npos || position + recordLength > this->extended.length()) {
+                    break;
+                }
+
+                std::string record = this->extended.substr(key + 1, position + recordLength - key - 1);
+                if (!record.compare(0, 5, "path=")) {
+                    this->longName = record.substr(5, record.length() - 6);
+                }
+
+                position += recordLength;
+            }
+            break;
+        }
+        default:
+        {
+            break;
+        }
+    }
+
+    this->extended.clear();
+    this->tarState = this->padding > 0 ? TAR_PADDING : TAR_HEADER;
+
+    return true;
+}
+
+bool StreamExtractor::ExtractZip() {
+    uint64_t size;
+    if (fflush(this->spill) != 0 || !GetSpillSize(this->spill, size) || size < ZIP_END_SIZE) {
+        return this->Fail("Archive is corrupt");
+    }
+
+    // Search the end of central directory record backwards, as the comment behind it has a variable length
+    size_t tailLength = static_cast<size_t>(std::min(size, static_cast<uint64_t>(ZIP_END_SIZE + ZIP_MAX_COMMENT)));
+    std::vector<unsigned char> tail(tailLength);
+    if (!SeekSpill(this->spill, size - tailLength) || fread(tail.data(), 1, tailLength, this->spill) != tailLength) {
+        return this->Fail("Can not read the temporary file of the zip archive");
+    }
+
+    size_t end = tailLength - ZIP_END_SIZE + 1;
+    while (end-- > 0) {
+        if (!memcmp(&tail[end], "PK\x05\x06", 4)) {
+            break;
+        }
+    }
+
+    if (end == static_cast<size_t>(-1)) {
+        return this->Fail("Archive is corrupt");
+    }
+
+    const unsigned char* record = &tail[end];
+    uint64_t entries = ReadLittleEndian(record + 10, 2);
+    uint64_t directorySize = ReadLittleEndian(record + 12, 4);
+    uint64_t directoryOffset = ReadLittleEndian(record + 16, 4);
+
+    // Zip64 archives have another record, its locator is right before the end of central directory record
+    if (entries == 0xFFFF || directorySize == 0xFFFFFFFF || directoryOffset == 0xFFFFFFFF) {
+        unsigned char zip64Record[56];
+        if (end < 20 || memcmp(record - 20, "PK\x06\x07", 4) != 0 || !SeekSpill(this->spill, ReadLittleEndian(record - 12, 8)) ||
+            fread(zip64Record, 1, sizeof(zip64Record), this->spill) != sizeof(zip64Record) || memcmp(zip64Record, "PK\x06\x06", 4) != 0) {
+            return this->Fail("Archive is corrupt");
+        }
+
+        entries = ReadLittleEndian(zip64Record + 32, 8);
+        directorySize = ReadLittleEndian(zip64Record + 40, 8);
+        directoryOffset = ReadLittleEndian(zip64Record + 48, 8);
+    }
+
+    if (directoryOffset > size || directorySize > size - directoryOffset) {
+        return this->Fail("Archive is corrupt");
+    }
+
+    std::vector<unsigned char> directory(static_cast<size_t>(directorySize));
+    if (!SeekSpill(this->spill, directoryOffset) || fread(directory.data(), 1, directory.size(), this->spill) != directory.size()) {
+        return this->Fail("Can not read the temporary file of the zip archive");
+    }
+
+    size_t position = 0;
+    for (uint64_t i = 0; i < entries; i++) {
+        if (position + 46 > directory.size() || memcmp(&directory[position], "PK\x01\x02", 4) != 0) {
+            return this->Fail("Archive is corrupt");
+        }
+
+        const unsigned char* entry = &directory[position];
+        int system = entry[5];
+        int flags = static_cast<int>(ReadLittleEndian(entry + 8, 2));
+        int method = static_cast<int>(ReadLittleEndian(entry + 10, 2));
+        uint32_t crc = static_cast<uint32_t>(ReadLittleEndian(entry + 16, 4));
+        uint64_t compressedSize = ReadLittleEndian(entry + 20, 4);
+        uint64_t fileSize = ReadLittleEndian(entry + 24, 4);
+        size_t nameLength = static_cast<size_t>(ReadLittleEndian(entry + 28, 2));
+        size_t extraLength = static_cast<size_t>(ReadLittleEndian(entry + 30, 2));
+        size_t commentLength = static_cast<size_t>(ReadLittleEndian(entry + 32, 2));
+        uint32_t attributes = static_cast<uint32_t>(ReadLittleEndian(entry + 38, 4));
+        uint64_t offset = ReadLittleEndian(entry + 42, 4);
+
+        if (position + 46 + nameLength + extraLength + commentLength > directory.size()) {
+            return this->Fail("Archive is corrupt");
+        }
+
+        std::string name(reinterpret_cast<const char*>(entry + 46), nameLength);
+
+        // The zip64 extra field only contains the values which are too big for the entry
+        const unsigned char* extra = entry + 46 + nameLength;
+        for (size_t field = 0; field + 4 <= extraLength;) {
+            size_t fieldLength = static_cast<size_t>(ReadLittleEndian(extra + field + 2, 2));
+            if (field + 4 + fieldLength > extraLength) {
+                break;
+            }
+
+            if (ReadLittleEndian(extra + field, 2) == 0x0001) {
+                const unsigned char* value = extra + field + 4;
+                const unsigned char* valueEnd = value + fieldLength;
+
+                if (fileSize == 0xFFFFFFFF && value + 8 <= valueEnd) {
+                    fileSize = ReadLittleEndian(value, 8);
+                    value += 8;
+                }
+                if (compressedSize == 0xFFFFFFFF && value + 8 <= valueEnd) {
+                    compressedSize = ReadLittleEndian(value, 8);
+                    value += 8;
+                }
+                if (offset == 0xFFFFFFFF && value + 8 <= valueEnd) {
+                    offset = ReadLittleEndian(value, 8);
+                }
+            }
+
+            field += 4 + fieldLength;
+        }
+
+        position += 46 + nameLength + extraLength + commentLength;
+
+        if (flags & 0x0001) {
+            return this->Fail("Encrypted archives are not supported");
+        }
+
+        std::string path;
+        if (!StreamExtractor::GetSafePath(this->directory, name, path)) {
+            return this->Fail("Archive contains an unsafe path: " + name);
+        }
+
+        // Links are skipped, so nothing can point outside of the directory
+        if (system == 3 && ((attributes >> 16) & 0170000) == 0120000) {
+            continue;
+        }
+
+        if (!name.empty() && (name.back() == '/' || name.back() == '\\')) {
+            if (!FileIO::MakeDirectories(path)) {
+                return this->Fail("Can not create directory " + name);
+            }
+
+            continue;
+        }
+
+        if (!this->ExtractZipEntry(offset, compressedSize, fileSize, crc, method, name)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool StreamExtractor::ExtractZipEntry(uint64_t offset, uint64_t compressedSize, uint64_t size, uint32_t crc, int method, const std::string& name) {
+    if (method != ZIP_STORED && method != ZIP_DEFLATED) {
+        return this->Fail("Compression method " + std::to_string(method) + " of " + name + " is not supported");
+    }
+
+    // The data follows the local header, which may have another extra field than the central directory
+    unsigned char localHeader[30];
+    if (!SeekSpill(this->spill, offset) || fread(localHeader, 1, sizeof(localHeader), this->spill) != sizeof(localHeader) ||
+        memcmp(localHeader, "PK\x03\x04", 4) != 0 ||
+        !SeekSpill(this->spill, offset + sizeof(localHeader) + ReadLittleEndian(localHeader + 26, 2) + ReadLittleEndian(localHeader + 28, 2))) {
+        return this->Fail("Archive is corrupt");
+    }
+
+    if (!this->OpenFile(name, size)) {
+        return false;
+    }
+
+    z_stream inflater;
+    memset(&inflater, 0, sizeof(inflater));
+    if (method == ZIP_DEFLATED && inflateInit2(&inflater, -MAX_WBITS) != Z_OK) {
+        this->file->Close();
+        this->file.reset();
+
+        return this->Fail("Couldn't initialize zlib");
+    }
+
+    std::vector<char> input(EXTRACT_BUFFER_SIZE);
+    std::vector<char> output(EXTRACT_BUFFER_SIZE);
+
+    uLong fileCrc = crc32(0L, Z_NULL, 0);
+    uint64_t written = 0;
+    uint64_t left = compressedSize;
+    bool corrupt = false;
+    bool writeFailed = false;
+    int result = Z_OK;
+
+    while (left > 0 && result != Z_STREAM_END && !corrupt && !writeFailed) {
+        size_t chunk = fread(input.data(), 1, static_cast<size_t>(std::min(left, static_cast<uint64_t>(input.size()))), this->spill);
+        if (chunk == 0) {
+            corrupt = true;
+            break;
+        }
+
+        left -= chunk;
+
+        if (method == ZIP_STORED) {
+            writeFailed = !this->file->Write(input.data(), chunk);
+            fileCrc = crc32(fileCrc, reinterpret_cast<const Bytef*>(input.data()), static_cast<uInt>(chunk));
+            written += chunk;
+
+            continue;
+        }
+
+        inflater.next_in = reinterpret_cast<Bytef*>(input.data());
+        inflater.avail_in = static_cast<uInt>(chunk);
+
+        do {
+            inflater.next_out = reinterpret_cast<Bytef*>(output.data());
+            inflater.avail_out = static_cast<uInt>(output.size());
+
+            result = inflate(&inflater, Z_NO_FLUSH);
+            if (result != Z_OK && result != Z_STREAM_END && result != Z_BUF_ERROR) {
+                corrupt = true;
+                break;
+            }
+
+            size_t inflated = output.size() - inflater.avail_out;
+            if (inflated > 0) {
+                if (!this->file->Write(output.data(), inflated)) {
+                    writeFailed = true;
+                    break;
+                }
+
+                fileCrc = crc32(fileCrc, reinterpret_cast<const Bytef*>(output.data()), static_cast<uInt>(inflated));
+                written += inflated;
+            }
+        } while (result != Z_STREAM_END && (inflater.avail_in > 0 || inflater.avail_out == 0));
+    }
+
+    if (method == ZIP_DEFLATED) {
+        inflateEnd(&inflater);
+    }
+
+    bool closed = this->file->Close();
+    this->file.reset();
+
+    if (writeFailed || !closed) {
+        return this->Fail("Can not write an extracted file");
+    }
+
+    if (corrupt || written != size || static_cast<uint32_t>(fileCrc) != crc) {
+        return this->Fail("Archive is corrupt");
+    }
+
+    return true;
+}
+
+bool StreamExtractor::OpenFile(const std::string& name, uint64_t size) {
+    std::string path;
+    if (!StreamExtractor::GetSafePath(this->directory, name, path)) {
+        return this->Fail("Archive contains an unsafe path: " + name);
+    }
+
+    if (!FileIO::MakeDirectories(path.substr(0, path.rfind('/')))) {
+        return this->Fail("Can not create the directory of " + name);
+    }
+
+    this->file = std::make_unique<FileWriter>();
+    if (!this->file->Open(path.c_str())) {
+        this->file.reset();
+        return this->Fail("Can not open " + name + " to extract it");
+    }
+
+    if (size > 0) {
+        this->file->Expect(size);
+    }
+
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,129 @@
+/**
+ * -----------------------------------------------------
+ * File        StreamExtractor.h
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#ifndef _SYSTEM2_STREAM_EXTRACTOR_H_
+#define _SYSTEM2_STREAM_EXTRACTOR_H_
+
+#include "FileIO.h"
+
+#include <memory>
+#include <string>
+
+#include <zlib.h>
+
+// Size of the chunks which are inflated at once
+#define EXTRACT_BUFFER_SIZE 65536
+
+// Tar archives are made of blocks of this size
+#define TAR_BLOCK_SIZE 512
+
+// Max. size of long names and extended headers of tar archives, everything bigger is seen as broken archive
+#define TAR_MAX_EXTENDED_SIZE 65536
+
+enum ExtractFormat {
+    EXTRACT_DETECT,
+    EXTRACT_TAR,
+    EXTRACT_GZIP_TAR,
+    EXTRACT_ZIP
+};
+
+enum TarState {
+    TAR_HEADER,
+    TAR_DATA,
+    TAR_PADDING,
+    TAR_END
+};
+
+enum TarEntry {
+    TAR_ENTRY_FILE,
+    TAR_ENTRY_LONG_NAME,
+    TAR_ENTRY_EXTENDED,
+    TAR_ENTRY_SKIP
+};
+
+// Extracts an archive while it is downloaded, so it never has to be written to disk as a whole.
+// Tar archives (also gzip compressed) are extracted as they arrive, zip archives are spilled to a temporary file and extracted at the end,
+// as their directory is at the end of the archive.
+class StreamExtractor {
+private:
+    std::string directory;
+    ExtractFormat format;
+    std::string error;
+
+    // Beginning of the archive until its format is known
+    std::string pending;
+
+    z_stream stream;
+    bool inflating;
+    bool streamEnded;
+
+    TarState tarState;
+    TarEntry tarEntry;
+    std::string header;
+    std::string extended;
+    std::string longName;
+    uint64_t remaining;
+    size_t padding;
+    std::unique_ptr<FileWriter> file;
+
+    FILE* spill;
+
+    bool Fail(const std::string& error);
+    bool Detect();
+    bool Process(const char* data, size_t length);
+
+    bool WriteGzip(const char* data, size_t length);
+
+    bool WriteTar(const char* data, size_t length);
+    bool StartTarEntry();
+    bool FinishTarEntry();
+
+    bool ExtractZip();
+    bool ExtractZipEntry(uint64_t offset, uint64_t compressedSize, uint64_t size, uint32_t crc, int method, const std::string& name);
+
+    bool OpenFile(const std::string& name, uint64_t size);
+
+public:
+    StreamExtractor();
+    ~StreamExtractor();
+
+    StreamExtractor(const StreamExtractor&) = delete;
+    StreamExtractor& operator=(const StreamExtractor&) = delete;
+
+    bool Open(const std::string& directory);
+
+    // Returns false if the archive is broken or a file couldn't be written, the transfer should be aborted then
+    bool Write(const char* data, size_t length);
+
+    // Finishes the archive after the transfer, complete is false if the transfer failed
+    bool Finish(bool complete);
+
+    bool HasError() const;
+    const std::string& GetError() const;
+
+    // Gets the full path of a name inside of the archive, returns false if the name would leave the directory
+    static bool GetSafePath(const std::string& directory, const std::string& name, std::string& path);
+};
+
+#endif
\ No newline at end of file
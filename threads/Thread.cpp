@@ -37,6 +37,7 @@ void Thread::RunThread() {
         system2Extension.RegisterThread(this);
 
         this->threader = std::make_unique<std::thread>([this]() -> void {
+            threadPolicies.Apply(this->GetCategory());
             this->Run();
             system2Extension.UnregisterThread(this);
         });
@@ -56,6 +57,10 @@ void Thread::TerminateThread() {
     }
 }
 
+ThreadCategory Thread::GetCategory() const {
+    return THREAD_NETWORK;
+}
+
 bool Thread::ShouldTerminate() {
     std::lock_guard<std::mutex> lock(this->lock);
     return this->shouldTerminate;
@@ -25,6 +25,8 @@
 #ifndef _SYSTEM2_THREAD_H_
 #define _SYSTEM2_THREAD_H_
 
+#include "ThreadPolicy.h"
+
 #include <mutex>
 #include <thread>
 
@@ -38,6 +40,9 @@ protected:
     virtual void Run() = 0;
     bool ShouldTerminate();
 
+    // Category which decides the scheduling policy of the thread
+    virtual ThreadCategory GetCategory() const;
+
 public:
     Thread();
     virtual ~Thread();
@@ -0,0 +1,148 @@
+/**
+ * -----------------------------------------------------
+ * File        ThreadPolicy.cpp
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "ThreadPolicy.h"
+
+#if defined _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#endif
+
+// Affinity the calling thread got by its policy, to refresh it when the game thread moves
+static thread_local bool appliedAvoidGameCore = false;
+static thread_local unsigned int appliedAffinity = 0;
+static thread_local int appliedGameCpu = -1;
+
+ThreadPolicies::ThreadPolicies() : gameCpu(-1) {
+    for (int i = 0; i < THREAD_CATEGORIES; i++) {
+        this->policies[i] = { SCHEDULE_NORMAL, 0, EXECUTE_IO_DEFAULT, 4, 0, false };
+    }
+
+    // Compressing keeps every core busy for a long time, so it must never compete with the game
+    this->policies[THREAD_COMPRESS] = { SCHEDULE_BATCH, 10, EXECUTE_IO_DEFAULT, 4, 0, true };
+}
+
+void ThreadPolicies::SetPolicy(ThreadCategory category, const ThreadPolicy_t& policy) {
+    std::lock_guard<std::mutex> lock(this->policyMutex);
+    this->policies[category] = policy;
+}
+
+ThreadPolicy_t ThreadPolicies::GetPolicy(ThreadCategory category) {
+    std::lock_guard<std::mutex> lock(this->policyMutex);
+    return this->policies[category];
+}
+
+void ThreadPolicies::Apply(ThreadCategory category) {
+    ThreadPolicy_t policy = this->GetPolicy(category);
+
+    // Remember the affinity, so it can be refreshed with the same policy
+    appliedAvoidGameCore = policy.avoidGameCore;
+    appliedAffinity = policy.affinity;
+    appliedGameCpu = this->gameCpu;
+    ThreadPolicies::ApplyAffinity(policy.affinity, policy.avoidGameCore, appliedGameCpu);
+
+#if defined _WIN32
+    if (policy.schedule == SCHEDULE_IDLE) {
+        SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_IDLE);
+    } else if (policy.schedule == SCHEDULE_BATCH || policy.nice > 0) {
+        SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_BELOW_NORMAL);
+    }
+
+    if (policy.ioClass == EXECUTE_IO_IDLE) {
+        SetThreadPriority(GetCurrentThread(), THREAD_MODE_BACKGROUND_BEGIN);
+    }
+#elif defined __linux__
+    if (policy.schedule != SCHEDULE_NORMAL) {
+        struct sched_param param = { 0 };
+        pthread_setschedparam(pthread_self(), policy.schedule == SCHEDULE_IDLE ? SCHED_IDLE : SCHED_BATCH, &param);
+    }
+
+    // On Linux the nice level and IO priority can be set per thread
+    pid_t tid = static_cast<pid_t>(syscall(SYS_gettid));
+    if (policy.nice > 0) {
+        setpriority(PRIO_PROCESS, tid, policy.nice);
+    }
+
+    SetIOPriority(tid, policy.ioClass, policy.ioLevel);
+#endif
+}
+
+void ThreadPolicies::Refresh() {
+    if (!appliedAvoidGameCore) {
+        return;
+    }
+
+    // The game thread isn't pinned, so the scheduler may have moved it onto the core of this thread
+    int gameCpu = this->gameCpu;
+    if (gameCpu != appliedGameCpu) {
+        appliedGameCpu = gameCpu;
+        ThreadPolicies::ApplyAffinity(appliedAffinity, true, gameCpu);
+    }
+}
+
+void ThreadPolicies::ApplyAffinity(unsigned int affinity, bool avoidGameCore, int gameCpu) {
+    // Affinity mask without the core of the game thread
+    if (avoidGameCore && gameCpu >= 0 && gameCpu < 32) {
+        if (!affinity) {
+            affinity = ~0u;
+        }
+
+        // Never leave a thread without any core
+        if (affinity & ~(1u << gameCpu)) {
+            affinity &= ~(1u << gameCpu);
+        }
+    }
+
+#if defined _WIN32
+    if (affinity) {
+        SetThreadAffinityMask(GetCurrentThread(), affinity);
+    }
+#elif defined __linux__
+    if (affinity) {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        for (int i = 0; i < 32; i++) {
+            if (affinity & (1u << i)) {
+                CPU_SET(i, &cpus);
+            }
+        }
+
+        pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+    }
+#endif
+}
+
+void ThreadPolicies::UpdateGameCpu() {
+#if defined _WIN32
+    this->gameCpu = static_cast<int>(GetCurrentProcessorNumber());
+#elif defined __linux__
+    this->gameCpu = sched_getcpu();
+#endif
+}
+
+// Create the policies of the worker threads
+ThreadPolicies threadPolicies;
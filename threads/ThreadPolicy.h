@@ -0,0 +1,104 @@
+/**
+ * -----------------------------------------------------
+ * File        ThreadPolicy.h
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#ifndef _SYSTEM2_THREAD_POLICY_H_
+#define _SYSTEM2_THREAD_POLICY_H_
+
+#include "ExecuteIOClass.h"
+
+#include <atomic>
+#include <mutex>
+
+#if defined __linux__
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#define IOPRIO_CLASS_SHIFT 13
+#define IOPRIO_CLASS_BE 2
+#define IOPRIO_CLASS_IDLE 3
+#define IOPRIO_WHO_PROCESS 1
+#endif
+
+enum ThreadCategory {
+    THREAD_NETWORK,
+    THREAD_EXECUTE,
+    THREAD_FILE,
+    THREAD_COMPRESS,
+    THREAD_CATEGORIES
+};
+
+enum ThreadSchedule {
+    SCHEDULE_NORMAL,
+    SCHEDULE_BATCH,
+    SCHEDULE_IDLE
+};
+
+typedef struct {
+    ThreadSchedule schedule;
+    int nice;
+    ExecuteIOClass ioClass;
+    int ioLevel;
+    unsigned int affinity;
+    bool avoidGameCore;
+} ThreadPolicy_t;
+
+class ThreadPolicies {
+private:
+    std::mutex policyMutex;
+    ThreadPolicy_t policies[THREAD_CATEGORIES];
+    std::atomic<int> gameCpu;
+
+public:
+    ThreadPolicies();
+
+    void SetPolicy(ThreadCategory category, const ThreadPolicy_t& policy);
+    ThreadPolicy_t GetPolicy(ThreadCategory category);
+
+    // Applies the policy of the category to the calling thread
+    void Apply(ThreadCategory category);
+
+    // Moves the calling thread away from the game thread again, if the game thread changed its core since the last apply
+    void Refresh();
+
+    // Remembers the CPU the game thread runs on, must be called from the game thread
+    void UpdateGameCpu();
+
+private:
+    static void ApplyAffinity(unsigned int affinity, bool avoidGameCore, int gameCpu);
+};
+
+#if defined __linux__
+// Async signal safe, so it can also be used in a forked child
+inline void SetIOPriority(pid_t tid, ExecuteIOClass ioClass, int ioLevel) {
+    if (ioClass == EXECUTE_IO_BEST_EFFORT) {
+        syscall(SYS_ioprio_set, IOPRIO_WHO_PROCESS, tid, (IOPRIO_CLASS_BE << IOPRIO_CLASS_SHIFT) | ioLevel);
+    } else if (ioClass == EXECUTE_IO_IDLE) {
+        syscall(SYS_ioprio_set, IOPRIO_WHO_PROCESS, tid, IOPRIO_CLASS_IDLE << IOPRIO_CLASS_SHIFT);
+    }
+}
+#endif
+
+extern ThreadPolicies threadPolicies;
+
+#endif
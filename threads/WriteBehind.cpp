@@ -0,0 +1,209 @@
+/**
+ * -----------------------------------------------------
+ * File        WriteBehind.cpp
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "WriteBehind.h"
+#include "ThreadPolicy.h"
+
+#include <algorithm>
+#include <cstring>
+
+WriteBehind::WriteBehind() : current(nullptr), bufferSize(0), maxBuffers(0), closing(false), failed(false) {}
+
+WriteBehind::~WriteBehind() {
+    this->Close();
+}
+
+bool WriteBehind::Open(const char* path, size_t writeBehind) {
+    this->Close();
+
+    if (writeBehind > 0) {
+        // Split the size into buffers, so the disk writes one while the others are filled
+        this->maxBuffers = std::max<size_t>(WRITE_BEHIND_MIN_BUFFERS, (writeBehind + WRITE_BEHIND_BUFFER_SIZE - 1) / WRITE_BEHIND_BUFFER_SIZE);
+        this->bufferSize = std::max<size_t>(1, writeBehind / this->maxBuffers);
+    }
+
+    return this->writer.Open(path);
+}
+
+bool WriteBehind::Close() {
+    if (this->current) {
+        if (this->current->length > 0) {
+            if (this->writerThread.joinable()) {
+                this->Hand(this->current);
+            } else if (!this->failed && !this->writer.Write(this->current->data.get(), this->current->length)) {
+                // Everything fit into the first buffer, so there is no thread to write it
+                this->failed = true;
+            }
+        }
+
+        this->current = nullptr;
+    }
+
+    // Let the thread write the remaining buffers and wait for it
+    if (this->writerThread.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->closing = true;
+        }
+
+        this->filled.notify_one();
+        this->writerThread.join();
+    }
+
+    bool success = this->writer.Close() && !this->failed;
+
+    this->buffers.clear();
+    this->emptyBuffers.clear();
+    this->fullBuffers.clear();
+    this->bufferSize = 0;
+    this->maxBuffers = 0;
+    this->closing = false;
+    this->failed = false;
+
+    return success;
+}
+
+void WriteBehind::Expect(uint64_t size) {
+    // The file can only be prepared as long as nothing is written
+    if (!this->writerThread.joinable()) {
+        this->writer.Expect(size);
+    }
+}
+
+bool WriteBehind::Write(const char* data, size_t size) {
+    if (this->failed) {
+        return false;
+    }
+
+    if (this->maxBuffers == 0) {
+        if (!this->writer.Write(data, size)) {
+            this->failed = true;
+        }
+
+        return !this->failed;
+    }
+
+    while (size > 0) {
+        if (!this->current) {
+            this->current = this->Acquire();
+            if (!this->current) {
+                return false;
+            }
+        }
+
+        size_t part = std::min(this->bufferSize - this->current->length, size);
+        memcpy(this->current->data.get() + this->current->length, data, part);
+
+        this->current->length += part;
+        data += part;
+        size -= part;
+
+        if (this->current->length == this->bufferSize) {
+            this->Hand(this->current);
+            this->current = nullptr;
+        }
+    }
+
+    return !this->failed;
+}
+
+WriteBehindBuffer_t* WriteBehind::Acquire() {
+    std::unique_lock<std::mutex> lock(this->mutex);
+
+    // Buffers are only allocated when needed, so small files never use more than one
+    if (this->emptyBuffers.empty() && this->buffers.size() < this->maxBuffers) {
+        std::unique_ptr<WriteBehindBuffer_t> buffer = std::make_unique<WriteBehindBuffer_t>();
+        buffer->data = std::unique_ptr<char[]>(new char[this->bufferSize]);
+        buffer->length = 0;
+
+        this->buffers.push_back(std::move(buffer));
+        return this->buffers.back().get();
+    }
+
+    // All buffers wait for the disk
+    this->emptied.wait(lock, [this]() -> bool {
+        return !this->emptyBuffers.empty() || this->failed;
+    });
+
+    if (this->failed) {
+        return nullptr;
+    }
+
+    WriteBehindBuffer_t* buffer = this->emptyBuffers.back();
+    this->emptyBuffers.pop_back();
+
+    return buffer;
+}
+
+void WriteBehind::Hand(WriteBehindBuffer_t* buffer) {
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->fullBuffers.push_back(buffer);
+    }
+
+    // Start the thread with the first full buffer
+    if (!this->writerThread.joinable()) {
+        this->writerThread = std::thread(&WriteBehind::Run, this);
+    }
+
+    this->filled.notify_one();
+}
+
+void WriteBehind::Run() {
+    threadPolicies.Apply(THREAD_FILE);
+
+    while (true) {
+        WriteBehindBuffer_t* buffer;
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->filled.wait(lock, [this]() -> bool {
+                return !this->fullBuffers.empty() || this->closing;
+            });
+
+            // Only stop once every buffer is written
+            if (this->fullBuffers.empty()) {
+                return;
+            }
+
+            buffer = this->fullBuffers.front();
+            this->fullBuffers.pop_front();
+        }
+
+        // Stay away from the game thread if it moved to another core
+        threadPolicies.Refresh();
+
+        bool written = !this->failed && this->writer.Write(buffer->data.get(), buffer->length);
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            buffer->length = 0;
+            this->emptyBuffers.push_back(buffer);
+
+            if (!written) {
+                this->failed = true;
+            }
+        }
+
+        this->emptied.notify_one();
+    }
+}
\ No newline at end of file
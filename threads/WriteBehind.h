@@ -0,0 +1,91 @@
+/**
+ * -----------------------------------------------------
+ * File        WriteBehind.h
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#ifndef _SYSTEM2_WRITE_BEHIND_H_
+#define _SYSTEM2_WRITE_BEHIND_H_
+
+#include "FileIO.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Maximum size of a single buffer, the write behind size is split into at least two buffers
+#define WRITE_BEHIND_BUFFER_SIZE 1048576
+#define WRITE_BEHIND_MIN_BUFFERS 2
+
+typedef struct {
+    std::unique_ptr<char[]> data;
+    size_t length;
+} WriteBehindBuffer_t;
+
+// Writes a file on its own thread, so a slow disk doesn't stall the transfer which produces the data.
+// The transfer only waits for the disk if all buffers are full. The thread is started with the first full buffer,
+// smaller files are written on the calling thread when they are closed.
+class WriteBehind {
+private:
+    FileWriter writer;
+    std::thread writerThread;
+    std::mutex mutex;
+    std::condition_variable filled;
+    std::condition_variable emptied;
+
+    std::vector<std::unique_ptr<WriteBehindBuffer_t>> buffers;
+    std::vector<WriteBehindBuffer_t*> emptyBuffers;
+    std::deque<WriteBehindBuffer_t*> fullBuffers;
+    WriteBehindBuffer_t* current;
+
+    size_t bufferSize;
+    size_t maxBuffers;
+    bool closing;
+    std::atomic<bool> failed;
+
+    WriteBehindBuffer_t* Acquire();
+    void Hand(WriteBehindBuffer_t* buffer);
+    void Run();
+
+public:
+    WriteBehind();
+    ~WriteBehind();
+
+    WriteBehind(const WriteBehind&) = delete;
+    WriteBehind& operator=(const WriteBehind&) = delete;
+
+    // Opens the file, 0 bytes to write behind writes directly on the calling thread
+    bool Open(const char* path, size_t writeBehind);
+
+    // Writes all pending data and closes the file, returns false if any write failed
+    bool Close();
+
+    // Tells the writer the expected size of the file before the first write
+    void Expect(uint64_t size);
+
+    bool Write(const char* data, size_t size);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,48 @@
+/**
+ * -----------------------------------------------------
+ * File        BatchCallback.cpp
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "BatchCallback.h"
+
+BatchCallback::BatchCallback(std::shared_ptr<CallbackFunction_t> callbackFunction, bool success, std::string error, int statusCode, int records)
+    : Callback(callbackFunction), success(success), error(error), statusCode(statusCode), records(records) {}
+
+void BatchCallback::Fire() {
+    // Every record gets its own call, but all of them in the same frame
+    for (int data : this->data) {
+        if (!this->callbackFunction->isValid || !this->callbackFunction->function->IsRunnable()) {
+            return;
+        }
+
+        this->callbackFunction->function->PushCell(this->success);
+        this->callbackFunction->function->PushString(this->error.c_str());
+        this->callbackFunction->function->PushCell(this->statusCode);
+        this->callbackFunction->function->PushCell(this->records);
+        this->callbackFunction->function->PushCell(data);
+        this->callbackFunction->function->Execute(nullptr);
+    }
+}
+
+const char* BatchCallback::GetName() const {
+    return "BatchCallback";
+}
\ No newline at end of file
@@ -36,6 +36,19 @@ public:
 
     virtual void Fire() = 0;
     virtual void Abort() {};
+
+    // Callbacks which are delivered too late are expired and then fired as failure
+    virtual bool HasExpired() const { return false; };
+    virtual void Expire() {};
+
+    virtual const char* GetName() const = 0;
+};
+
+class CallbackListener {
+public:
+    virtual ~CallbackListener() {};
+
+    virtual void OnCallback(std::shared_ptr<Callback> callback) = 0;
 };
 
 #endif
\ No newline at end of file
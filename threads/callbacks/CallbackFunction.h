@@ -26,11 +26,18 @@
 #define _SYSTEM2_CALLBACK_FUNCTION_H_
 
 #include "smsdk_ext.h"
+#include <memory>
+
+class CallbackListener;
 
 typedef struct {
     IPlugin* plugin;
     IPluginFunction* function;
     bool isValid;
+
+    // Callbacks of other extensions are passed to a listener instead of a plugin function
+    std::shared_ptr<CallbackListener> listener;
+    bool listenOnWorkerThread;
 } CallbackFunction_t;
 
 #endif
\ No newline at end of file
@@ -27,10 +27,26 @@
 CopyCallback::CopyCallback(std::shared_ptr<CallbackFunction_t> callbackFunction, bool success, std::string from, std::string to, int data)
     : Callback(callbackFunction), success(success), from(from), to(to), data(data) {}
 
+bool CopyCallback::IsSuccess() const {
+    return this->success;
+}
+
+const std::string& CopyCallback::GetFrom() const {
+    return this->from;
+}
+
+const std::string& CopyCallback::GetTo() const {
+    return this->to;
+}
+
 void CopyCallback::Fire() {
     this->callbackFunction->function->PushCell(this->success);
     this->callbackFunction->function->PushString(this->from.c_str());
     this->callbackFunction->function->PushString(this->to.c_str());
     this->callbackFunction->function->PushCell(this->data);
     this->callbackFunction->function->Execute(nullptr);
+}
+
+const char* CopyCallback::GetName() const {
+    return "CopyCallback";
 }
\ No newline at end of file
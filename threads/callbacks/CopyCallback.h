@@ -38,7 +38,13 @@ private:
 public:
     CopyCallback(std::shared_ptr<CallbackFunction_t> callbackFunction, bool success, std::string from, std::string to, int data);
 
+    bool IsSuccess() const;
+    const std::string& GetFrom() const;
+    const std::string& GetTo() const;
+
     virtual void Fire();
+
+    virtual const char* GetName() const;
 };
 
 #endif
\ No newline at end of file
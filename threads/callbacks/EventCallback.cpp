@@ -0,0 +1,85 @@
+/**
+ * -----------------------------------------------------
+ * File        EventCallback.cpp
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "EventCallback.h"
+#include "EventBatchHandler.h"
+#include "RequestHandler.h"
+
+EventCallback::EventCallback(HTTPRequest* request, std::shared_ptr<EventStream> stream)
+    : Callback(request->eventCallbackFunction), request(request), stream(stream), dropped(0) {};
+
+void EventCallback::Fire() {
+    // Collect everything the stream received until now
+    this->dropped = this->stream->TakeBatch(this->events);
+    if (this->events.empty() || this->stream->IsClosed()) {
+        this->Abort();
+        return;
+    }
+
+    // Create a temporary request handle, so in the callback the correct request will be used
+    IdentityToken_t* owner = this->request->eventCallbackFunction->plugin->GetIdentity();
+    Handle_t requestHandle = requestHandler.CreateLocaleHandle<Request>(this->request, owner);
+    Handle_t batchHandle = eventBatchHandler.CreateHandle(this, owner);
+
+    this->request->eventCallbackFunction->function->PushCell(requestHandle);
+    this->request->eventCallbackFunction->function->PushCell(batchHandle);
+
+    cell_t result = 1;
+    this->request->eventCallbackFunction->function->Execute(&result);
+
+    // The plugin wants to close the stream
+    if (!result) {
+        this->stream->Close();
+    }
+
+    // Delete the handles when finished
+    if (batchHandle != BAD_HANDLE) {
+        eventBatchHandler.FreeHandle(batchHandle, owner);
+    }
+
+    if (requestHandle != BAD_HANDLE) {
+        requestHandler.FreeHandle(requestHandle, owner);
+    }
+}
+
+void EventCallback::Abort() {
+    // The request will only be deleted by the handle, but as it will not be invoked we have to delete it manually
+    delete this->request;
+}
+
+EventCallback* EventCallback::ConvertEventBatch(Handle_t hndl, IPluginContext* pContext) {
+    HandleError err;
+
+    EventCallback* eventCallback = nullptr;
+    if ((err = eventBatchHandler.ReadHandle(hndl, pContext->GetIdentity(), &eventCallback)) != HandleError_None) {
+        pContext->ThrowNativeError("Invalid event batch handle %x (error %d)", hndl, err);
+        return nullptr;
+    }
+
+    return eventCallback;
+}
+
+const char* EventCallback::GetName() const {
+    return "EventCallback";
+}
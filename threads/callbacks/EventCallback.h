@@ -0,0 +1,51 @@
+/**
+ * -----------------------------------------------------
+ * File        EventCallback.h
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#ifndef _SYSTEM2_EVENT_CALLBACK_H_
+#define _SYSTEM2_EVENT_CALLBACK_H_
+
+#include "Callback.h"
+#include "HTTPRequest.h"
+#include "EventStream.h"
+
+class EventCallback : public Callback {
+private:
+    HTTPRequest* request;
+    std::shared_ptr<EventStream> stream;
+
+public:
+    std::vector<StreamEvent_t> events;
+    int dropped;
+
+    EventCallback(HTTPRequest* request, std::shared_ptr<EventStream> stream);
+
+    virtual void Fire();
+    virtual void Abort();
+
+    virtual const char* GetName() const;
+
+    static EventCallback* ConvertEventBatch(Handle_t hndl, IPluginContext* pContext);
+};
+
+#endif
@@ -25,13 +25,21 @@
 #include "ExecuteCallback.h"
 #include "ExecuteCallbackHandler.h"
 
-ExecuteCallback::ExecuteCallback(std::shared_ptr<CallbackFunction_t> callbackFunction, bool success, int exitStatus, std::string output, std::string command, int data)
-    : Callback(callbackFunction), success(success), exitStatus(exitStatus), output(output), command(command), data(data) {}
+ExecuteCallback::ExecuteCallback(std::shared_ptr<CallbackFunction_t> callbackFunction, bool success, ExecuteStatus status, int exitStatus, std::string output, std::string command, int data)
+    : Callback(callbackFunction), success(success), status(status), exitStatus(exitStatus), output(output), command(command), data(data) {}
+
+bool ExecuteCallback::IsSuccess() const {
+    return this->success;
+}
 
 const std::string& ExecuteCallback::GetOutput() const {
     return this->output;
 }
 
+ExecuteStatus ExecuteCallback::GetStatus() const {
+    return this->status;
+}
+
 int ExecuteCallback::GetExitStatus() const {
     return this->exitStatus;
 }
@@ -40,8 +48,8 @@ void ExecuteCallback::Fire() {
     IdentityToken_t* owner = this->callbackFunction->plugin->GetIdentity();
     Handle_t outputHandle = BAD_HANDLE;
 
-    if (this->success) {
-        // Create the output handle
+    if (this->success || this->status == EXECUTE_TIMEOUT) {
+        // Create the output handle, also on a timeout to provide the output until then
         outputHandle = executeCallbackHandler.CreateHandle(this, owner);
     }
 
@@ -68,4 +76,8 @@ ExecuteCallback* ExecuteCallback::ConvertExecuteCallback(Handle_t hndl, IPluginC
     }
 
     return executeCallback;
+}
+
+const char* ExecuteCallback::GetName() const {
+    return "ExecuteCallback";
 }
\ No newline at end of file
@@ -27,23 +27,29 @@
 
 #include "Callback.h"
 #include "extension.h"
+#include "ExecuteStatus.h"
 
 class ExecuteCallback : public Callback {
 private:
     bool success;
+    ExecuteStatus status;
     int exitStatus;
     std::string output;
     std::string command;
     int data;
 
 public:
-    ExecuteCallback(std::shared_ptr<CallbackFunction_t> callbackFunction, bool success, int exitStatus, std::string output, std::string command, int data);
+    ExecuteCallback(std::shared_ptr<CallbackFunction_t> callbackFunction, bool success, ExecuteStatus status, int exitStatus, std::string output, std::string command, int data);
 
+    bool IsSuccess() const;
     const std::string& GetOutput() const;
+    ExecuteStatus GetStatus() const;
     int GetExitStatus() const;
 
     virtual void Fire();
 
+    virtual const char* GetName() const;
+
     static ExecuteCallback* ConvertExecuteCallback(Handle_t hndl, IPluginContext* pContext);
 };
 
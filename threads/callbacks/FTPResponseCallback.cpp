@@ -27,9 +27,14 @@
 FTPResponseCallback::FTPResponseCallback(FTPRequest* ftpRequest, std::string error)
     : ResponseCallback(ftpRequest, error) {}
 
-FTPResponseCallback::FTPResponseCallback(FTPRequest* ftpRequest, CURL* curl, std::string content, size_t contentLength)
-    : ResponseCallback(ftpRequest, curl, content, contentLength) {}
+FTPResponseCallback::FTPResponseCallback(FTPRequest* ftpRequest, CURL* curl, std::shared_ptr<ContentBuffer> content, uint64_t contentLength,
+                                         std::shared_ptr<Arena> arena)
+    : ResponseCallback(ftpRequest, curl, content, contentLength, arena) {}
 
 void FTPResponseCallback::PreFire() {
     // Nothing to do here
+}
+
+const char* FTPResponseCallback::GetName() const {
+    return "FTPResponseCallback";
 }
\ No newline at end of file
@@ -31,7 +31,9 @@
 class FTPResponseCallback : public ResponseCallback {
 public:
     FTPResponseCallback(FTPRequest* ftpRequest, std::string error);
-    FTPResponseCallback(FTPRequest* ftpRequest, CURL* curl, std::string content, size_t contentLength);
+    FTPResponseCallback(FTPRequest* ftpRequest, CURL* curl, std::shared_ptr<ContentBuffer> content, uint64_t contentLength, std::shared_ptr<Arena> arena);
+
+    virtual const char* GetName() const;
 
 private:
     virtual void PreFire();
@@ -0,0 +1,44 @@
+/**
+ * -----------------------------------------------------
+ * File        FastDLCallback.cpp
+ * Authors     David Ordnung
+ * License     GPLv3
+ * Web         http://dordnung.de
+ * -----------------------------------------------------
+ *
+ * Copyright (C) 2013-2020 David Ordnung
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>
+ */
+
+#include "FastDLCallback.h"
+
+FastDLCallback::FastDLCallback(std::shared_ptr<CallbackFunction_t> callbackFunction, bool success, std::string error, std::string mirror, FastDLSummary_t summary, int data)
+    : Callback(callbackFunction), success(success), error(error), mirror(mirror), summary(summary), data(data) {}
+
+void FastDLCallback::Fire() {
+    this->callbackFunction->function->PushCell(this->success);
+    this->callbackFunction->function->PushString(this->error.c_str());
+    this->callbackFunction->function->PushString(this->mirror.c_str());
+    this->callbackFunction->function->PushCell(this->summary.scanned);
+    this->callbackFunction->function->PushCell(this->summary.compressed);
+    this->callbackFunction->function->PushCell(this->summary.uploaded);
+    this->callbackFunction->function->PushCell(this->summary.failed);
+    this->callbackFunction->function->PushCell(this->data);
+    this->callbackFunction->function->Execute(nullptr);
+}
+
+const char* FastDLCallback::GetName() const {
+    return "FastDLCallback";
+}
\ No newline at end of file
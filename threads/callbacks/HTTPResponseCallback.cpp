@@ -25,11 +25,13 @@
 #include "HTTPResponseCallback.h"
 
 HTTPResponseCallback::HTTPResponseCallback(HTTPRequest* httpRequest, std::string error, HTTPRequestMethod requestMethod)
-    : ResponseCallback(httpRequest, error), requestMethod(requestMethod), httpVersion(CURL_HTTP_VERSION_NONE) {}
+    : ResponseCallback(httpRequest, error), requestMethod(requestMethod), headers(ArenaAllocator<char>(arena.get())),
+    contentType(ArenaAllocator<char>(arena.get())), httpVersion(CURL_HTTP_VERSION_NONE) {}
 
-HTTPResponseCallback::HTTPResponseCallback(HTTPRequest* httpRequest, CURL* curl, std::string content, size_t contentLength,
-                                           HTTPRequestMethod requestMethod, std::map<std::string, std::string> headers)
-    : ResponseCallback(httpRequest, curl, content, contentLength), requestMethod(requestMethod), headers(headers), httpVersion(CURL_HTTP_VERSION_NONE) {
+HTTPResponseCallback::HTTPResponseCallback(HTTPRequest* httpRequest, CURL* curl, std::shared_ptr<ContentBuffer> content, uint64_t contentLength,
+                                           std::shared_ptr<Arena> arena, HTTPRequestMethod requestMethod, ArenaStringMap&& headers)
+    : ResponseCallback(httpRequest, curl, content, contentLength, arena), requestMethod(requestMethod), headers(std::move(headers)),
+    contentType(ArenaAllocator<char>(arena.get())), httpVersion(CURL_HTTP_VERSION_NONE) {
     // Get the http version
     long version;
     if (curl_easy_getinfo(curl, CURLINFO_HTTP_VERSION, &version) == CURLE_OK) {
@@ -46,4 +48,8 @@ HTTPResponseCallback::HTTPResponseCallback(HTTPRequest* httpRequest, CURL* curl,
 void HTTPResponseCallback::PreFire() {
     // Push the request method for a HTTP request
     this->request->responseCallbackFunction->function->PushCell(this->requestMethod);
+}
+
+const char* HTTPResponseCallback::GetName() const {
+    return "HTTPResponseCallback";
 }
\ No newline at end of file
@@ -33,12 +33,15 @@ private:
     HTTPRequestMethod requestMethod;
 
 public:
-    std::map<std::string, std::string> headers;
-    std::string contentType;
+    ArenaStringMap headers;
+    ArenaString contentType;
     int httpVersion;
 
     HTTPResponseCallback(HTTPRequest* httpRequest, std::string error, HTTPRequestMethod requestMethod);
-    HTTPResponseCallback(HTTPRequest* httpRequest, CURL* curl, std::string content, size_t contentLength, HTTPRequestMethod requestMethod, std::map<std::string, std::string> headers);
+    HTTPResponseCallback(HTTPRequest* httpRequest, CURL* curl, std::shared_ptr<ContentBuffer> content, uint64_t contentLength, std::shared_ptr<Arena> arena,
+                         HTTPRequestMethod requestMethod, ArenaStringMap&& headers);
+
+    virtual const char* GetName() const;
 
 private:
     virtual void PreFire();
@@ -49,4 +49,8 @@ void ProgressCallback::Fire() {
 void ProgressCallback::Abort() {
     // The request will only be deleted by the handle, but as it will not be invoked we have to delete it manually
     delete this->request;
+}
+
+const char* ProgressCallback::GetName() const {
+    return "ProgressCallback";
 }
\ No newline at end of file
@@ -43,6 +43,8 @@ public:
 
     virtual void Fire();
     virtual void Abort();
+
+    virtual const char* GetName() const;
 };
 
 #endif
\ No newline at end of file
@@ -26,12 +26,17 @@
 #include "RequestHandler.h"
 
 ResponseCallback::ResponseCallback(Request* request, std::string error)
-    : Callback(request->responseCallbackFunction), request(request), error(error),
-    statusCode(0), totalTime(0.0f), downloadSize(0), uploadSize(0), downloadSpeed(0), uploadSpeed(0) {};
+    : Callback(request->responseCallbackFunction), request(request), arena(std::make_shared<Arena>()),
+    error(error.c_str(), error.length(), ArenaAllocator<char>(arena.get())), lastURL(ArenaAllocator<char>(arena.get())), statusCode(0), totalTime(0.0f), downloadSize(0), uploadSize(0), downloadSpeed(0), uploadSpeed(0) {
+    // Keep a more specific reason set by the thread
+    if (this->request->error == REQUEST_ERROR_NONE) {
+        this->request->error = REQUEST_ERROR_TRANSFER;
+    }
+};
 
-ResponseCallback::ResponseCallback(Request* request, CURL* curl, std::string content, size_t contentLength)
-    : Callback(request->responseCallbackFunction), request(request), content(content), contentLength(contentLength),
-    statusCode(0), totalTime(0.0f), downloadSize(0), uploadSize(0), downloadSpeed(0), uploadSpeed(0) {
+ResponseCallback::ResponseCallback(Request* request, CURL* curl, std::shared_ptr<ContentBuffer> content, uint64_t contentLength, std::shared_ptr<Arena> arena)
+    : Callback(request->responseCallbackFunction), request(request), arena(arena), error(ArenaAllocator<char>(arena.get())),
+    content(content), contentLength(contentLength), lastURL(ArenaAllocator<char>(arena.get())), statusCode(0), totalTime(0.0f), downloadSize(0), uploadSize(0), downloadSpeed(0), uploadSpeed(0) {
     // Get the response code
     long code;
     if (curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &code) == CURLE_OK) {
@@ -112,6 +117,18 @@ void ResponseCallback::Fire() {
     }
 }
 
+bool ResponseCallback::HasExpired() const {
+    return this->request->HasExpired();
+}
+
+void ResponseCallback::Expire() {
+    // The response isn't used anymore, so free it right away
+    this->content = nullptr;
+    this->contentLength = 0;
+    this->error = "Deadline of the request passed before the response was delivered";
+    this->request->error = REQUEST_ERROR_DEADLINE;
+}
+
 void ResponseCallback::Abort() {
     // The request will only be deleted by the handle, but as it will not be invoked we have to delete it manually
     delete this->request;
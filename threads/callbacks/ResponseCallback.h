@@ -27,6 +27,8 @@
 
 #include "Callback.h"
 #include "Request.h"
+#include "ContentBuffer.h"
+#include "Arena.h"
 #include "ResponseCallbackHandler.h"
 
 class ResponseCallback : public Callback {
@@ -34,10 +36,13 @@ protected:
     Request* request;
 
 public:
-    std::string error;
-    std::string content;
-    size_t contentLength;
-    std::string lastURL;
+    // Holds the memory of the response and is freed with it, so it has to be declared first
+    std::shared_ptr<Arena> arena;
+
+    ArenaString error;
+    std::shared_ptr<ContentBuffer> content;
+    uint64_t contentLength;
+    ArenaString lastURL;
     int statusCode;
     float totalTime;
     int downloadSize;
@@ -46,10 +51,13 @@ public:
     int uploadSpeed;
 
     ResponseCallback(Request* request, std::string error);
-    ResponseCallback(Request* request, CURL* curl, std::string content, size_t contentLength);
+    ResponseCallback(Request* request, CURL* curl, std::shared_ptr<ContentBuffer> content, uint64_t contentLength, std::shared_ptr<Arena> arena);
 
     virtual void Abort();
 
+    virtual bool HasExpired() const;
+    virtual void Expire();
+
     template<class ResponseCallbackClass>
     static ResponseCallbackClass* ConvertResponse(Handle_t hndl, IPluginContext* pContext) {
         HandleError err;